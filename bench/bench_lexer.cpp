@@ -0,0 +1,67 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    词法分析吞吐量基准: bench_lexer [脚本路径] [轮数], 输出 MB/s
+ */
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "lexer/Lexer.h"
+
+namespace {
+    // 未指定脚本时生成约 8MB 的代码, 覆盖标识符、数字、字符串、运算符与注释
+    std::string GenerateSource() {
+        std::string code;
+        for (int i = 0; code.size() < 8 * 1024 * 1024; ++i) {
+            const std::string n = std::to_string(i);
+            code += "// 第 " + n + " 个函数\n";
+            code += "function item_" + n + "(a, b) {\n";
+            code += "    let total = a * " + n + " + b / 3.25;\n";
+            code += "    if (total >= 100 && b != null) { total -= 1; }\n";
+            code += "    return {name: \"item \\\"" + n + "\\\"\", value: total, tags: [1, 2, 3]};\n";
+            code += "}\n";
+        }
+        return code;
+    }
+
+    std::string ReadSource(const std::string &path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("无法打开文件: " + path);
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return buffer.str();
+    }
+}
+
+int main(const int argc, char *argv[]) {
+    const std::string source = argc > 1 ? ReadSource(argv[1]) : GenerateSource();
+    const int rounds = argc > 2 ? std::stoi(argv[2]) : 10;
+    size_t tokens = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        Lexer lexer(source);
+        while (lexer.NextToken()._TokenType.GetEnum() != TokenKind::FILE_END) {
+            tokens++;
+        }
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const double megabytes = static_cast<double>(source.size()) * rounds / (1024.0 * 1024.0);
+    std::cout << "源码 " << source.size() << " 字节 x " << rounds << " 轮, "
+            << tokens / rounds << " 个 Token/轮, "
+            << elapsed.count() * 1000.0 << " ms, "
+            << megabytes / elapsed.count() << " MB/s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,59 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    启动延迟基准: bench_startup [BxScript路径] [轮数], 反复执行空脚本, 输出平均与最短耗时
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+namespace {
+    double RunOnce(const std::string &command) {
+        const auto start = std::chrono::steady_clock::now();
+        if (std::system(command.c_str()) != 0) {
+            throw std::runtime_error("执行失败: " + command);
+        }
+        const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        return elapsed.count();
+    }
+}
+
+int main(const int argc, char *argv[]) {
+    const std::string binary = fs::absolute(argc > 1 ? argv[1] : "BxScript").lexically_normal().string();
+    const int rounds = argc > 2 ? std::stoi(argv[2]) : 50;
+    if (!fs::exists(binary)) {
+        std::cerr << "找不到解释器: " << binary << std::endl;
+        return 1;
+    }
+    const fs::path script = fs::temp_directory_path() / "bx_bench_empty.bx";
+    // 完全为空的文件会被拒绝执行, 只写一行注释
+    std::ofstream(script) << "// empty\n";
+    const std::string command = "\"" + binary + "\" \"" + script.string() + "\"";
+
+    // 第一次运行预热文件缓存, 不计入结果
+    RunOnce(command);
+    double total = 0, best = 1e9;
+    for (int r = 0; r < rounds; ++r) {
+        const double ms = RunOnce(command);
+        total += ms;
+        best = std::min(best, ms);
+    }
+    std::cout << "empty.bx x " << rounds << " 轮, 平均 " << total / rounds << " ms, 最短 " << best << " ms"
+            << std::endl;
+    fs::remove(script);
+    return 0;
+}
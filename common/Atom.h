@@ -0,0 +1,184 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    驻留字符串 (标识符与属性名)
+ */
+
+#ifndef BXSCRIPT_ATOM_H
+#define BXSCRIPT_ATOM_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// 内容相同的 Atom 指向全局表中的同一份字符串: 比较与哈希只看指针, 语法树中的同名标识符也不再各存一份.
+// 源码中的名字 (Intern) 永久驻留; 运行时产生的属性名 (Acquire) 按引用计数驻留, 由使用它的 Shape 持有,
+// 没有 Shape 再使用时从表中移除, JSON 的字段名、计算出的键不会让表无限增长.
+class Atom {
+public:
+    // 空字符串
+    Atom() : node(EmptyNode()) {
+    }
+
+    // 永久驻留, 之后同名的运行时属性名也不再计数
+    static Atom Intern(const std::string &s) {
+        Table &table = GetTable();
+        {
+            std::shared_lock<std::shared_mutex> lock(table.Lock);
+            if (const auto it = table.Nodes.find(s); it != table.Nodes.end()) {
+                it->second->Permanent.store(true, std::memory_order_relaxed);
+                return Atom(it->second.get());
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(table.Lock);
+        Node *node = Insert(table, s);
+        node->Permanent.store(true, std::memory_order_relaxed);
+        return Atom(node);
+    }
+
+    // 计数驻留, 返回的 Atom 带一个引用, 用完调用 Release
+    static Atom Acquire(const std::string &s) {
+        Table &table = GetTable();
+        {
+            std::shared_lock<std::shared_mutex> lock(table.Lock);
+            if (const auto it = table.Nodes.find(s); it != table.Nodes.end()) {
+                Retain(Atom(it->second.get()));
+                return Atom(it->second.get());
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(table.Lock);
+        Node *node = Insert(table, s);
+        Retain(Atom(node));
+        return Atom(node);
+    }
+
+    // 调用方已持有 atom 的引用 (或 atom 是永久的) 时, 再增加一个引用
+    static void Retain(const Atom &atom) {
+        if (!atom.node->Permanent.load(std::memory_order_relaxed)) {
+            atom.node->Refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    static void Release(const Atom &atom) {
+        Node *node = atom.node;
+        if (node->Permanent.load(std::memory_order_relaxed)) {
+            return;
+        }
+        // 不是最后一个引用时无锁递减; 最后一个引用在表锁内释放, 与 Acquire 的查找互斥
+        size_t refs = node->Refs.load(std::memory_order_relaxed);
+        while (refs > 1) {
+            if (node->Refs.compare_exchange_weak(refs, refs - 1, std::memory_order_acq_rel)) {
+                return;
+            }
+        }
+        Table &table = GetTable();
+        std::unique_lock<std::shared_mutex> lock(table.Lock);
+        if (node->Refs.fetch_sub(1, std::memory_order_acq_rel) == 1 && !node->Permanent.load(std::memory_order_relaxed)) {
+            table.Nodes.erase(node->Text);
+        }
+    }
+
+    // 只查找不驻留, 表中没有的字符串不可能是任何 Atom; 结果不带引用, 只用于比较或立即使用
+    static bool Find(const std::string &s, Atom &out) {
+        Table &table = GetTable();
+        std::shared_lock<std::shared_mutex> lock(table.Lock);
+        const auto it = table.Nodes.find(s);
+        if (it == table.Nodes.end()) {
+            return false;
+        }
+        out = Atom(it->second.get());
+        return true;
+    }
+
+    [[nodiscard]] const std::string &Str() const { return node->Text; }
+
+    operator const std::string &() const { return node->Text; }
+
+    bool operator==(const Atom &other) const { return node == other.node; }
+
+    bool operator!=(const Atom &other) const { return node != other.node; }
+
+    bool operator==(const std::string &other) const { return node->Text == other; }
+
+    bool operator!=(const std::string &other) const { return node->Text != other; }
+
+    bool operator==(const char *other) const { return node->Text == other; }
+
+    bool operator!=(const char *other) const { return node->Text != other; }
+
+    friend std::string operator+(const std::string &l, const Atom &r) { return l + r.node->Text; }
+
+    friend std::string operator+(const Atom &l, const std::string &r) { return l.node->Text + r; }
+
+    friend std::string operator+(const char *l, const Atom &r) { return l + r.node->Text; }
+
+    friend std::string operator+(const Atom &l, const char *r) { return l.node->Text + r; }
+
+    [[nodiscard]] size_t Hash() const { return std::hash<const Node *>()(node); }
+
+private:
+    struct Node {
+        const std::string Text;
+        std::atomic<bool> Permanent{false};
+        // 运行时属性名的引用数, 永久驻留后不再使用
+        std::atomic<size_t> Refs{0};
+
+        explicit Node(std::string text) : Text(std::move(text)) {
+        }
+    };
+
+    struct Table {
+        // 键引用节点中的字符串, 节点单独分配, 扩容不移动, 指针长期有效
+        std::unordered_map<std::string_view, std::unique_ptr<Node> > Nodes{};
+        // 模块可能在多个线程中解析
+        std::shared_mutex Lock{};
+    };
+
+    Node *node;
+
+    explicit Atom(Node *n) : node(n) {
+    }
+
+    // 持有写锁时调用
+    static Node *Insert(Table &table, const std::string &s) {
+        if (const auto it = table.Nodes.find(s); it != table.Nodes.end()) {
+            return it->second.get();
+        }
+        auto node = std::make_unique<Node>(s);
+        Node *raw = node.get();
+        table.Nodes.emplace(raw->Text, std::move(node));
+        return raw;
+    }
+
+    static Node *EmptyNode() {
+        static Node *empty = Intern(std::string()).node;
+        return empty;
+    }
+
+    // 不析构: 退出时其他静态对象 (模块缓存等) 析构中仍会释放属性名
+    static Table &GetTable() {
+        static Table *table = new Table();
+        return *table;
+    }
+};
+
+namespace std {
+    template<>
+    struct hash<Atom> {
+        size_t operator()(const Atom &atom) const noexcept { return atom.Hash(); }
+    };
+}
+
+#endif //BXSCRIPT_ATOM_H
@@ -20,13 +20,13 @@ class JsonKit {
 public:
     static ValuePtr JsonToValue(const nlohmann::json &j) {
         if (j.is_null()) {
-            return std::make_shared<NullValue>();
+            return NullValue::Instance();
         }
         if (j.is_boolean()) {
-            return std::make_shared<BoolValue>(j.get<bool>());
+            return BoolValue::Of(j.get<bool>());
         }
         if (j.is_number()) {
-            return std::make_shared<NumberValue>(j.get<double>());
+            return NumberValue::Of(j.get<double>());
         }
         if (j.is_string()) {
             return std::make_shared<StringValue>(j.get<std::string>());
@@ -46,7 +46,7 @@ public:
             }
             return obj;
         }
-        return std::make_shared<NullValue>();
+        return NullValue::Instance();
     }
 
     static nlohmann::json ValueToJson(const ValuePtr &v) {
@@ -63,19 +63,19 @@ public:
         if (v->type == ValueType::ARRAY) {
             const auto arr = std::static_pointer_cast<ArrayValue>(v);
             nlohmann::json j = nlohmann::json::array();
-            for (const auto &elem: arr->Elements) {
-                j.push_back(ValueToJson(elem));
+            for (size_t i = 0; i < arr->Size(); ++i) {
+                j.push_back(ValueToJson(arr->At(i)));
             }
             return j;
         }
         if (v->type == ValueType::OBJECT) {
             const auto obj = std::static_pointer_cast<ObjectValue>(v);
             nlohmann::json j = nlohmann::json::object();
-            for (const auto &[key, val]: obj->Properties) {
+            obj->ForEach([&j](const std::string &key, const ValuePtr &val) {
                 if (val->type != ValueType::FUNCTION && val->type != ValueType::NATIVE_FUNCTION) {
                     j[key] = ValueToJson(val);
                 }
-            }
+            });
             return j;
         }
         return nullptr;
@@ -13,23 +13,35 @@
 
 #ifndef BXSCRIPT_KEYWORD_H
 #define BXSCRIPT_KEYWORD_H
-#include <string>
-#include <unordered_set>
+#include <string_view>
 
 
 class KeyWord {
 public:
-    static bool isKeyword(const std::string &str) {
-        return KeyWords.find(str) != KeyWords.end();
+    static bool isKeyword(const std::string_view str) {
+        const std::string_view *word = Find(str);
+        return word && word < Words + KeyWordCount;
     }
-private:
-    static const std::unordered_set<std::string> KeyWords;
-};
 
-const inline std::unordered_set<std::string> KeyWord::KeyWords{
-    "function","let","true","false","this","if","else",
-    "return","null","for","break","continue","while",
-    "import","as"
+    // 返回静态表中的同一拼写, Token 可以长期引用它; 未找到时返回 nullptr
+    static const std::string_view *Find(const std::string_view str) {
+        for (const auto &word: Words) {
+            if (word == str) {
+                return &word;
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    static constexpr size_t KeyWordCount = 15;
+    // 前 KeyWordCount 个是关键字, 其后是 Parser 特殊对待的普通标识符
+    static constexpr std::string_view Words[] = {
+        "function", "let", "true", "false", "this", "if", "else",
+        "return", "null", "for", "break", "continue", "while",
+        "import", "as",
+        "delete", "in"
+    };
 };
 
-#endif //BXSCRIPT_KEYWORD_H
\ No newline at end of file
+#endif //BXSCRIPT_KEYWORD_H
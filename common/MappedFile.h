@@ -0,0 +1,121 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    只读内存映射文件
+ */
+
+#ifndef BXSCRIPT_MAPPEDFILE_H
+#define BXSCRIPT_MAPPEDFILE_H
+
+#include <string>
+#include <string_view>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// 整个文件映射为只读内存, 内容由系统按页读入, 不经过额外的缓冲区复制.
+// 映射在对象析构前有效, View() 返回的切片不能比对象活得更久.
+class MappedFile {
+public:
+    MappedFile() = default;
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile() {
+        Close();
+    }
+
+    // 打开失败 (不存在、无权限) 时返回 false; 空文件也算成功, 内容为空
+    bool Open(const std::string &path) {
+        Close();
+#ifdef _WIN32
+        const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER fileSize{};
+        if (!GetFileSizeEx(file, &fileSize)) {
+            CloseHandle(file);
+            return false;
+        }
+        size = static_cast<size_t>(fileSize.QuadPart);
+        if (size > 0) {
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) {
+                data = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            }
+        }
+        CloseHandle(file);
+        if (size > 0 && !data) {
+            Close();
+            return false;
+        }
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+            ::close(fd);
+            return false;
+        }
+        size = static_cast<size_t>(st.st_size);
+        if (size > 0) {
+            void *p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p == MAP_FAILED) {
+                ::close(fd);
+                size = 0;
+                return false;
+            }
+            data = static_cast<const char *>(p);
+        }
+        ::close(fd);
+#endif
+        opened = true;
+        return true;
+    }
+
+    [[nodiscard]] bool IsOpen() const { return opened; }
+
+    [[nodiscard]] std::string_view View() const { return {data ? data : "", size}; }
+
+private:
+    const char *data = nullptr;
+    size_t size = 0;
+    bool opened = false;
+#ifdef _WIN32
+    HANDLE mapping = nullptr;
+#endif
+
+    void Close() {
+#ifdef _WIN32
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        mapping = nullptr;
+#else
+        if (data) munmap(const_cast<char *>(data), size);
+#endif
+        data = nullptr;
+        size = 0;
+        opened = false;
+    }
+};
+
+#endif //BXSCRIPT_MAPPEDFILE_H
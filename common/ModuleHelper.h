@@ -23,16 +23,6 @@ namespace fs = std::filesystem;
 
 class ModuleHelper {
 public:
-    static std::string ReadFile(const std::string &path) {
-        std::ifstream file(path);
-        if (!file.is_open()) {
-            throw std::runtime_error("无法打开模块文件: " + path);
-        }
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        return buffer.str();
-    }
-
     static fs::path GetExecutableDir() {
         return fs::current_path();
     }
@@ -0,0 +1,91 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    属性访问点的内联缓存
+ */
+
+#ifndef BXSCRIPT_PROPERTYCACHE_H
+#define BXSCRIPT_PROPERTYCACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+struct NativeMethod;
+
+// 属性访问点 (obj.name) 的内联缓存: 记住在该处见过的 Shape 及属性所在槽位, 最多 Ways 种.
+// 每一项把 Shape 编号 (低 48 位) 与槽位 (16 位) 打包进一个原子字, 多个线程同时执行同一处代码也不会读到错配的组合.
+// 编号截断后理论上仍可能重复, 命中时还要求槽位小于 Shape 的属性数.
+// 缓存挂在语法树节点上, 这里只用 Shape 的编号与属性数, 语法树不必依赖求值器的 Shape 定义.
+class PropertyCache {
+public:
+    static constexpr int Ways = 4;
+    // Lookup 的返回值: 未记录过该 Shape
+    static constexpr int Miss = -1;
+    // Lookup 的返回值: 该 Shape 没有这个属性, 需要到原型上找
+    static constexpr int Absent = -2;
+
+    [[nodiscard]] int Lookup(const uint64_t shapeId, const size_t shapeSize) const {
+        for (const auto &entry: entries) {
+            const uint64_t word = entry.load(std::memory_order_relaxed);
+            if (Matches(word, shapeId, shapeSize)) {
+                return SlotOf(word);
+            }
+        }
+        return Miss;
+    }
+
+    // 轮流覆盖, 多态的访问点最多同时记住 Ways 种 Shape
+    void Record(const uint64_t shapeId, const int slot) {
+        const unsigned way = next.fetch_add(1, std::memory_order_relaxed) % Ways;
+        entries[way].store(Pack(shapeId, slot), std::memory_order_relaxed);
+    }
+
+    // 原型上的查找结果单独记录, 以原型当前的 Shape 校验: 原型增删属性后 Shape 随之改变, 缓存自然失效
+    [[nodiscard]] int LookupPrototype(const uint64_t shapeId, const size_t shapeSize) const {
+        const uint64_t word = prototype.load(std::memory_order_relaxed);
+        if (Matches(word, shapeId, shapeSize)) {
+            return SlotOf(word);
+        }
+        return Miss;
+    }
+
+    void RecordPrototype(const uint64_t shapeId, const int slot) {
+        prototype.store(Pack(shapeId, slot), std::memory_order_relaxed);
+    }
+
+    // 调用点 (recv.method(...)) 上一次解析到的内置方法, 由调用方按接收者类型校验
+    [[nodiscard]] const NativeMethod *Method() const { return method.load(std::memory_order_relaxed); }
+
+    void RecordMethod(const NativeMethod *m) { method.store(m, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> entries[Ways]{};
+    std::atomic<uint64_t> prototype{0};
+    std::atomic<unsigned> next{0};
+    std::atomic<const NativeMethod *> method{nullptr};
+
+    static constexpr uint64_t IdMask = (uint64_t{1} << 48) - 1;
+
+    static uint64_t Pack(const uint64_t shapeId, const int slot) {
+        return (shapeId & IdMask) << 16 | static_cast<uint16_t>(static_cast<int16_t>(slot));
+    }
+
+    // 槽位还要落在 Shape 的范围内, 编号碰巧重复时当作未命中, 不会越界
+    static bool Matches(const uint64_t word, const uint64_t shapeId, const size_t shapeSize) {
+        return word >> 16 == (shapeId & IdMask) && SlotOf(word) < static_cast<int>(shapeSize);
+    }
+
+    static int SlotOf(const uint64_t word) {
+        return static_cast<int16_t>(static_cast<uint16_t>(word));
+    }
+};
+
+#endif //BXSCRIPT_PROPERTYCACHE_H
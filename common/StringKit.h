@@ -13,11 +13,25 @@
 
 #ifndef BXSCRIPT_STRINGKIT_H
 #define BXSCRIPT_STRINGKIT_H
+#include <cerrno>
+#include <cstdlib>
 #include <string>
 
 
 class StringKit {
 public:
+    // 按 std::stoul 的规则解析下标, 无法解析时返回 false 而不是抛异常
+    static bool ToIndex(const std::string &s, size_t &index) {
+        errno = 0;
+        char *end = nullptr;
+        const unsigned long value = std::strtoul(s.c_str(), &end, 10);
+        if (end == s.c_str() || errno == ERANGE) {
+            return false;
+        }
+        index = value;
+        return true;
+    }
+
     static std::u32string Utf8ToU32(const std::string &s) {
         std::u32string result;
         result.reserve(s.length());
@@ -13,28 +13,39 @@
 
 #ifndef BXSCRIPT_SYMBOLS_H
 #define BXSCRIPT_SYMBOLS_H
-#include <string>
-#include <unordered_set>
+#include <string_view>
 
 
 class Symbols {
 public:
-    static bool isSymbols(const std::string &str) {
-        return SymbolList.find(str) != SymbolList.end();
+    static bool isSymbols(const char c) {
+        return c != '\0' && SymbolList.find(c) != std::string_view::npos;
     }
-private:
-    static const std::unordered_set<std::string> SymbolList;
-};
 
-const inline std::unordered_set<std::string> Symbols::SymbolList{
-    "{","}",
-    "(",")",
-    "[","]",
-    ".",
-    ",",
-    ";",
-    "+","-","*","/","%","=",
-    "&","|","!","<",">",":"
+    // 单字符运算符的静态文本
+    static std::string_view Text(const char c) {
+        return SymbolList.substr(SymbolList.find(c), 1);
+    }
+
+    // 任意运算符拼写 (单字符或双字符) 对应的静态文本, 不是运算符时返回空
+    static std::string_view Find(const std::string_view text) {
+        if (text.size() == 1 && isSymbols(text[0])) {
+            return Text(text[0]);
+        }
+        for (const auto &compound: Compounds) {
+            if (compound == text) {
+                return compound;
+            }
+        }
+        return {};
+    }
+
+    static constexpr std::string_view SymbolList = "{}()[].,;+-*/%=&|!<>:";
+
+    // 词法分析合并的双字符运算符
+    static constexpr std::string_view Compounds[] = {
+        "==", ">=", "<=", "!=", "&&", "||", "++", "+=", "--", "-=", "*=", "%="
+    };
 };
 
 #endif //BXSCRIPT_SYMBOLS_H
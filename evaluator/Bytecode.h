@@ -0,0 +1,99 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    字节码定义: 指令集与编译单元
+ */
+
+#ifndef BXSCRIPT_BYTECODE_H
+#define BXSCRIPT_BYTECODE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Value.h"
+
+// 寄存器式指令, R[x] 为寄存器, K[x] 为常量, N[x] 为名字, F[x] 为函数字面量,
+// L[x] 为 Resolver 解析出的局部变量, S[x] 为作用域布局, P[x] 为属性访问点
+enum class OpCode : uint8_t {
+    LOAD_CONST, // R[A] = K[B]
+    LOAD_NULL, // R[A] = null
+    MOVE, // R[A] = R[B]
+    LOAD_NAME, // R[A] = env.Lookup(N[B])
+    STORE_NAME, // env.Assign(N[B], R[A])
+    DECLARE_NAME, // env.Declare(N[B], R[A])
+    LOAD_LOCAL, // R[A] = env.LookupSlot(L[B])
+    STORE_LOCAL, // env.AssignSlot(L[B], R[A])
+    DECLARE_LOCAL, // env.DeclareSlot(B, R[A])
+    CONCAT_LOCAL, // R[A] = L[B] = R[A] + R[C], R[A] 为先前读出的 L[B]; 字符串只被变量与 R[A] 持有时原地追加
+    CONCAT_NAME, // 同 CONCAT_LOCAL, 变量为 N[B]
+    ENTER_SCOPE, // env = new Environment(env, S[A])
+    LEAVE_SCOPE, // env = env.parent, 重复 A 次
+    NEW_OBJECT, // R[A] = {}
+    NEW_ARRAY, // R[A] = [R[B] .. R[B + C - 1]]
+    GET_FIELD, // R[A] = R[B].Get(P[C])
+    SET_FIELD, // R[A].Set(P[B], R[C])
+    GET_INDEX, // R[A] = R[B].Get(R[C].ToString())
+    SET_INDEX, // R[A].Set(R[B].ToString(), R[C])
+    ADD, SUB, MUL, DIV, MOD, // R[A] = R[B] op R[C]
+    LT, GT, LE, GE, EQ, NE,
+    NOT, // R[A] = !R[B]
+    NEG, // R[A] = -R[B]
+    POS, // R[A] = +R[B]
+    INC, // R[A] = R[B] + 1
+    DEC, // R[A] = R[B] - 1
+    JUMP, // pc = A
+    JUMP_IF_FALSE, // if (!R[A]) pc = B
+    JUMP_IF_TRUE, // if (R[A]) pc = B
+    CLOSURE, // R[A] = function(F[B], env)
+    CALL, // R[A] = R[B](R[B + 1] .. R[B + C])
+    GET_METHOD, // R[A + 1] = R[A].Get(P[B]), 内置方法时 R[A + 1] 留空; 不是原型上的方法时清空 R[A]
+    CALL_METHOD, // R[A] = R[A].P[C](R[A + 2] .. R[A + 1 + B]), R[A + 1] 为空时调用内置方法, 否则以 R[A] 为 this 调用 R[A + 1]
+    RETURN, // return R[A]
+    THROW, // throw R[A]
+    TRY_BEGIN, // 注册异常处理: 跳转到 A, 异常值写入 R[B]
+    TRY_END, // 注销最近的异常处理
+    FAIL, // throw runtime_error(K[A])
+};
+
+struct Instruction {
+    OpCode Op;
+    int32_t A = 0, B = 0, C = 0;
+};
+
+class FunctionLiteral;
+
+struct LocalRef {
+    int32_t Depth;
+    int32_t Slot;
+    int32_t Name; // 槽位为空时按名字向外层查找
+};
+
+// 属性访问点: 属性名与所属 DotExpression 上的内联缓存 (对象字面量没有, 为空)
+struct FieldRef {
+    int32_t Name;
+    PropertyCache *Cache;
+};
+
+// 一个函数体或一段程序编译后的结果
+class BytecodeChunk {
+public:
+    std::vector<Instruction> Code{};
+    std::vector<ValuePtr> Constants{};
+    std::vector<Atom> Names{};
+    std::vector<FunctionLiteral *> Functions{};
+    std::vector<LocalRef> Locals{};
+    std::vector<FieldRef> Fields{};
+    std::vector<const std::vector<Atom> *> Scopes{};
+    // R[0] 固定保存语句的完成值 (与 Execute 的返回值一致)
+    int RegisterCount = 1;
+};
+
+#endif //BXSCRIPT_BYTECODE_H
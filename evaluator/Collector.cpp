@@ -0,0 +1,173 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    循环引用回收 (试探删除)
+ */
+
+#include "Collector.h"
+
+#include <algorithm>
+
+#include "Value.h"
+
+std::mutex Collector::listLock{};
+GcNode *Collector::head = nullptr;
+size_t Collector::counts[4] = {};
+size_t Collector::threshold = Collector::MinThreshold;
+std::atomic<bool> Collector::due{false};
+Collector::Stats Collector::history{};
+
+GcNode::~GcNode() {
+    if (tracked) {
+        Collector::Untrack(this);
+    }
+}
+
+std::shared_mutex &Collector::WorldLock() {
+    static std::shared_mutex world;
+    return world;
+}
+
+void Collector::Track(GcNode *node) {
+    std::lock_guard<std::mutex> lock(listLock);
+    if (node->tracked) {
+        return;
+    }
+    node->tracked = true;
+    node->prev = nullptr;
+    node->next = head;
+    if (head) {
+        head->prev = node;
+    }
+    head = node;
+    ++counts[static_cast<int>(node->kind)];
+    if (Total() >= threshold) {
+        due.store(true, std::memory_order_relaxed);
+    }
+}
+
+void Collector::Untrack(GcNode *node) {
+    std::lock_guard<std::mutex> lock(listLock);
+    if (node->prev) {
+        node->prev->next = node->next;
+    } else {
+        head = node->next;
+    }
+    if (node->next) {
+        node->next->prev = node->prev;
+    }
+    node->tracked = false;
+    --counts[static_cast<int>(node->kind)];
+}
+
+size_t Collector::Total() {
+    return counts[0] + counts[1] + counts[2] + counts[3];
+}
+
+GcNode *Collector::Node(const std::shared_ptr<RuntimeValue> &value) {
+    if (!value) {
+        return nullptr;
+    }
+    switch (value->type) {
+        case ValueType::OBJECT:
+            return static_cast<ObjectValue *>(value.get());
+        case ValueType::ARRAY:
+            return static_cast<ArrayValue *>(value.get());
+        case ValueType::FUNCTION:
+            return static_cast<FunctionValue *>(value.get());
+        case ValueType::NATIVE_FUNCTION:
+            return static_cast<NativeFunctionValue *>(value.get());
+        default:
+            return nullptr;
+    }
+}
+
+size_t Collector::Collect() {
+    // 其他线程正在运行脚本时对象图随时在变, 放弃本次回收
+    std::unique_lock<std::shared_mutex> world(WorldLock(), std::try_to_lock);
+    if (!world.owns_lock()) {
+        return 0;
+    }
+    // 节点与保持其存活的引用
+    std::vector<std::pair<GcNode *, std::shared_ptr<void> > > garbage;
+    {
+        std::lock_guard<std::mutex> lock(listLock);
+        std::vector<GcNode *> nodes;
+        nodes.reserve(Total());
+        for (GcNode *node = head; node; node = node->next) {
+            node->external = node->RefCount();
+            // 还没交给 shared_ptr 管理 (正在构造) 的对象当作有外部引用
+            if (node->external == 0) {
+                node->external = 1;
+            }
+            node->reachable = false;
+            nodes.push_back(node);
+        }
+        // 减去登记对象之间的引用
+        std::vector<GcNode *> children;
+        for (const GcNode *node: nodes) {
+            children.clear();
+            node->Trace(children);
+            for (GcNode *child: children) {
+                if (child->tracked) {
+                    --child->external;
+                }
+            }
+        }
+        // 从有外部引用的对象出发标记
+        std::vector<GcNode *> pending;
+        for (GcNode *node: nodes) {
+            if (node->external > 0) {
+                node->reachable = true;
+                pending.push_back(node);
+            }
+        }
+        while (!pending.empty()) {
+            const GcNode *node = pending.back();
+            pending.pop_back();
+            children.clear();
+            node->Trace(children);
+            for (GcNode *child: children) {
+                if (child->tracked && !child->reachable) {
+                    child->reachable = true;
+                    pending.push_back(child);
+                }
+            }
+        }
+        for (GcNode *node: nodes) {
+            if (!node->reachable) {
+                garbage.emplace_back(node, node->Retain());
+            }
+        }
+    }
+    // 释放时对象会注销自己, 需在列表锁之外进行
+    for (const auto &[node, keep]: garbage) {
+        node->Unlink();
+    }
+    const size_t freed = garbage.size();
+    garbage.clear();
+    std::lock_guard<std::mutex> lock(listLock);
+    ++history.Collections;
+    history.Freed += freed;
+    history.LastFreed = freed;
+    threshold = std::max(MinThreshold, Total() * 2);
+    due.store(false, std::memory_order_relaxed);
+    return freed;
+}
+
+Collector::Stats Collector::GetStats() {
+    std::lock_guard<std::mutex> lock(listLock);
+    Stats stats = history;
+    stats.Environments = counts[static_cast<int>(GcNode::Kind::ENVIRONMENT)];
+    stats.Objects = counts[static_cast<int>(GcNode::Kind::OBJECT)];
+    stats.Arrays = counts[static_cast<int>(GcNode::Kind::ARRAY)];
+    stats.Functions = counts[static_cast<int>(GcNode::Kind::FUNCTION)];
+    return stats;
+}
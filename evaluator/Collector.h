@@ -0,0 +1,132 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    循环引用回收 (试探删除)
+ */
+
+#ifndef BXSCRIPT_COLLECTOR_H
+#define BXSCRIPT_COLLECTOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+class RuntimeValue;
+
+// 可能出现在引用环上的堆对象: 环境、对象、数组、函数.
+// 普通的引用计数照常释放它们, 回收器只负责清理彼此引用、外部已无法访问的环.
+class GcNode {
+public:
+    enum class Kind : unsigned char {
+        ENVIRONMENT, OBJECT, ARRAY, FUNCTION
+    };
+
+    explicit GcNode(const Kind kind) : kind(kind) {
+    }
+
+    GcNode(const GcNode &) = delete;
+
+    GcNode &operator=(const GcNode &) = delete;
+
+    virtual ~GcNode();
+
+    [[nodiscard]] Kind NodeKind() const { return kind; }
+
+    [[nodiscard]] bool Tracked() const { return tracked; }
+
+    // 当前的强引用数 (shared_ptr::use_count)
+    [[nodiscard]] virtual long RefCount() const = 0;
+
+    // 持有的强引用, 同一个对象被持有几次就列出几次; 只能列出确实以 shared_ptr 持有的引用
+    virtual void Trace(std::vector<GcNode *> &out) const = 0;
+
+    // 回收时断开持有的全部引用
+    virtual void Unlink() = 0;
+
+    // 回收期间保持存活
+    [[nodiscard]] virtual std::shared_ptr<void> Retain() = 0;
+
+private:
+    friend class Collector;
+
+    const Kind kind;
+    bool tracked = false;
+    // 回收期间使用: 来自环外的引用数与可达标记
+    bool reachable = false;
+    long external = 0;
+    GcNode *prev = nullptr;
+    GcNode *next = nullptr;
+};
+
+// 试探删除: 用引用计数减去被登记对象之间的引用, 剩余的就是来自栈、缓存、事件队列等外部的引用.
+// 从有外部引用的对象出发标记可达对象, 其余的只被环内引用, 断开后由引用计数释放.
+class Collector {
+public:
+    struct Stats {
+        size_t Environments = 0;
+        size_t Objects = 0;
+        size_t Arrays = 0;
+        size_t Functions = 0;
+        size_t Collections = 0;
+        size_t Freed = 0;
+        size_t LastFreed = 0;
+    };
+
+    // 脚本在其他线程运行期间 (Thread.invoke、异步请求) 持有, 此时跳过回收
+    class Mutator {
+    public:
+        Mutator() : lock(WorldLock()) {
+        }
+
+    private:
+        std::shared_lock<std::shared_mutex> lock;
+    };
+
+    // 开始参与回收; 重复登记无效果
+    static void Track(GcNode *node);
+
+    // 值对应的回收节点, 不可能成环的类型返回 nullptr
+    static GcNode *Node(const std::shared_ptr<RuntimeValue> &value);
+
+    // 立即回收, 返回释放的对象数; 有其他线程在运行脚本时返回 0
+    static size_t Collect();
+
+    // 登记的对象数自上次回收后翻倍时回收; 在事件循环的任务之间与循环的每轮末尾调用
+    static void MaybeCollect() {
+        if (due.load(std::memory_order_relaxed)) {
+            Collect();
+        }
+    }
+
+    static Stats GetStats();
+
+private:
+    static constexpr size_t MinThreshold = 10000;
+
+    static std::mutex listLock;
+    static GcNode *head;
+    static size_t counts[4];
+    static size_t threshold;
+    static std::atomic<bool> due;
+    static Stats history;
+
+    static std::shared_mutex &WorldLock();
+
+    static void Untrack(GcNode *node);
+
+    static size_t Total();
+
+    friend class GcNode;
+};
+
+#endif //BXSCRIPT_COLLECTOR_H
@@ -0,0 +1,673 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    字节码编译器, 语义与 Interpreter::Execute/Evaluate 保持一致
+ */
+
+#include "Compiler.h"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+
+#include "Interpreter.h"
+
+std::shared_ptr<BytecodeChunk> Compiler::CompileProgram(const Program &program) {
+    auto chunk = std::make_shared<BytecodeChunk>();
+    Compiler compiler(*chunk);
+    compiler.Emit(OpCode::LOAD_NULL, 0);
+    for (const auto &stmt: program.Body) {
+        compiler.CompileStatement(stmt.get());
+    }
+    compiler.Emit(OpCode::RETURN, 0);
+    return chunk;
+}
+
+const BytecodeChunk &Compiler::CompileFunction(FunctionLiteral *func) {
+    // Thread.invoke 会在其他线程调用函数, 编译只允许发生一次
+    std::call_once(func->BytecodeOnce, [func] {
+        auto chunk = std::make_shared<BytecodeChunk>();
+        Compiler compiler(*chunk);
+        compiler.Emit(OpCode::LOAD_NULL, 0);
+        compiler.CompileStatement(func->Body.get());
+        compiler.Emit(OpCode::RETURN, 0);
+        func->Bytecode = chunk;
+    });
+    return *func->Bytecode;
+}
+
+size_t Compiler::Emit(const OpCode op, const int32_t a, const int32_t b, const int32_t c) {
+    chunk.Code.push_back(Instruction{op, a, b, c});
+    return chunk.Code.size() - 1;
+}
+
+// 把跳转指令的目标改为当前位置
+void Compiler::PatchJump(const size_t at) {
+    auto &ins = chunk.Code[at];
+    const auto target = static_cast<int32_t>(chunk.Code.size());
+    if (ins.Op == OpCode::JUMP) {
+        ins.A = target;
+    } else {
+        ins.B = target;
+    }
+}
+
+void Compiler::EmitLeave(const int targetDepth) {
+    if (scopeDepth > targetDepth) {
+        Emit(OpCode::LEAVE_SCOPE, scopeDepth - targetDepth);
+    }
+}
+
+// break/continue 交给最近的循环, 若中间隔着 try 块则被该块吞掉
+void Compiler::EmitBranch(const bool isBreak) {
+    if (controls.empty()) {
+        return;
+    }
+    auto &ctx = controls.back();
+    EmitLeave(ctx.ScopeDepth);
+    const auto jump = Emit(OpCode::JUMP);
+    if (isBreak || !ctx.IsLoop) {
+        ctx.BreakJumps.push_back(jump);
+    } else {
+        ctx.ContinueJumps.push_back(jump);
+    }
+}
+
+// 与 Execute 一致: 没有声明的代码块/for 作用域不创建环境, 返回是否进入了新作用域
+bool Compiler::EmitEnterScope(const ScopeLayout &layout, const bool elidable) {
+    if (elidable && layout.empty()) {
+        return false;
+    }
+    chunk.Scopes.push_back(&layout);
+    Emit(OpCode::ENTER_SCOPE, static_cast<int32_t>(chunk.Scopes.size() - 1));
+    scopeDepth++;
+    return true;
+}
+
+// 已解析的局部变量走槽位, 其余按名字查找
+void Compiler::EmitLoad(const Identifier *id, const int target) {
+    if (id->Slot >= 0) {
+        Emit(OpCode::LOAD_LOCAL, target, AddLocal(id));
+    } else {
+        Emit(OpCode::LOAD_NAME, target, AddName(id->Name));
+    }
+}
+
+void Compiler::EmitStore(const Identifier *id, const int source) {
+    if (id->Slot >= 0) {
+        Emit(OpCode::STORE_LOCAL, source, AddLocal(id));
+    } else {
+        Emit(OpCode::STORE_NAME, source, AddName(id->Name));
+    }
+}
+
+void Compiler::EmitFail(const std::string &message) {
+    Emit(OpCode::FAIL, AddConstant(std::make_shared<StringValue>(message)));
+}
+
+int Compiler::AllocRegister() {
+    const int reg = nextRegister++;
+    chunk.RegisterCount = std::max(chunk.RegisterCount, nextRegister);
+    return reg;
+}
+
+int Compiler::AddConstant(ValuePtr value) {
+    chunk.Constants.push_back(std::move(value));
+    return static_cast<int>(chunk.Constants.size() - 1);
+}
+
+int Compiler::AddLocal(const Identifier *id) {
+    return AddLocal(id->Depth, id->Slot, id->Name);
+}
+
+int Compiler::AddLocal(const int32_t depth, const int32_t slot, const Atom &name) {
+    chunk.Locals.push_back(LocalRef{depth, slot, AddName(name)});
+    return static_cast<int>(chunk.Locals.size() - 1);
+}
+
+int Compiler::AddField(const Atom &name, PropertyCache *cache) {
+    chunk.Fields.push_back(FieldRef{AddName(name), cache});
+    return static_cast<int>(chunk.Fields.size() - 1);
+}
+
+int Compiler::AddName(const Atom &name) {
+    const auto it = nameIndex.find(name);
+    if (it != nameIndex.end()) {
+        return it->second;
+    }
+    chunk.Names.push_back(name);
+    const int index = static_cast<int>(chunk.Names.size() - 1);
+    nameIndex.emplace(name, index);
+    return index;
+}
+
+OpCode Compiler::BinaryOpCode(const OperatorKind op) {
+    switch (op) {
+        case OperatorKind::ADD: return OpCode::ADD;
+        case OperatorKind::SUB: return OpCode::SUB;
+        case OperatorKind::MUL: return OpCode::MUL;
+        case OperatorKind::DIV: return OpCode::DIV;
+        case OperatorKind::MOD: return OpCode::MOD;
+        case OperatorKind::LT: return OpCode::LT;
+        case OperatorKind::GT: return OpCode::GT;
+        case OperatorKind::LE: return OpCode::LE;
+        case OperatorKind::GE: return OpCode::GE;
+        case OperatorKind::EQ: return OpCode::EQ;
+        case OperatorKind::NE: return OpCode::NE;
+        default: return OpCode::FAIL;
+    }
+}
+
+// 每条语句执行完后 R[0] 即为该语句的完成值
+void Compiler::CompileStatement(Statement *stmt) {
+    switch (stmt->Kind) {
+        case NodeKind::VARIABLE_STATEMENT: {
+            const auto *varStmt = static_cast<VariableStatement *>(stmt);
+            const int mark = nextRegister;
+            for (const auto &decl: varStmt->List) {
+                if (decl->Kind == NodeKind::VARIABLE) {
+                    CompileExpression(decl.get(), AllocRegister());
+                    nextRegister = mark;
+                }
+            }
+            Emit(OpCode::LOAD_NULL, 0);
+            return;
+        }
+        case NodeKind::IF: {
+            const auto *ifStmt = static_cast<IfStatement *>(stmt);
+            const int mark = nextRegister;
+            const int cond = AllocRegister();
+            CompileExpression(ifStmt->Condition.get(), cond);
+            nextRegister = mark;
+            const auto toElse = Emit(OpCode::JUMP_IF_FALSE, cond);
+            CompileStatement(ifStmt->Ok.get());
+            const auto toEnd = Emit(OpCode::JUMP);
+            PatchJump(toElse);
+            if (ifStmt->Else) {
+                CompileStatement(ifStmt->Else.get());
+            } else {
+                Emit(OpCode::LOAD_NULL, 0);
+            }
+            PatchJump(toEnd);
+            return;
+        }
+        case NodeKind::BLOCK:
+            CompileBlock(static_cast<BlockStatement *>(stmt));
+            return;
+        case NodeKind::EXPRESSION_STATEMENT:
+            CompileExpression(static_cast<ExpressionStatement *>(stmt)->Expression.get(), 0);
+            return;
+        case NodeKind::FOR:
+            CompileFor(static_cast<ForStatement *>(stmt));
+            return;
+        case NodeKind::THROW: {
+            const auto *throwStmt = static_cast<ThrowStatement *>(stmt);
+            const int mark = nextRegister;
+            const int error = AllocRegister();
+            CompileExpression(throwStmt->Argument.get(), error);
+            Emit(OpCode::THROW, error);
+            nextRegister = mark;
+            return;
+        }
+        case NodeKind::TRY:
+            CompileTry(static_cast<TryStatement *>(stmt));
+            return;
+        case NodeKind::RETURN: {
+            const auto *retStmt = static_cast<ReturnStatement *>(stmt);
+            const int mark = nextRegister;
+            const int value = AllocRegister();
+            if (retStmt->Argument) {
+                CompileExpression(retStmt->Argument.get(), value);
+            } else {
+                Emit(OpCode::LOAD_NULL, value);
+            }
+            nextRegister = mark;
+            // 处于 try/catch/finally 中时, 返回值会被该块丢弃
+            const auto swallow = std::find_if(controls.rbegin(), controls.rend(), [](const ControlContext &ctx) {
+                return !ctx.IsLoop;
+            });
+            if (swallow == controls.rend()) {
+                Emit(OpCode::RETURN, value);
+                return;
+            }
+            EmitLeave(swallow->ScopeDepth);
+            swallow->BreakJumps.push_back(Emit(OpCode::JUMP));
+            return;
+        }
+        case NodeKind::BREAK:
+            EmitBranch(true);
+            return;
+        case NodeKind::CONTINUE:
+            EmitBranch(false);
+            return;
+        default:
+            // 空语句, 函数声明 (已提升) 等
+            Emit(OpCode::LOAD_NULL, 0);
+            return;
+    }
+}
+
+void Compiler::CompileBlock(const BlockStatement *block) {
+    const bool entered = EmitEnterScope(block->Scope, true);
+    if (block->StatementList.empty()) {
+        Emit(OpCode::LOAD_NULL, 0);
+    }
+    for (const auto &s: block->StatementList) {
+        CompileStatement(s.get());
+    }
+    if (entered) {
+        scopeDepth--;
+        Emit(OpCode::LEAVE_SCOPE, 1);
+    }
+}
+
+// 与 Execute 一致: loopEnv 保存初始化变量, 每轮再创建 iterationEnv
+void Compiler::CompileFor(const ForStatement *forStmt) {
+    const int mark = nextRegister;
+    const int temp = AllocRegister();
+    const bool loopEntered = EmitEnterScope(forStmt->LoopScope, true);
+    if (forStmt->Initializer) {
+        CompileExpression(forStmt->Initializer.get(), temp);
+    }
+    const auto loopStart = static_cast<int32_t>(chunk.Code.size());
+    const bool iterationEntered = EmitEnterScope(forStmt->IterationScope, true);
+    size_t toExit = 0;
+    const bool hasTest = forStmt->Test != nullptr;
+    if (hasTest) {
+        CompileExpression(forStmt->Test.get(), temp);
+        toExit = Emit(OpCode::JUMP_IF_FALSE, temp);
+    }
+    controls.push_back(ControlContext{true, scopeDepth});
+    CompileStatement(forStmt->Body.get());
+    auto ctx = std::move(controls.back());
+    controls.pop_back();
+    for (const auto jump: ctx.ContinueJumps) {
+        PatchJump(jump);
+    }
+    if (forStmt->Update) {
+        CompileExpression(forStmt->Update.get(), temp);
+    }
+    if (iterationEntered) {
+        Emit(OpCode::LEAVE_SCOPE, 1);
+    }
+    Emit(OpCode::JUMP, loopStart);
+    if (hasTest) {
+        PatchJump(toExit);
+    }
+    for (const auto jump: ctx.BreakJumps) {
+        PatchJump(jump);
+    }
+    const int leave = loopEntered + iterationEntered;
+    scopeDepth -= leave;
+    if (leave > 0) {
+        Emit(OpCode::LEAVE_SCOPE, leave);
+    }
+    Emit(OpCode::LOAD_NULL, 0);
+    nextRegister = mark;
+}
+
+// try/catch/finally 内部的 break/continue/return 只会结束所在的块
+void Compiler::CompileSwallowed(Statement *stmt) {
+    controls.push_back(ControlContext{false, scopeDepth});
+    CompileStatement(stmt);
+    const auto ctx = std::move(controls.back());
+    controls.pop_back();
+    for (const auto jump: ctx.BreakJumps) {
+        PatchJump(jump);
+    }
+}
+
+void Compiler::CompileTry(const TryStatement *tryStmt) {
+    const int mark = nextRegister;
+    const int error = AllocRegister();
+    const auto handler = Emit(OpCode::TRY_BEGIN, 0, error);
+    CompileSwallowed(tryStmt->Body.get());
+    Emit(OpCode::TRY_END);
+    const auto toFinally = Emit(OpCode::JUMP);
+    chunk.Code[handler].A = static_cast<int32_t>(chunk.Code.size());
+    if (tryStmt->Catch) {
+        EmitEnterScope(tryStmt->Catch->Scope, false);
+        Emit(OpCode::DECLARE_LOCAL, error, tryStmt->Catch->Parameter->Slot);
+        CompileSwallowed(tryStmt->Catch->Body.get());
+        scopeDepth--;
+        Emit(OpCode::LEAVE_SCOPE, 1);
+    }
+    PatchJump(toFinally);
+    if (tryStmt->Finally) {
+        CompileSwallowed(tryStmt->Finally.get());
+    }
+    Emit(OpCode::LOAD_NULL, 0);
+    nextRegister = mark;
+}
+
+void Compiler::CompileExpression(Expression *expr, const int target) {
+    if (expr == nullptr) {
+        Emit(OpCode::LOAD_NULL, target);
+        return;
+    }
+    switch (expr->Kind) {
+        case NodeKind::SEQUENCE: {
+            const auto *seq = static_cast<SequenceExpression *>(expr);
+            if (seq->Sequence.empty()) {
+                Emit(OpCode::LOAD_NULL, target);
+            }
+            for (const auto &subExpr: seq->Sequence) {
+                CompileExpression(subExpr.get(), target);
+            }
+            return;
+        }
+        case NodeKind::VARIABLE: {
+            const auto *varExpr = static_cast<VariableExpression *>(expr);
+            CompileExpression(varExpr->Initializer.get(), target);
+            if (varExpr->Slot >= 0) {
+                Emit(OpCode::DECLARE_LOCAL, target, varExpr->Slot);
+            } else {
+                Emit(OpCode::DECLARE_NAME, target, AddName(varExpr->Name));
+            }
+            return;
+        }
+        case NodeKind::NULL_LITERAL:
+            Emit(OpCode::LOAD_NULL, target);
+            return;
+        case NodeKind::BOOLEAN_LITERAL: {
+            const auto *_bool = static_cast<BooleanLiteral *>(expr);
+            Emit(OpCode::LOAD_CONST, target, AddConstant(BoolValue::Of(_bool->Value)));
+            return;
+        }
+        case NodeKind::NUMBER_LITERAL: {
+            const auto *num = static_cast<NumberLiteral *>(expr);
+            Emit(OpCode::LOAD_CONST, target, AddConstant(num->Constant));
+            return;
+        }
+        case NodeKind::STRING_LITERAL: {
+            const auto *str = static_cast<StringLiteral *>(expr);
+            Emit(OpCode::LOAD_CONST, target, AddConstant(str->Constant));
+            return;
+        }
+        case NodeKind::IDENTIFIER: {
+            const auto *id = static_cast<Identifier *>(expr);
+            EmitLoad(id, target);
+            return;
+        }
+        case NodeKind::THIS: {
+            static const Atom thisName = Atom::Intern("this");
+            const auto *self = static_cast<ThisExpression *>(expr);
+            if (self->Slot >= 0) {
+                Emit(OpCode::LOAD_LOCAL, target, AddLocal(self->Depth, self->Slot, thisName));
+            } else {
+                Emit(OpCode::LOAD_NAME, target, AddName(thisName));
+            }
+            return;
+        }
+        case NodeKind::OBJECT_LITERAL: {
+            const auto *objLit = static_cast<ObjectLiteral *>(expr);
+            const int mark = nextRegister;
+            const int obj = AllocRegister();
+            const int val = AllocRegister();
+            Emit(OpCode::NEW_OBJECT, obj);
+            for (const auto &prop: objLit->Value) {
+                CompileExpression(prop->Value.get(), val);
+                Emit(OpCode::SET_FIELD, obj, AddField(prop->Key, nullptr), val);
+            }
+            Emit(OpCode::MOVE, target, obj);
+            nextRegister = mark;
+            return;
+        }
+        case NodeKind::ARRAY_LITERAL: {
+            const auto *arrLit = static_cast<ArrayLiteral *>(expr);
+            const int mark = nextRegister;
+            const int base = nextRegister;
+            for (const auto &elemExpr: arrLit->Value) {
+                CompileExpression(elemExpr.get(), AllocRegister());
+            }
+            Emit(OpCode::NEW_ARRAY, target, base, static_cast<int32_t>(arrLit->Value.size()));
+            nextRegister = mark;
+            return;
+        }
+        case NodeKind::BINARY: {
+            const auto *bin = static_cast<BinaryExpression *>(expr);
+            const int mark = nextRegister;
+            if (bin->Op == OperatorKind::AND || bin->Op == OperatorKind::OR) {
+                const int left = AllocRegister();
+                CompileExpression(bin->Left.get(), left);
+                Emit(OpCode::MOVE, target, left);
+                const auto toEnd = Emit(bin->Op == OperatorKind::AND ? OpCode::JUMP_IF_FALSE : OpCode::JUMP_IF_TRUE, left);
+                CompileExpression(bin->Right.get(), target);
+                PatchJump(toEnd);
+                nextRegister = mark;
+                return;
+            }
+            const int left = AllocRegister();
+            const int right = AllocRegister();
+            CompileExpression(bin->Left.get(), left);
+            CompileExpression(bin->Right.get(), right);
+            const OpCode code = BinaryOpCode(bin->Op);
+            if (code == OpCode::FAIL) {
+                EmitFail("不支持的操作: " + std::string(bin->Operator.TokenValue));
+            } else {
+                Emit(code, target, left, right);
+            }
+            nextRegister = mark;
+            return;
+        }
+        case NodeKind::UNARY:
+            CompileUnary(static_cast<UnaryExpression *>(expr), target);
+            return;
+        case NodeKind::ASSIGN:
+            CompileAssign(static_cast<AssignExpression *>(expr), target);
+            return;
+        case NodeKind::DOT: {
+            const auto *dot = static_cast<DotExpression *>(expr);
+            const int mark = nextRegister;
+            const int obj = AllocRegister();
+            CompileExpression(dot->Left.get(), obj);
+            Emit(OpCode::GET_FIELD, target, obj, AddField(dot->Identifier->Name, &dot->Cache));
+            nextRegister = mark;
+            return;
+        }
+        case NodeKind::BRACKET: {
+            const auto *bracket = static_cast<BracketExpression *>(expr);
+            const int mark = nextRegister;
+            const int obj = AllocRegister();
+            const int key = AllocRegister();
+            CompileExpression(bracket->Left.get(), obj);
+            CompileExpression(bracket->Member.get(), key);
+            Emit(OpCode::GET_INDEX, target, obj, key);
+            nextRegister = mark;
+            return;
+        }
+        case NodeKind::CALL: {
+            const auto *call = static_cast<CallExpression *>(expr);
+            const int mark = nextRegister;
+            if (call->Callee->Kind == NodeKind::DOT) {
+                const auto *dot = static_cast<DotExpression *>(call->Callee.get());
+                const int receiver = AllocRegister();
+                AllocRegister(); // 非内置方法时存放取出的函数
+                const int field = AddField(dot->Identifier->Name, &dot->Cache);
+                CompileExpression(dot->Left.get(), receiver);
+                Emit(OpCode::GET_METHOD, receiver, field);
+                for (const auto &argExpr: call->ArgumentList) {
+                    CompileExpression(argExpr.get(), AllocRegister());
+                }
+                Emit(OpCode::CALL_METHOD, receiver, static_cast<int32_t>(call->ArgumentList.size()), field);
+                Emit(OpCode::MOVE, target, receiver);
+                nextRegister = mark;
+                return;
+            }
+            const int callee = AllocRegister();
+            CompileExpression(call->Callee.get(), callee);
+            for (const auto &argExpr: call->ArgumentList) {
+                CompileExpression(argExpr.get(), AllocRegister());
+            }
+            Emit(OpCode::CALL, target, callee, static_cast<int32_t>(call->ArgumentList.size()));
+            nextRegister = mark;
+            return;
+        }
+        case NodeKind::FUNCTION_LITERAL: {
+            auto *funcLit = static_cast<FunctionLiteral *>(expr);
+            chunk.Functions.push_back(funcLit);
+            Emit(OpCode::CLOSURE, target, static_cast<int32_t>(chunk.Functions.size() - 1));
+            return;
+        }
+        default:
+            Emit(OpCode::LOAD_NULL, target);
+            return;
+    }
+}
+
+void Compiler::CompileUnary(const UnaryExpression *unary, const int target) {
+    const int mark = nextRegister;
+    if (unary->Op == OperatorKind::INC || unary->Op == OperatorKind::DEC) {
+        const OpCode step = unary->Op == OperatorKind::INC ? OpCode::INC : OpCode::DEC;
+        const int oldValue = AllocRegister();
+        const int newValue = AllocRegister();
+        Expression *operand = unary->Operand.get();
+        if (operand->Kind == NodeKind::IDENTIFIER) {
+            const auto *id = static_cast<Identifier *>(operand);
+            EmitLoad(id, oldValue);
+            Emit(step, newValue, oldValue);
+            EmitStore(id, newValue);
+        } else if (operand->Kind == NodeKind::DOT) {
+            const auto *dot = static_cast<DotExpression *>(operand);
+            const int obj = AllocRegister();
+            const int field = AddField(dot->Identifier->Name, &dot->Cache);
+            CompileExpression(dot->Left.get(), obj);
+            Emit(OpCode::GET_FIELD, oldValue, obj, field);
+            Emit(step, newValue, oldValue);
+            Emit(OpCode::SET_FIELD, obj, field, newValue);
+        } else if (operand->Kind == NodeKind::BRACKET) {
+            const auto *bracket = static_cast<BracketExpression *>(operand);
+            const int obj = AllocRegister();
+            const int key = AllocRegister();
+            CompileExpression(bracket->Left.get(), obj);
+            CompileExpression(bracket->Member.get(), key);
+            Emit(OpCode::GET_INDEX, oldValue, obj, key);
+            Emit(step, newValue, oldValue);
+            Emit(OpCode::SET_INDEX, obj, key, newValue);
+        } else {
+            EmitFail("非法的表达式Invalid L-Value for Prefix/Postfix operation");
+        }
+        Emit(OpCode::MOVE, target, unary->Postfix ? oldValue : newValue);
+        nextRegister = mark;
+        return;
+    }
+    const int operand = AllocRegister();
+    CompileExpression(unary->Operand.get(), operand);
+    switch (unary->Op) {
+        case OperatorKind::NOT:
+            Emit(OpCode::NOT, target, operand);
+            break;
+        case OperatorKind::SUB:
+            Emit(OpCode::NEG, target, operand);
+            break;
+        case OperatorKind::ADD:
+            Emit(OpCode::POS, target, operand);
+            break;
+        default:
+            EmitFail("Unknown Unary Operator: " + std::string(unary->Operator.TokenValue));
+    }
+    nextRegister = mark;
+}
+
+void Compiler::CompileAssign(const AssignExpression *assign, const int target) {
+    if (CompileConcat(assign, target)) {
+        return;
+    }
+    const bool compound = assign->Op != OperatorKind::NONE;
+    const OpCode code = compound ? BinaryOpCode(assign->Op) : OpCode::MOVE;
+    const int mark = nextRegister;
+    // 与 Evaluate 一致: 先计算右值, 再求左侧对象
+    const int rhs = AllocRegister();
+    const int newValue = AllocRegister();
+    CompileExpression(assign->Right.get(), rhs);
+    auto computeNewValue = [&](const int oldValue) {
+        if (!compound) {
+            Emit(OpCode::MOVE, newValue, rhs);
+        } else if (code == OpCode::FAIL) {
+            EmitFail("不支持的操作: " + std::string(assign->Operator.TokenValue));
+        } else {
+            Emit(code, newValue, oldValue, rhs);
+        }
+    };
+    Expression *left = assign->Left.get();
+    if (left->Kind == NodeKind::IDENTIFIER) {
+        const auto *id = static_cast<Identifier *>(left);
+        const int oldValue = AllocRegister();
+        if (compound) {
+            EmitLoad(id, oldValue);
+        }
+        computeNewValue(oldValue);
+        EmitStore(id, newValue);
+    } else if (left->Kind == NodeKind::DOT) {
+        const auto *dot = static_cast<DotExpression *>(left);
+        const int obj = AllocRegister();
+        const int oldValue = AllocRegister();
+        const int field = AddField(dot->Identifier->Name, &dot->Cache);
+        CompileExpression(dot->Left.get(), obj);
+        if (compound) {
+            Emit(OpCode::GET_FIELD, oldValue, obj, field);
+        }
+        computeNewValue(oldValue);
+        Emit(OpCode::SET_FIELD, obj, field, newValue);
+    } else if (left->Kind == NodeKind::BRACKET) {
+        const auto *bracket = static_cast<BracketExpression *>(left);
+        const int obj = AllocRegister();
+        const int key = AllocRegister();
+        const int oldValue = AllocRegister();
+        CompileExpression(bracket->Left.get(), obj);
+        CompileExpression(bracket->Member.get(), key);
+        if (compound) {
+            Emit(OpCode::GET_INDEX, oldValue, obj, key);
+        }
+        computeNewValue(oldValue);
+        Emit(OpCode::SET_INDEX, obj, key, newValue);
+    } else {
+        EmitFail("无效的赋值目标");
+    }
+    Emit(OpCode::MOVE, target, newValue);
+    nextRegister = mark;
+}
+
+bool Compiler::CompileConcat(const AssignExpression *assign, const int target) {
+    if (assign->Left->Kind != NodeKind::IDENTIFIER) {
+        return false;
+    }
+    const auto *id = static_cast<Identifier *>(assign->Left.get());
+    Expression *piece = nullptr;
+    if (assign->Op == OperatorKind::ADD) {
+        piece = assign->Right.get();
+    } else if (assign->Op == OperatorKind::NONE && assign->Right->Kind == NodeKind::BINARY) {
+        const auto *binary = static_cast<BinaryExpression *>(assign->Right.get());
+        if (binary->Op == OperatorKind::ADD && binary->Left->Kind == NodeKind::IDENTIFIER &&
+            Interpreter::SameVariable(id, static_cast<Identifier *>(binary->Left.get()))) {
+            piece = binary->Right.get();
+        }
+    }
+    if (!piece) {
+        return false;
+    }
+    const int mark = nextRegister;
+    const int pieceRegister = AllocRegister();
+    // 与 Evaluate 一致: s = s + x 先取 s 再求 x, s += x 先求 x 再取 s
+    if (assign->Op == OperatorKind::NONE) {
+        EmitLoad(id, target);
+        CompileExpression(piece, pieceRegister);
+    } else {
+        CompileExpression(piece, pieceRegister);
+        EmitLoad(id, target);
+    }
+    if (id->Slot >= 0) {
+        Emit(OpCode::CONCAT_LOCAL, target, AddLocal(id), pieceRegister);
+    } else {
+        Emit(OpCode::CONCAT_NAME, target, AddName(id->Name), pieceRegister);
+    }
+    nextRegister = mark;
+    return true;
+}
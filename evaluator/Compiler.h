@@ -0,0 +1,99 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    字节码编译器: 把 AST 降级为寄存器指令
+ */
+
+#ifndef BXSCRIPT_COMPILER_H
+#define BXSCRIPT_COMPILER_H
+
+#include <memory>
+#include <unordered_map>
+
+#include "Bytecode.h"
+#include "parser/Expression.h"
+
+class Compiler {
+public:
+    // 编译顶层语句, 函数提升与 import 仍由 EvaluateProgram 处理
+    static std::shared_ptr<BytecodeChunk> CompileProgram(const Program &program);
+
+    // 编译函数体, 结果缓存在 FunctionLiteral 上, 只编译一次
+    static const BytecodeChunk &CompileFunction(FunctionLiteral *func);
+
+private:
+    // 控制流上下文: 循环 或 会吞掉 break/continue/return 的 try/catch/finally 块
+    struct ControlContext {
+        bool IsLoop = false;
+        int ScopeDepth = 0;
+        std::vector<size_t> BreakJumps{};
+        std::vector<size_t> ContinueJumps{};
+    };
+
+    explicit Compiler(BytecodeChunk &chunk) : chunk(chunk) {
+    }
+
+    BytecodeChunk &chunk;
+    std::vector<ControlContext> controls{};
+    std::unordered_map<Atom, int> nameIndex{};
+    int scopeDepth = 0;
+    int nextRegister = 1;
+
+    void CompileStatement(Statement *stmt);
+
+    void CompileExpression(Expression *expr, int target);
+
+    void CompileBlock(const BlockStatement *block);
+
+    void CompileFor(const ForStatement *forStmt);
+
+    void CompileTry(const TryStatement *tryStmt);
+
+    void CompileSwallowed(Statement *stmt);
+
+    void CompileUnary(const UnaryExpression *unary, int target);
+
+    void CompileAssign(const AssignExpression *assign, int target);
+
+    // s = s + x 与 s += x 编译为 CONCAT_LOCAL/CONCAT_NAME, 结果写入 target; 不是这两种形式时返回 false
+    bool CompileConcat(const AssignExpression *assign, int target);
+
+    size_t Emit(OpCode op, int32_t a = 0, int32_t b = 0, int32_t c = 0);
+
+    void PatchJump(size_t at);
+
+    void EmitLeave(int targetDepth);
+
+    void EmitBranch(bool isBreak);
+
+    bool EmitEnterScope(const ScopeLayout &layout, bool elidable);
+
+    void EmitLoad(const Identifier *id, int target);
+
+    void EmitStore(const Identifier *id, int source);
+
+    void EmitFail(const std::string &message);
+
+    static OpCode BinaryOpCode(OperatorKind op);
+
+    int AllocRegister();
+
+    int AddConstant(ValuePtr value);
+
+    int AddName(const Atom &name);
+
+    int AddLocal(const Identifier *id);
+
+    int AddLocal(int32_t depth, int32_t slot, const Atom &name);
+
+    int AddField(const Atom &name, PropertyCache *cache);
+};
+
+#endif //BXSCRIPT_COMPILER_H
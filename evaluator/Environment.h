@@ -13,17 +13,48 @@
 
 #ifndef BXSCRIPT_ENVIRONMENT_H
 #define BXSCRIPT_ENVIRONMENT_H
+#include <algorithm>
+
+#include "TaggedValue.h"
 #include "Value.h"
 
-class Environment : public std::enable_shared_from_this<Environment> {
+class Environment : public std::enable_shared_from_this<Environment>, public GcNode {
 public:
     std::shared_ptr<Environment> parent;
-    std::unordered_map<std::string, ValuePtr> variables;
+    // 全局、REPL、模块顶层以及 this 按名字存放, 以驻留的名字为键, 查找只哈希指针
+    std::unordered_map<Atom, ValuePtr> variables;
+    // Resolver 解析过的局部变量按槽位存放, 数字与布尔不装箱, 未声明时为 Empty()
+    std::vector<TaggedValue> slots;
+    const std::vector<Atom> *slotNames = nullptr;
 
-    explicit Environment(std::shared_ptr<Environment> p = nullptr) : parent(std::move(p)) {
+    explicit Environment(std::shared_ptr<Environment> p = nullptr) : GcNode(Kind::ENVIRONMENT), parent(std::move(p)) {
     }
 
-    ValuePtr DeclareVar(const std::string &name, ValuePtr value) {
+    explicit Environment(std::shared_ptr<Environment> p, const std::vector<Atom> *layout)
+        : GcNode(Kind::ENVIRONMENT), parent(std::move(p)), slots(layout->size()), slotNames(layout) {
+    }
+
+    [[nodiscard]] long RefCount() const override { return weak_from_this().use_count(); }
+
+    void Trace(std::vector<GcNode *> &out) const override {
+        if (parent) out.push_back(parent.get());
+        for (const auto &[name, value]: variables) {
+            if (GcNode *node = Collector::Node(value)) out.push_back(node);
+        }
+        for (const auto &value: slots) {
+            if (GcNode *node = Collector::Node(value.Boxed())) out.push_back(node);
+        }
+    }
+
+    void Unlink() override {
+        variables.clear();
+        ClearSlots();
+        parent.reset();
+    }
+
+    [[nodiscard]] std::shared_ptr<void> Retain() override { return shared_from_this(); }
+
+    ValuePtr DeclareVar(const Atom &name, ValuePtr value) {
         if (variables.find(name) != variables.end()) {
             throw std::runtime_error("变量重复定义: " + name);
         }
@@ -31,9 +62,33 @@ public:
         return value;
     }
 
+    ValuePtr DeclareVar(const std::string &name, ValuePtr value) {
+        return DeclareVar(Atom::Intern(name), std::move(value));
+    }
+
     ValuePtr AssignVar(const std::string &name, ValuePtr value) {
-        if (variables.find(name) != variables.end()) {
-            variables[name] = value;
+        Atom atom;
+        if (!Atom::Find(name, atom)) {
+            throw std::runtime_error("变量未定义: " + name);
+        }
+        return AssignVar(atom, std::move(value));
+    }
+
+    ValuePtr LookupVar(const std::string &name) {
+        Atom atom;
+        if (!Atom::Find(name, atom)) {
+            throw std::runtime_error("变量未定义: " + name);
+        }
+        return LookupVar(atom);
+    }
+
+    ValuePtr AssignVar(const Atom &name, ValuePtr value) {
+        if (const auto it = variables.find(name); it != variables.end()) {
+            it->second = value;
+            return value;
+        }
+        if (const int slot = FindSlot(name); slot >= 0) {
+            slots[slot] = TaggedValue::FromValue(value);
             return value;
         }
         if (parent) {
@@ -42,15 +97,118 @@ public:
         throw std::runtime_error("变量未定义: " + name);
     }
 
-    ValuePtr LookupVar(const std::string &name) {
-        if (variables.find(name) != variables.end()) {
-            return variables[name];
+    ValuePtr LookupVar(const Atom &name) {
+        if (const auto it = variables.find(name); it != variables.end()) {
+            return it->second;
+        }
+        if (const int slot = FindSlot(name); slot >= 0) {
+            return slots[slot].ToValue();
         }
         if (parent) {
             return parent->LookupVar(name);
         }
         throw std::runtime_error("变量未定义: " + name);
     }
+
+    // 按槽位声明, 槽位已有值说明同一作用域重复声明
+    void DeclareSlot(const int slot, TaggedValue value) {
+        if (!slots[slot].Empty()) {
+            throw std::runtime_error("变量重复定义: " + (*slotNames)[slot]);
+        }
+        slots[slot] = std::move(value);
+    }
+
+    ValuePtr DeclareSlot(const int slot, ValuePtr value) {
+        DeclareSlot(slot, TaggedValue::FromValue(value));
+        return value;
+    }
+
+    // 循环复用环境时, 每轮开始前回到未声明状态
+    void ClearSlots() {
+        std::fill(slots.begin(), slots.end(), TaggedValue());
+    }
+
+    // 解析结果 (depth, slot) 对应的环境
+    Environment *Ancestor(int depth) {
+        Environment *env = this;
+        while (depth-- > 0) {
+            env = env->parent.get();
+        }
+        return env;
+    }
+
+    TaggedValue LookupSlotTagged(const int depth, const int slot, const Atom &name) {
+        Environment *env = Ancestor(depth);
+        if (const auto &value = env->slots[slot]; !value.Empty()) {
+            return value;
+        }
+        // 尚未执行到声明语句, 与按名字查找一致: 继续向外层找
+        if (env->parent) {
+            return TaggedValue::FromValue(env->parent->LookupVar(name));
+        }
+        throw std::runtime_error("变量未定义: " + name);
+    }
+
+    ValuePtr LookupSlot(const int depth, const int slot, const Atom &name) {
+        return LookupSlotTagged(depth, slot, name).ToValue();
+    }
+
+    void AssignSlot(const int depth, const int slot, const Atom &name, TaggedValue value) {
+        Environment *env = Ancestor(depth);
+        if (!env->slots[slot].Empty()) {
+            env->slots[slot] = std::move(value);
+            return;
+        }
+        if (env->parent) {
+            env->parent->AssignVar(name, value.ToValue());
+            return;
+        }
+        throw std::runtime_error("变量未定义: " + name);
+    }
+
+    ValuePtr AssignSlot(const int depth, const int slot, const Atom &name, ValuePtr value) {
+        AssignSlot(depth, slot, name, TaggedValue::FromValue(value));
+        return value;
+    }
+
+    // 未被解析为局部变量的名字只可能存放在 variables 中, 跳过纯槽位的环境
+    ValuePtr LookupName(const Atom &name) {
+        for (Environment *env = this; env; env = env->parent.get()) {
+            if (env->variables.empty()) {
+                continue;
+            }
+            if (const auto it = env->variables.find(name); it != env->variables.end()) {
+                return it->second;
+            }
+        }
+        throw std::runtime_error("变量未定义: " + name);
+    }
+
+    ValuePtr AssignName(const Atom &name, ValuePtr value) {
+        for (Environment *env = this; env; env = env->parent.get()) {
+            if (env->variables.empty()) {
+                continue;
+            }
+            if (const auto it = env->variables.find(name); it != env->variables.end()) {
+                it->second = value;
+                return value;
+            }
+        }
+        throw std::runtime_error("变量未定义: " + name);
+    }
+
+private:
+    int FindSlot(const Atom &name) const {
+        if (!slotNames) {
+            return -1;
+        }
+        for (size_t i = 0; i < slotNames->size(); ++i) {
+            if (!slots[i].Empty() && (*slotNames)[i] == name) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
 };
 
 
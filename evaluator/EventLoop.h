@@ -93,6 +93,9 @@ public:
                 }
             }
         }
+        // 任务之间栈上没有脚本的临时值, 适合回收引用环
+        localQueue.clear();
+        Collector::MaybeCollect();
         return false;
     }
 
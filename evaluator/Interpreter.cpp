@@ -13,12 +13,23 @@
 
 #include "Interpreter.h"
 #include "../stdlib/DateModule.h"
+#include <algorithm>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <thread>
+
+#include "Compiler.h"
+#include "VirtualMachine.h"
+#include "parser/ProgramCache.h"
 
 #include "stdlib/CryptModule.h"
+#include "stdlib/GcModule.h"
 #include "stdlib/GuiModule.h"
 #include "stdlib/IOModule.h"
 #include "stdlib/JsonModule.h"
+#include "stdlib/MathModule.h"
 #include "stdlib/NetModule.h"
 #include "stdlib/OsModule.h"
 #include "stdlib/RegexModule.h"
@@ -26,415 +37,637 @@
 
 std::unordered_map<std::string, ValuePtr> Interpreter::ModuleCache;
 std::unordered_map<std::string, std::shared_ptr<Program> > Interpreter::ModuleAST;
-std::vector<std::shared_ptr<Program> > Interpreter::ASTRegistry{};
 std::unordered_map<std::string, ValuePtr> Interpreter::CppStdCache{};
+std::unordered_map<std::string, Interpreter::ParsedModule> Interpreter::ParsedModules{};
+std::vector<std::string> Interpreter::LoadingModules{};
+bool Interpreter::UseBytecode = false;
+
+const std::unordered_map<std::string, ValuePtr (*)()> Interpreter::StdModules = {
+    {"IO", IOModule::CreateIOModule},
+    {"Net", NetModule::CreateNetModule},
+    {"JSON", JsonModule::CreateJsonModule},
+    {"Crypt", CryptModule::CreateCryptModule},
+    {"Date", DateModule::CreateDateModule},
+    {"Thread", ThreadModule::CreateThreadModule},
+    {"Regex", RegexModule::CreateRegexModule},
+    {"OS", OsModule::CreateOSModule},
+    {"Win", GuiModule::CreateGuiModule},
+    {"GC", GcModule::CreateGcModule},
+    {"Math", MathModule::CreateMathModule},
+};
+
+const std::vector<std::pair<Atom, std::shared_ptr<ObjectValue> > > &Interpreter::BuiltinSnapshot() {
+    static const auto snapshot = [] {
+        std::vector<std::pair<Atom, std::shared_ptr<ObjectValue> > > builtins;
+        const auto add = [&builtins](const char *name, const ValuePtr &value) {
+            builtins.emplace_back(Atom::Intern(name), std::static_pointer_cast<ObjectValue>(value));
+        };
+        add("String", StringValue::InitBuiltins());
+        add("Number", NumberValue::InitBuiltins());
+        add("Array", ArrayValue::InitBuiltins());
+        add("Function", FunctionValue::InitBuiltins());
+        add("Object", ObjectValue::InitBuiltins());
+        add("Boolean", BoolValue::InitBuiltins());
+        return builtins;
+    }();
+    return snapshot;
+}
 
 void Interpreter::SetupEnvironment(const std::shared_ptr<Environment> &env) {
-    env->DeclareVar("String", StringValue::InitBuiltins());
-    env->DeclareVar("Number", NumberValue::InitBuiltins());
-    env->DeclareVar("Array", ArrayValue::InitBuiltins());
-    env->DeclareVar("Function", FunctionValue::InitBuiltins());
-    env->DeclareVar("Object", ObjectValue::InitBuiltins());
-    env->DeclareVar("Boolean", BoolValue::InitBuiltins());
+    // 每个环境拿到快照的浅拷贝: 原生函数共享, 脚本给 String 等添加的属性不会带到下一次运行
+    for (const auto &[name, builtin]: BuiltinSnapshot()) {
+        env->DeclareVar(name, builtin->Clone());
+    }
 }
 
-ValuePtr Interpreter::CallFunction(const ValuePtr &callee, const std::vector<ValuePtr> &args) {
+ValuePtr Interpreter::CallFunction(const ValuePtr &callee, const std::vector<ValuePtr> &args, const ValuePtr &self) {
     if (callee->type == ValueType::NATIVE_FUNCTION) {
         const auto nativeFn = std::static_pointer_cast<NativeFunctionValue>(callee);
         return nativeFn->Function(args);
     }
     if (callee->type == ValueType::FUNCTION) {
         const auto fn = std::static_pointer_cast<FunctionValue>(callee);
-        const auto scope = std::make_shared<Environment>(fn->Closure);
+        const ValuePtr &thisValue = self ? self : fn->This;
+        if (UseBytecode) {
+            return VirtualMachine::Invoke(fn, args, thisValue);
+        }
+        const auto scope = std::make_shared<Environment>(fn->Closure, &fn->Declaration->Scope);
         for (size_t i = 0; i < fn->Declaration->Parameters->Parameters.size(); ++i) {
-            const auto paramId = dynamic_cast<Identifier *>(fn->Declaration->Parameters->Parameters[i].get());
-            std::string paramName = paramId->Name;
-            const ValuePtr argVal = (i < args.size()) ? args[i] : std::make_shared<NullValue>();
-            scope->DeclareVar(paramName, argVal);
+            const auto paramId = static_cast<Identifier *>(fn->Declaration->Parameters->Parameters[i].get());
+            const ValuePtr argVal = (i < args.size()) ? args[i] : NullValue::Instance();
+            scope->DeclareSlot(paramId->Slot, argVal);
+        }
+        if (thisValue && fn->Declaration->ThisSlot >= 0) {
+            scope->DeclareSlot(fn->Declaration->ThisSlot, thisValue);
         }
-        ValuePtr result = Execute(fn->Declaration->Body.get(), scope);
-        if (result->type == ValueType::RETURN) {
-            return std::static_pointer_cast<ReturnValue>(result)->Value;
+        Completion result = Execute(fn->Declaration->Body.get(), scope);
+        if (result.Type == CompletionType::BREAK || result.Type == CompletionType::CONTINUE) {
+            return NullValue::Instance();
         }
-        return result;
+        return result.Value.Empty() ? NullValue::Instance() : result.Value.ToValue();
     }
     throw std::runtime_error("试图调用非函数对象: " + callee->ToString());
 }
 
 ValuePtr Interpreter::EvaluateProgram(const Program &program, const std::shared_ptr<Environment> &env) {
-    for (const auto &importStmt: program.Imports) {
-        if (importStmt->Path.size() >= 2 && importStmt->Path[0] == "std") {
-            const std::string moduleName = importStmt->Path[1];
-            if (CppStdCache.find(moduleName) != CppStdCache.end()) {
-                env->DeclareVar(importStmt->AliasName, CppStdCache[moduleName]);
-                continue;
-            }
-            ValuePtr module = nullptr;
-            if (moduleName == "IO") module = IOModule::CreateIOModule();
-            else if (moduleName == "Net") module = NetModule::CreateNetModule();
-            else if (moduleName == "JSON") module = JsonModule::CreateJsonModule();
-            else if (moduleName == "Crypt") module = CryptModule::CreateCryptModule();
-            else if (moduleName == "Date") module = DateModule::CreateDateModule();
-            else if (moduleName == "Thread") module = ThreadModule::CreateThreadModule();
-            else if (moduleName == "Regex") module = RegexModule::CreateRegexModule();
-            else if (moduleName == "OS") module = OsModule::CreateOSModule();
-            else if (moduleName == "Win") module = GuiModule::CreateGuiModule();
-            if (module) {
-                CppStdCache[moduleName] = module;
+    // 入口程序先并行解析整张导入图, 被导入的模块执行时直接取用
+    const bool entry = LoadingModules.empty();
+    if (entry && !program.Imports.empty()) {
+        PrefetchModules(program);
+    }
+    try {
+        for (const auto &importStmt: program.Imports) {
+            if (IsStdModule(importStmt.get())) {
+                const std::string &moduleName = importStmt->Path[1];
+                ValuePtr &module = CppStdCache[moduleName];
+                if (!module) {
+                    module = StdModules.at(moduleName)();
+                }
                 env->DeclareVar(importStmt->AliasName, module);
                 continue;
             }
+            LoadModule(importStmt.get(), env);
+        }
+    } catch (...) {
+        if (entry) {
+            ParsedModules.clear();
         }
-        LoadModule(importStmt.get(), env);
+        throw;
+    }
+    if (entry) {
+        ParsedModules.clear();
     }
     // 函数提升
     for (const auto &stmt: program.Body) {
-        if (const auto *funcStmt = dynamic_cast<FunctionStatement *>(stmt.get())) {
-            FunctionLiteral *funcLit = funcStmt->Function.get();
+        if (stmt->Kind == NodeKind::FUNCTION_STATEMENT) {
+            FunctionLiteral *funcLit = static_cast<FunctionStatement *>(stmt.get())->Function.get();
             auto funcValue = std::make_shared<FunctionValue>(funcLit, env);
             env->DeclareVar(funcLit->Name->Name, funcValue);
         }
     }
     // 执行流程
-    ValuePtr lastEvaluated = std::make_shared<NullValue>();
+    if (UseBytecode) {
+        const auto chunk = Compiler::CompileProgram(program);
+        return VirtualMachine::Execute(*chunk, env);
+    }
+    ValuePtr lastEvaluated = NullValue::Instance();
     for (const auto &stmt: program.Body) {
-        lastEvaluated = Execute(stmt.get(), env);
+        lastEvaluated.reset();
+        Completion result = Execute(stmt.get(), env);
+        lastEvaluated = result.Value.Empty() ? NullValue::Instance() : result.Value.ToValue();
     }
     return lastEvaluated;
 }
 
-ValuePtr Interpreter::Execute(Statement *stmt, const std::shared_ptr<Environment>& env) {
-    // 空语句
-    if (dynamic_cast<EmptyStatement *>(stmt)) {
-        return std::make_shared<NullValue>();
-    }
-    // 变量处理
-    if (const auto *varStmt = dynamic_cast<VariableStatement *>(stmt)) {
-        for (const auto &decl: varStmt->List) {
-            if (dynamic_cast<VariableExpression *>(decl.get())) {
-                Evaluate(decl.get(), env);
+Completion Interpreter::Execute(Statement *stmt, const std::shared_ptr<Environment>& env) {
+    switch (stmt->Kind) {
+        // 空语句
+        case NodeKind::EMPTY_STATEMENT:
+            return {CompletionType::NORMAL, TaggedValue::FromValue(NullValue::Instance())};
+        // 变量处理
+        case NodeKind::VARIABLE_STATEMENT: {
+            const auto *varStmt = static_cast<VariableStatement *>(stmt);
+            for (const auto &decl: varStmt->List) {
+                if (decl->Kind == NodeKind::VARIABLE) {
+                    EvaluateTagged(decl.get(), env);
+                }
             }
+            return {CompletionType::NORMAL, TaggedValue::FromValue(NullValue::Instance())};
         }
-        return std::make_shared<NullValue>();
-    }
-    // If 语句 (控制流)
-    if (const auto *ifStmt = dynamic_cast<IfStatement *>(stmt)) {
-        const ValuePtr condition = Evaluate(ifStmt->Condition.get(), env);
-        if (IsTruthy(condition)) {
-            return Execute(ifStmt->Ok.get(), env);
-        }
-        if (ifStmt->Else) {
-            return Execute(ifStmt->Else.get(), env);
-        }
-        return std::make_shared<NullValue>();
-    }
-    // 代码块 { ... }
-    if (const auto *block = dynamic_cast<BlockStatement *>(stmt)) {
-        const auto blockEnv = std::make_shared<Environment>(env);
-        ValuePtr result = std::make_shared<NullValue>();
-        for (const auto &s: block->StatementList) {
-            result = Execute(s.get(), blockEnv);
-            if (result->type == ValueType::RETURN ||
-                result->type == ValueType::BREAK ||
-                result->type == ValueType::CONTINUE) {
-                return result;
+        // If 语句 (控制流)
+        case NodeKind::IF: {
+            const auto *ifStmt = static_cast<IfStatement *>(stmt);
+            if (IsTruthy(EvaluateTagged(ifStmt->Condition.get(), env))) {
+                return Execute(ifStmt->Ok.get(), env);
+            }
+            if (ifStmt->Else) {
+                return Execute(ifStmt->Else.get(), env);
             }
+            return {CompletionType::NORMAL, TaggedValue::FromValue(NullValue::Instance())};
         }
-        return result;
-    }
-    // 表达式语句 (a = 1; 或 func();)
-    if (const auto *exprStmt = dynamic_cast<ExpressionStatement *>(stmt)) {
-        return Evaluate(exprStmt->Expression.get(), env);
-    }
-    // For 循环 (for (let i=0; i<10; i++))
-    if (const auto *forStmt = dynamic_cast<ForStatement *>(stmt)) {
-        const auto loopEnv = std::make_shared<Environment>(env);
-        // 初始化
-        if (forStmt->Initializer) {
-            Evaluate(forStmt->Initializer.get(), loopEnv);
+        // 代码块 { ... }
+        case NodeKind::BLOCK: {
+            const auto *block = static_cast<BlockStatement *>(stmt);
+            // 没有声明的代码块直接使用外层环境
+            if (block->Scope.empty()) {
+                return ExecuteBlock(block, env);
+            }
+            return ExecuteBlock(block, std::make_shared<Environment>(env, &block->Scope));
         }
-        // 脚本循环
-        while (true) {
-            const auto iterationEnv = std::make_shared<Environment>(loopEnv);
-            // 检测条件
-            if (forStmt->Test) {
-                ValuePtr condition = Evaluate(forStmt->Test.get(), iterationEnv);
-                if (!IsTruthy(condition)) {
-                    break;
-                }
+        // 表达式语句 (a = 1; 或 func();)
+        case NodeKind::EXPRESSION_STATEMENT:
+            return {CompletionType::NORMAL, EvaluateTagged(static_cast<ExpressionStatement *>(stmt)->Expression.get(), env)};
+        // For 循环 (for (let i=0; i<10; i++))
+        case NodeKind::FOR: {
+            const auto *forStmt = static_cast<ForStatement *>(stmt);
+            // 作用域没有声明时不创建环境
+            const auto loopEnv = forStmt->LoopScope.empty()
+                                     ? env
+                                     : std::make_shared<Environment>(env, &forStmt->LoopScope);
+            // 初始化
+            if (forStmt->Initializer) {
+                EvaluateTagged(forStmt->Initializer.get(), loopEnv);
             }
-            // 执行循环体
-            ValuePtr bodyResult = Execute(forStmt->Body.get(), iterationEnv);
-            if (bodyResult->type == ValueType::BREAK) {
-                break;
+            // 循环体的环境没有被闭包持有时, 所有迭代共用一个, 每轮清空槽位
+            const BlockStatement *sharedBody = nullptr;
+            std::shared_ptr<Environment> sharedBodyEnv;
+            if (forStmt->IterationScope.empty() && forStmt->Body->Kind == NodeKind::BLOCK) {
+                const auto *body = static_cast<BlockStatement *>(forStmt->Body.get());
+                if (!body->Scope.empty() && !body->Captured) {
+                    sharedBody = body;
+                    sharedBodyEnv = std::make_shared<Environment>(loopEnv, &body->Scope);
+                }
             }
-            if (bodyResult->type == ValueType::CONTINUE) {
+            // 脚本循环
+            while (true) {
+                const auto iterationEnv = forStmt->IterationScope.empty()
+                                              ? loopEnv
+                                              : std::make_shared<Environment>(loopEnv, &forStmt->IterationScope);
+                // 检测条件
+                if (forStmt->Test) {
+                    if (!IsTruthy(EvaluateTagged(forStmt->Test.get(), iterationEnv))) {
+                        break;
+                    }
+                }
+                // 执行循环体
+                Completion bodyResult;
+                if (sharedBody) {
+                    sharedBodyEnv->ClearSlots();
+                    bodyResult = ExecuteBlock(sharedBody, sharedBodyEnv);
+                } else {
+                    bodyResult = Execute(forStmt->Body.get(), iterationEnv);
+                }
+                if (bodyResult.Type == CompletionType::BREAK) {
+                    break;
+                }
+                if (bodyResult.Type == CompletionType::RETURN) {
+                    return bodyResult;
+                }
+                // 执行更新
+                if (forStmt->Update) {
+                    EvaluateTagged(forStmt->Update.get(), iterationEnv);
+                }
+                Collector::MaybeCollect();
             }
-            if (bodyResult->type == ValueType::RETURN) {
-                return bodyResult;
+            return {CompletionType::NORMAL, TaggedValue::FromValue(NullValue::Instance())};
+        }
+        // throw
+        case NodeKind::THROW: {
+            ValuePtr error = Evaluate(static_cast<ThrowStatement *>(stmt)->Argument.get(), env);
+            throw BxScriptException(error);
+        }
+        // try - catch
+        case NodeKind::TRY: {
+            const auto *tryStmt = static_cast<TryStatement *>(stmt);
+            try {
+                Execute(tryStmt->Body.get(), env);
+            } catch (const BxScriptException &e) {
+                if (tryStmt->Catch) {
+                    auto catchEnv = std::make_shared<Environment>(env, &tryStmt->Catch->Scope);
+                    catchEnv->DeclareSlot(tryStmt->Catch->Parameter->Slot, e.ErrorValue);
+                    Execute(tryStmt->Catch->Body.get(), catchEnv);
+                }
             }
-            // 执行更新
-            if (forStmt->Update) {
-                Evaluate(forStmt->Update.get(), iterationEnv);
+            if (tryStmt->Finally) {
+                Execute(tryStmt->Finally.get(), env);
             }
+            return {CompletionType::NORMAL, TaggedValue::FromValue(NullValue::Instance())};
         }
-        return std::make_shared<NullValue>();
-    }
-    // throw
-    if (const auto *throwStmt = dynamic_cast<ThrowStatement *>(stmt)) {
-        ValuePtr error = Evaluate(throwStmt->Argument.get(), env);
-        throw BxScriptException(error);
-    }
-    // try - catch
-    if (const auto *tryStmt = dynamic_cast<TryStatement *>(stmt)) {
-        try {
-            Execute(tryStmt->Body.get(), env);
-        } catch (const BxScriptException &e) {
-            if (tryStmt->Catch) {
-                auto catchEnv = std::make_shared<Environment>(env);
-                catchEnv->DeclareVar(tryStmt->Catch->Parameter->Name, e.ErrorValue);
-                Execute(tryStmt->Catch->Body.get(), catchEnv);
+        // function不处理
+        case NodeKind::FUNCTION_STATEMENT:
+            return {CompletionType::NORMAL, TaggedValue::FromValue(NullValue::Instance())};
+        case NodeKind::RETURN: {
+            const auto *retStmt = static_cast<ReturnStatement *>(stmt);
+            if (retStmt->Argument) {
+                return {CompletionType::RETURN, EvaluateTagged(retStmt->Argument.get(), env)};
             }
+            return {CompletionType::RETURN, TaggedValue::FromValue(NullValue::Instance())};
         }
-        if (tryStmt->Finally) {
-            Execute(tryStmt->Finally.get(), env);
-        }
-        return std::make_shared<NullValue>();
+        case NodeKind::BREAK:
+            return {CompletionType::BREAK};
+        case NodeKind::CONTINUE:
+            return {CompletionType::CONTINUE};
+        default:
+            return {CompletionType::NORMAL, TaggedValue::FromValue(NullValue::Instance())};
     }
-    // function不处理
-    if (dynamic_cast<FunctionStatement *>(stmt)) {
-        return std::make_shared<NullValue>();
-    }
-    if (const auto *retStmt = dynamic_cast<ReturnStatement *>(stmt)) {
-        ValuePtr val;
-        if (retStmt->Argument) {
-            val = Evaluate(retStmt->Argument.get(), env);
-        } else {
-            val = std::make_shared<NullValue>();
+}
+
+Completion Interpreter::ExecuteBlock(const BlockStatement *block, const std::shared_ptr<Environment> &blockEnv) {
+    Completion result{CompletionType::NORMAL};
+    for (const auto &s: block->StatementList) {
+        // 先释放上一条语句的值, 不让它多占一份引用 (见 AppendInPlace)
+        result.Value = TaggedValue();
+        result = Execute(s.get(), blockEnv);
+        if (result.IsAbrupt()) {
+            return result;
         }
-        return std::make_shared<ReturnValue>(val);
-    }
-    if (dynamic_cast<BreakStatement *>(stmt)) {
-        return std::make_shared<BreakValue>();
-    }
-    if (dynamic_cast<ContinueStatement *>(stmt)) {
-        return std::make_shared<ContinueValue>();
     }
-    return std::make_shared<NullValue>();
+    return result;
 }
 
 ValuePtr Interpreter::Evaluate(Expression *expr, std::shared_ptr<Environment> env) {
     if (expr == nullptr) {
-        return std::make_shared<NullValue>();
-    }
-    // 序列表达式
-    if (const auto *seq = dynamic_cast<SequenceExpression *>(expr)) {
-        ValuePtr result = std::make_shared<NullValue>();
-        for (const auto &subExpr: seq->Sequence) {
-            // 递归求值序列中的每一项
-            result = Evaluate(subExpr.get(), env);
-        }
-        return result;
-    }
-    // 变量定义表达式 (let a=1)
-    if (const auto *varExpr = dynamic_cast<VariableExpression *>(expr)) {
-        ValuePtr value;
-        if (varExpr->Initializer) {
-            value = Evaluate(varExpr->Initializer.get(), env);
-        } else {
-            value = std::make_shared<NullValue>();
-        }
-        env->DeclareVar(varExpr->Name, value);
-        return value;
-    }
-    // 空值
-    if (dynamic_cast<NullLiteral *>(expr)) {
-        return std::make_shared<NullValue>();
-    }
-    // 布尔字面量
-    if (const auto *_bool = dynamic_cast<BooleanLiteral *>(expr)) {
-        return std::make_shared<BoolValue>(_bool->Value);
-    }
-    // 数字字面量
-    if (const auto *num = dynamic_cast<NumberLiteral *>(expr)) {
-        return std::make_shared<NumberValue>(std::stod(num->Literal));
-    }
-    // 字符串字面量
-    if (auto *str = dynamic_cast<StringLiteral *>(expr)) {
-        return std::make_shared<StringValue>(str->Literal);
-    }
-    // 标识符
-    if (const auto *id = dynamic_cast<Identifier *>(expr)) {
-        return env->LookupVar(id->Name);
-    }
-    // this
-    if (const auto *id = dynamic_cast<ThisExpression *>(expr)) {
-        return env->LookupVar("this");
-    }
-    // 对象 {A: 1, B: 2}
-    if (const auto *objLit = dynamic_cast<ObjectLiteral *>(expr)) {
-        auto obj = std::make_shared<ObjectValue>();
-        for (const auto &prop: objLit->Value) {
-            const ValuePtr val = Evaluate(prop->Value.get(), env);
-            obj->Set(prop->Key, val);
-        }
-        return obj;
-    }
-    // 数组字面量 [1, 2]
-    if (const auto *arrLit = dynamic_cast<ArrayLiteral *>(expr)) {
-        std::vector<ValuePtr> elements;
-        for (const auto &elemExpr: arrLit->Value) {
-            elements.push_back(Evaluate(elemExpr.get(), env));
-        }
-        return std::make_shared<ArrayValue>(elements);
-    }
-    // 二元运算 (1 + 1)
-    if (const auto *bin = dynamic_cast<BinaryExpression *>(expr)) {
-        std::string op = bin->Operator.TokenValue;
-        if (op == "&&") {
-            ValuePtr left = Evaluate(bin->Left.get(), env);
-            if (!IsTruthy(left)) return left;
-            return Evaluate(bin->Right.get(), env);
-        }
-        if (op == "||") {
-            ValuePtr left = Evaluate(bin->Left.get(), env);
-            if (IsTruthy(left)) return left;
-            return Evaluate(bin->Right.get(), env);
-        }
-        const auto left = Evaluate(bin->Left.get(), env);
-        const auto right = Evaluate(bin->Right.get(), env);
-        return ApplyBinary(bin->Operator, left, right);
-    }
-    // 一元运算 (!a, -a, i++, ++i) ---
-    if (const auto *unary = dynamic_cast<UnaryExpression *>(expr)) {
-        const std::string &op = unary->Operator.TokenValue;
-        // 自增/自减
-        if (op == "++" || op == "--") {
-            ValuePtr oldValue;
-            ValuePtr newValue;
-            auto calculate = [&](const ValuePtr &currentVal) {
-                if (currentVal->type != ValueType::NUMBER) {
-                    throw std::runtime_error("自增/自减只能作用于数字类型");
+        return NullValue::Instance();
+    }
+    switch (expr->Kind) {
+        // 序列表达式
+        case NodeKind::SEQUENCE: {
+            const auto *seq = static_cast<SequenceExpression *>(expr);
+            ValuePtr result = NullValue::Instance();
+            for (const auto &subExpr: seq->Sequence) {
+                // 递归求值序列中的每一项
+                result = Evaluate(subExpr.get(), env);
+            }
+            return result;
+        }
+        // 变量定义表达式 (let a=1)
+        case NodeKind::VARIABLE:
+            return EvaluateTagged(expr, env).ToValue();
+        // 空值
+        case NodeKind::NULL_LITERAL:
+            return NullValue::Instance();
+        // 布尔字面量
+        case NodeKind::BOOLEAN_LITERAL:
+            return BoolValue::Of(static_cast<BooleanLiteral *>(expr)->Value);
+        // 数字字面量
+        case NodeKind::NUMBER_LITERAL:
+            return static_cast<NumberLiteral *>(expr)->Constant;
+        // 字符串字面量
+        case NodeKind::STRING_LITERAL:
+            return static_cast<StringLiteral *>(expr)->Constant;
+        // 标识符
+        case NodeKind::IDENTIFIER:
+            return LookupIdentifier(static_cast<Identifier *>(expr), *env).ToValue();
+        // this
+        case NodeKind::THIS: {
+            static const Atom thisName = Atom::Intern("this");
+            const auto *self = static_cast<ThisExpression *>(expr);
+            if (self->Slot >= 0) {
+                return env->LookupSlot(self->Depth, self->Slot, thisName);
+            }
+            return env->LookupName(thisName);
+        }
+        // 对象 {A: 1, B: 2}
+        case NodeKind::OBJECT_LITERAL: {
+            const auto *objLit = static_cast<ObjectLiteral *>(expr);
+            auto obj = std::make_shared<ObjectValue>();
+            for (const auto &prop: objLit->Value) {
+                const ValuePtr val = Evaluate(prop->Value.get(), env);
+                obj->Set(prop->Key, val);
+            }
+            return obj;
+        }
+        // 数组字面量 [1, 2]
+        case NodeKind::ARRAY_LITERAL: {
+            const auto *arrLit = static_cast<ArrayLiteral *>(expr);
+            std::vector<ValuePtr> elements;
+            for (const auto &elemExpr: arrLit->Value) {
+                elements.push_back(Evaluate(elemExpr.get(), env));
+            }
+            return std::make_shared<ArrayValue>(elements);
+        }
+        // 二元运算 (1 + 1), 中间结果在 EvaluateTagged 中不装箱
+        case NodeKind::BINARY:
+            return EvaluateTagged(expr, env).ToValue();
+        // 一元运算 (!a, -a, i++, ++i) ---
+        case NodeKind::UNARY: {
+            const auto *unary = static_cast<UnaryExpression *>(expr);
+            // 自增/自减, 变量 (i++) 在 EvaluateTagged 中处理, 槽位里的数字不装箱
+            if (unary->Op == OperatorKind::INC || unary->Op == OperatorKind::DEC) {
+                if (unary->Operand->Kind == NodeKind::IDENTIFIER) {
+                    return EvaluateTagged(expr, env).ToValue();
+                }
+                ValuePtr oldValue;
+                ValuePtr newValue;
+                auto calculate = [&](const ValuePtr &currentVal) {
+                    if (currentVal->type != ValueType::NUMBER) {
+                        throw std::runtime_error("自增/自减只能作用于数字类型");
+                    }
+                    const double v = std::static_pointer_cast<NumberValue>(currentVal)->Value;
+                    const double change = unary->Op == OperatorKind::INC ? 1.0 : -1.0;
+                    // 保存旧值 (为了后缀操作 i++)
+                    oldValue = currentVal;
+                    newValue = NumberValue::Of(v + change); // 计算新值
+                };
+                Expression *operand = unary->Operand.get();
+                // 情况 A: 对象属性 (obj.x++)
+                if (operand->Kind == NodeKind::DOT) {
+                    const auto *dot = static_cast<DotExpression *>(operand);
+                    ValuePtr obj = Evaluate(dot->Left.get(), env);
+                    ValuePtr val = obj->GetCached(dot->Identifier->Name, dot->Cache);
+                    calculate(val);
+                    obj->SetCached(dot->Identifier->Name, newValue, dot->Cache); // 写回对象
+                }
+                // 情况 B: 数组/括号属性 (arr[0]++)
+                else if (operand->Kind == NodeKind::BRACKET) {
+                    const auto *bracket = static_cast<BracketExpression *>(operand);
+                    ValuePtr obj = Evaluate(bracket->Left.get(), env);
+                    ValuePtr key = Evaluate(bracket->Member.get(), env);
+                    ValuePtr val = obj->Get(key->ToString());
+                    calculate(val);
+                    obj->Set(key->ToString(), newValue); // 写回对象
+                } else {
+                    throw std::runtime_error("非法的表达式Invalid L-Value for Prefix/Postfix operation");
                 }
-                const double v = std::static_pointer_cast<NumberValue>(currentVal)->Value;
-                const double change = (op == "++") ? 1.0 : -1.0;
-                // 保存旧值 (为了后缀操作 i++)
-                oldValue = currentVal;
-                newValue = std::make_shared<NumberValue>(v + change); // 计算新值
+                // 如果是后缀 (i++)，返回旧值；如果是前缀 (++i)，返回新值
+                return unary->Postfix ? oldValue : newValue;
+            }
+            // 普通一元运算
+            return EvaluateTagged(expr, env).ToValue();
+        }
+        // 赋值操作 (Assignment)
+        case NodeKind::ASSIGN: {
+            const auto *assign = static_cast<AssignExpression *>(expr);
+            // 简单变量赋值 (a = 1, a += 1) 在 EvaluateTagged 中处理
+            if (assign->Left->Kind == NodeKind::IDENTIFIER) {
+                return EvaluateTagged(expr, env).ToValue();
+            }
+            // 计算右值
+            ValuePtr rhs = Evaluate(assign->Right.get(), env);
+            const OperatorKind op = assign->Op;
+            const bool compound = op != OperatorKind::NONE;
+            auto computeNewValue = [&](const ValuePtr &oldValue) -> ValuePtr {
+                if (!compound) return rhs;
+                return ApplyBinary(op, oldValue, rhs);
             };
-            // 情况 A: 变量 (i++)
-            if (const auto *id = dynamic_cast<Identifier *>(unary->Operand.get())) {
-                ValuePtr val = env->LookupVar(id->Name);
-                calculate(val);
-                env->AssignVar(id->Name, newValue); // 写回环境
-            }
-            // 情况 B: 对象属性 (obj.x++)
-            else if (const auto *dot = dynamic_cast<DotExpression *>(unary->Operand.get())) {
-                ValuePtr obj = Evaluate(dot->Left.get(), env);
-                ValuePtr val = obj->Get(dot->Identifier->Name);
-                calculate(val);
-                obj->Set(dot->Identifier->Name, newValue); // 写回对象
-            }
-            // 情况 C: 数组/括号属性 (arr[0]++)
-            else if (const auto *bracket = dynamic_cast<BracketExpression *>(unary->Operand.get())) {
-                ValuePtr obj = Evaluate(bracket->Left.get(), env);
-                ValuePtr key = Evaluate(bracket->Member.get(), env);
-                ValuePtr val = obj->Get(key->ToString());
-                calculate(val);
-                obj->Set(key->ToString(), newValue); // 写回对象
-            } else {
-                throw std::runtime_error("非法的表达式Invalid L-Value for Prefix/Postfix operation");
-            }
-            // 如果是后缀 (i++)，返回旧值；如果是前缀 (++i)，返回新值
-            return unary->Postfix ? oldValue : newValue;
-        }
-        // 普通一元运算
-        ValuePtr val = Evaluate(unary->Operand.get(), env);
-        if (op == "!") {
-            return std::make_shared<BoolValue>(!IsTruthy(val));
-        }
-        if (op == "-") {
-            if (val->type != ValueType::NUMBER) throw std::runtime_error("- 操作符只能用于数字");
-            double v = std::static_pointer_cast<NumberValue>(val)->Value;
-            return std::make_shared<NumberValue>(-v);
-        }
-        if (op == "+") {
-            if (val->type != ValueType::NUMBER) throw std::runtime_error("+ 操作符只能用于数字");
-            return val;
-        }
-        throw std::runtime_error("Unknown Unary Operator: " + op);
-    }
-    // 赋值操作 (Assignment)
-    if (const auto *assign = dynamic_cast<AssignExpression *>(expr)) {
-        // 计算右值
-        ValuePtr rhs = Evaluate(assign->Right.get(), env);
-        std::string op = assign->Operator.TokenValue;
-        auto computeNewValue = [&](const ValuePtr &oldValue) -> ValuePtr {
-            if (op == "=") return rhs;
-            const std::string binOpStr = op.substr(0, op.length() - 1);
-            const Token binOpToken(TokenKind(TokenKind::SYMBOL), binOpStr, 0, 0);
-            return ApplyBinary(binOpToken, oldValue, rhs);
-        };
-        // 简单变量赋值 (a = 1, a += 1)
-        if (const auto *id = dynamic_cast<Identifier *>(assign->Left.get())) {
-            ValuePtr oldValue;
-            if (op != "=") {
-                oldValue = env->LookupVar(id->Name);
+            Expression *target = assign->Left.get();
+            // 成员赋值 (obj.x = 1, obj.x += 1)
+            if (target->Kind == NodeKind::DOT) {
+                const auto *dot = static_cast<DotExpression *>(target);
+                const ValuePtr obj = Evaluate(dot->Left.get(), env);
+                ValuePtr oldValue;
+                if (compound) {
+                    oldValue = obj->GetCached(dot->Identifier->Name, dot->Cache);
+                }
+                ValuePtr newValue = computeNewValue(oldValue);
+                obj->SetCached(dot->Identifier->Name, newValue, dot->Cache);
+                return newValue;
             }
-            ValuePtr newValue = computeNewValue(oldValue);
-            return env->AssignVar(id->Name, newValue);
+            // 索引赋值 (arr[0] = 1, arr[0] += 1)
+            if (target->Kind == NodeKind::BRACKET) {
+                const auto *bracket = static_cast<BracketExpression *>(target);
+                const ValuePtr obj = Evaluate(bracket->Left.get(), env);
+                const ValuePtr keyVal = Evaluate(bracket->Member.get(), env);
+                size_t index;
+                if (obj->type == ValueType::ARRAY && keyVal->type == ValueType::NUMBER &&
+                    ArrayValue::ToIndex(static_cast<NumberValue *>(keyVal.get())->Value, index)) {
+                    auto *array = static_cast<ArrayValue *>(obj.get());
+                    ValuePtr oldValue;
+                    if (compound) {
+                        oldValue = array->At(index);
+                    }
+                    ValuePtr newValue = computeNewValue(oldValue);
+                    array->SetAt(index, newValue);
+                    return newValue;
+                }
+                std::string keyStr = keyVal->ToString();
+                ValuePtr oldValue;
+                if (compound) {
+                    oldValue = obj->Get(keyStr);
+                }
+                ValuePtr newValue = computeNewValue(oldValue);
+                obj->Set(keyStr, newValue);
+                return newValue;
+            }
+            throw std::runtime_error("无效的赋值目标");
         }
-        // 成员赋值 (obj.x = 1, obj.x += 1)
-        if (const auto *dot = dynamic_cast<DotExpression *>(assign->Left.get())) {
+        // 成员访问 (读取)
+        // 点号访问 (obj.x)
+        case NodeKind::DOT: {
+            const auto *dot = static_cast<DotExpression *>(expr);
             const ValuePtr obj = Evaluate(dot->Left.get(), env);
-            ValuePtr oldValue;
-            if (op != "=") {
-                oldValue = obj->Get(dot->Identifier->Name);
+            return obj->GetCached(dot->Identifier->Name, dot->Cache);
+        }
+        // 括号访问 (arr[0])
+        case NodeKind::BRACKET:
+            return EvaluateTagged(expr, env).ToValue();
+        // 函数调用
+        case NodeKind::CALL: {
+            const auto *call = static_cast<CallExpression *>(expr);
+            auto evaluateArgs = [&] {
+                std::vector<ValuePtr> args;
+                args.reserve(call->ArgumentList.size());
+                for (const auto &argExpr: call->ArgumentList) {
+                    args.push_back(Evaluate(argExpr.get(), env));
+                }
+                return args;
+            };
+            // recv.method(...): 内置方法直接以接收者调用, 不创建绑定的函数值
+            if (call->Callee->Kind == NodeKind::DOT) {
+                const auto *dot = static_cast<DotExpression *>(call->Callee.get());
+                const ValuePtr receiver = Evaluate(dot->Left.get(), env);
+                if (const NativeMethod *method = receiver->LookupMethod(dot->Identifier->Name, dot->Cache)) {
+                    return method->Call(*receiver, evaluateArgs());
+                }
+                bool bindThis = false;
+                const ValuePtr callee = receiver->GetMethod(dot->Identifier->Name, dot->Cache, bindThis);
+                return CallFunction(callee, evaluateArgs(), bindThis ? receiver : nullptr);
+            }
+            const ValuePtr callee = Evaluate(call->Callee.get(), env);
+            return CallFunction(callee, evaluateArgs());
+        }
+        case NodeKind::FUNCTION_LITERAL:
+            return std::make_shared<FunctionValue>(static_cast<FunctionLiteral *>(expr), env);
+        default:
+            return NullValue::Instance();
+    }
+}
+
+TaggedValue Interpreter::EvaluateTagged(Expression *expr, const std::shared_ptr<Environment> &env) {
+    switch (expr->Kind) {
+        case NodeKind::BOOLEAN_LITERAL:
+            return TaggedValue::FromBool(static_cast<BooleanLiteral *>(expr)->Value);
+        case NodeKind::NUMBER_LITERAL:
+            return TaggedValue::FromNumber(static_cast<NumberLiteral *>(expr)->Value);
+        case NodeKind::IDENTIFIER:
+            return LookupIdentifier(static_cast<Identifier *>(expr), *env);
+        case NodeKind::VARIABLE: {
+            const auto *varExpr = static_cast<VariableExpression *>(expr);
+            TaggedValue value = varExpr->Initializer
+                                    ? EvaluateTagged(varExpr->Initializer.get(), env)
+                                    : TaggedValue::FromValue(NullValue::Instance());
+            if (varExpr->Slot >= 0) {
+                env->DeclareSlot(varExpr->Slot, value);
+            } else {
+                env->DeclareVar(varExpr->Name, value.ToValue());
             }
-            ValuePtr newValue = computeNewValue(oldValue);
-            obj->Set(dot->Identifier->Name, newValue);
-            return newValue;
+            return value;
         }
-        // 索引赋值 (arr[0] = 1, arr[0] += 1)
-        if (const auto *bracket = dynamic_cast<BracketExpression *>(assign->Left.get())) {
+        case NodeKind::ASSIGN: {
+            const auto *assign = static_cast<AssignExpression *>(expr);
+            if (assign->Left->Kind != NodeKind::IDENTIFIER) {
+                break;
+            }
+            const auto *id = static_cast<Identifier *>(assign->Left.get());
+            // s = s + x: 先取 s 再求 x, 与普通求值顺序一致, 之后尝试原地追加
+            if (assign->Op == OperatorKind::NONE && assign->Right->Kind == NodeKind::BINARY) {
+                const auto *binary = static_cast<BinaryExpression *>(assign->Right.get());
+                if (binary->Op == OperatorKind::ADD && binary->Left->Kind == NodeKind::IDENTIFIER &&
+                    SameVariable(id, static_cast<Identifier *>(binary->Left.get()))) {
+                    TaggedValue current = LookupIdentifier(id, *env);
+                    const TaggedValue piece = EvaluateTagged(binary->Right.get(), env);
+                    // 求 x 时 s 可能被重新赋值, 此时 current 已不是变量的值, 不能原地追加
+                    const bool bound = current.Type() == ValueType::STRING &&
+                                       LookupIdentifier(id, *env).Boxed() == current.Boxed();
+                    if (bound && AppendInPlace(current, piece)) {
+                        return current;
+                    }
+                    TaggedValue joined = ApplyBinary(OperatorKind::ADD, current, piece);
+                    AssignIdentifier(id, *env, joined);
+                    return joined;
+                }
+            }
+            TaggedValue value = EvaluateTagged(assign->Right.get(), env);
+            if (assign->Op != OperatorKind::NONE) {
+                const TaggedValue oldValue = LookupIdentifier(id, *env);
+                if (assign->Op == OperatorKind::ADD && AppendInPlace(oldValue, value)) {
+                    return oldValue;
+                }
+                value = ApplyBinary(assign->Op, oldValue, value);
+            }
+            AssignIdentifier(id, *env, value);
+            return value;
+        }
+        case NodeKind::BINARY: {
+            const auto *bin = static_cast<BinaryExpression *>(expr);
+            if (bin->Op == OperatorKind::AND) {
+                TaggedValue left = EvaluateTagged(bin->Left.get(), env);
+                if (!IsTruthy(left)) return left;
+                return EvaluateTagged(bin->Right.get(), env);
+            }
+            if (bin->Op == OperatorKind::OR) {
+                TaggedValue left = EvaluateTagged(bin->Left.get(), env);
+                if (IsTruthy(left)) return left;
+                return EvaluateTagged(bin->Right.get(), env);
+            }
+            const auto left = EvaluateTagged(bin->Left.get(), env);
+            const auto right = EvaluateTagged(bin->Right.get(), env);
+            return ApplyBinary(bin->Op, left, right);
+        }
+        // 数组按数字下标读取不经过字符串键, 紧凑数组的元素也不装箱
+        case NodeKind::BRACKET: {
+            const auto *bracket = static_cast<BracketExpression *>(expr);
             const ValuePtr obj = Evaluate(bracket->Left.get(), env);
-            const ValuePtr keyVal = Evaluate(bracket->Member.get(), env);
-            std::string keyStr = keyVal->ToString();
-            ValuePtr oldValue;
-            if (op != "=") {
-                oldValue = obj->Get(keyStr);
-            }
-            ValuePtr newValue = computeNewValue(oldValue);
-            obj->Set(keyStr, newValue);
-            return newValue;
-        }
-        throw std::runtime_error("无效的赋值目标");
-    }
-    // 成员访问 (读取)
-    // 点号访问 (obj.x)
-    if (const auto *dot = dynamic_cast<DotExpression *>(expr)) {
-        const ValuePtr obj = Evaluate(dot->Left.get(), env);
-        return obj->Get(dot->Identifier->Name);
-    }
-    // 括号访问 (arr[0])
-    if (const auto *bracket = dynamic_cast<BracketExpression *>(expr)) {
-        const ValuePtr obj = Evaluate(bracket->Left.get(), env);
-        const ValuePtr key = Evaluate(bracket->Member.get(), env);
-        return obj->Get(key->ToString());
-    }
-    // 函数调用
-    if (const auto *call = dynamic_cast<CallExpression *>(expr)) {
-        ValuePtr callee = Evaluate(call->Callee.get(), env);
-        std::vector<ValuePtr> args;
-        for (const auto &argExpr: call->ArgumentList) {
-            args.push_back(Evaluate(argExpr.get(), env));
-        }
-        return CallFunction(callee, args);
-    }
-    if (auto *funcLit = dynamic_cast<FunctionLiteral *>(expr)) {
-        return std::make_shared<FunctionValue>(funcLit, env);
-    }
-    return std::make_shared<NullValue>();
+            const TaggedValue key = EvaluateTagged(bracket->Member.get(), env);
+            size_t index;
+            if (obj->type == ValueType::ARRAY && key.IsNumber() && ArrayValue::ToIndex(key.AsNumber(), index)) {
+                const auto *array = static_cast<ArrayValue *>(obj.get());
+                if (array->IsPacked() && index < array->Size()) {
+                    return TaggedValue::FromNumber(array->Numbers()[index]);
+                }
+                return TaggedValue::FromValue(array->At(index));
+            }
+            return TaggedValue::FromValue(obj->Get(key.ToValue()->ToString()));
+        }
+        case NodeKind::UNARY: {
+            const auto *unary = static_cast<UnaryExpression *>(expr);
+            if (unary->Op == OperatorKind::INC || unary->Op == OperatorKind::DEC) {
+                if (unary->Operand->Kind != NodeKind::IDENTIFIER) {
+                    break;
+                }
+                const auto *id = static_cast<Identifier *>(unary->Operand.get());
+                const TaggedValue oldValue = LookupIdentifier(id, *env);
+                if (!oldValue.IsNumber()) {
+                    throw std::runtime_error("自增/自减只能作用于数字类型");
+                }
+                const double change = unary->Op == OperatorKind::INC ? 1.0 : -1.0;
+                const TaggedValue newValue = TaggedValue::FromNumber(oldValue.AsNumber() + change);
+                AssignIdentifier(id, *env, newValue);
+                // 后缀 (i++) 返回旧值, 前缀 (++i) 返回新值
+                return unary->Postfix ? oldValue : newValue;
+            }
+            TaggedValue val = EvaluateTagged(unary->Operand.get(), env);
+            switch (unary->Op) {
+                case OperatorKind::NOT:
+                    return TaggedValue::FromBool(!IsTruthy(val));
+                case OperatorKind::SUB:
+                    if (!val.IsNumber()) throw std::runtime_error("- 操作符只能用于数字");
+                    return TaggedValue::FromNumber(-val.AsNumber());
+                case OperatorKind::ADD:
+                    if (!val.IsNumber()) throw std::runtime_error("+ 操作符只能用于数字");
+                    return val;
+                default:
+                    throw std::runtime_error("Unknown Unary Operator: " + std::string(unary->Operator.TokenValue));
+            }
+        }
+        default:
+            break;
+    }
+    return TaggedValue::FromValue(Evaluate(expr, env));
+}
+
+TaggedValue Interpreter::LookupIdentifier(const Identifier *id, Environment &env) {
+    if (id->Slot >= 0) {
+        return env.LookupSlotTagged(id->Depth, id->Slot, id->Name);
+    }
+    return TaggedValue::FromValue(env.LookupName(id->Name));
+}
+
+void Interpreter::AssignIdentifier(const Identifier *id, Environment &env, const TaggedValue &value) {
+    if (id->Slot >= 0) {
+        env.AssignSlot(id->Depth, id->Slot, id->Name, value);
+    } else {
+        env.AssignName(id->Name, value.ToValue());
+    }
+}
+
+bool Interpreter::SameVariable(const Identifier *a, const Identifier *b) {
+    return a->Slot == b->Slot && a->Depth == b->Depth && a->Name == b->Name;
+}
+
+bool Interpreter::AppendInPlace(const TaggedValue &current, const TaggedValue &piece) {
+    // 只有变量槽位与 current 两处持有时, 别处观察不到修改, 可以直接追加而不复制整个字符串
+    const ValuePtr &boxed = current.Boxed();
+    if (!boxed || boxed->type != ValueType::STRING || boxed.use_count() != 2) {
+        return false;
+    }
+    auto *str = static_cast<StringValue *>(boxed.get());
+    if (piece.Type() == ValueType::STRING) {
+        str->Append(static_cast<StringValue *>(piece.Boxed().get())->Value);
+    } else {
+        str->Append(piece.ToValue()->ToString());
+    }
+    return true;
 }
 
 bool Interpreter::IsTruthy(const ValuePtr &v) {
@@ -451,46 +684,185 @@ bool Interpreter::IsTruthy(const ValuePtr &v) {
         return !std::static_pointer_cast<StringValue>(v)->Value.empty();
     }
     if (v->type == ValueType::ARRAY) {
-        return !std::static_pointer_cast<ArrayValue>(v)->Elements.empty();
+        return !std::static_pointer_cast<ArrayValue>(v)->Empty();
     }
     if (v->type == ValueType::OBJECT) {
-        return !std::static_pointer_cast<ObjectValue>(v)->Properties.empty();
+        return !std::static_pointer_cast<ObjectValue>(v)->Empty();
     }
     return true;
 }
 
-ValuePtr Interpreter::ApplyBinary(const Token &op, const ValuePtr &left, const ValuePtr &right) {
-    const std::string &o = op.TokenValue;
+bool Interpreter::IsTruthy(const TaggedValue &v) {
+    switch (v.Type()) {
+        case ValueType::BOOL:
+            return v.AsBool();
+        case ValueType::NUMBER:
+            return v.AsNumber() != 0;
+        default:
+            return IsTruthy(v.ToValue());
+    }
+}
+
+bool Interpreter::ApplyNumeric(const OperatorKind op, const double l, const double r, TaggedValue &out) {
+    switch (op) {
+        // 运算
+        case OperatorKind::ADD:
+            out = TaggedValue::FromNumber(l + r);
+            return true;
+        case OperatorKind::SUB:
+            out = TaggedValue::FromNumber(l - r);
+            return true;
+        case OperatorKind::MUL:
+            out = TaggedValue::FromNumber(l * r);
+            return true;
+        case OperatorKind::DIV:
+            if (r == 0) throw std::runtime_error("除数不能为0");
+            out = TaggedValue::FromNumber(l / r);
+            return true;
+        case OperatorKind::MOD:
+            out = TaggedValue::FromNumber(fmod(l, r));
+            return true;
+        // 比较
+        case OperatorKind::LT:
+            out = TaggedValue::FromBool(l < r);
+            return true;
+        case OperatorKind::GT:
+            out = TaggedValue::FromBool(l > r);
+            return true;
+        case OperatorKind::LE:
+            out = TaggedValue::FromBool(l <= r);
+            return true;
+        case OperatorKind::GE:
+            out = TaggedValue::FromBool(l >= r);
+            return true;
+        case OperatorKind::EQ:
+            out = TaggedValue::FromBool(l == r);
+            return true;
+        case OperatorKind::NE:
+            out = TaggedValue::FromBool(l != r);
+            return true;
+        default:
+            return false;
+    }
+}
+
+TaggedValue Interpreter::ApplyBinary(const OperatorKind op, const TaggedValue &left, const TaggedValue &right) {
+    TaggedValue out;
+    if (left.IsNumber() && right.IsNumber() && ApplyNumeric(op, left.AsNumber(), right.AsNumber(), out)) {
+        return out;
+    }
+    return TaggedValue::FromValue(ApplyBinary(op, left.ToValue(), right.ToValue()));
+}
+
+ValuePtr Interpreter::ApplyBinary(const OperatorKind op, const ValuePtr &left, const ValuePtr &right) {
     // 运算
     if (left->type == ValueType::NUMBER && right->type == ValueType::NUMBER) {
-        const double l = std::static_pointer_cast<NumberValue>(left)->Value;
-        const double r = std::static_pointer_cast<NumberValue>(right)->Value;
-        if (o == "+") return std::make_shared<NumberValue>(l + r);
-        if (o == "-") return std::make_shared<NumberValue>(l - r);
-        if (o == "*") return std::make_shared<NumberValue>(l * r);
-        if (o == "/") {
-            if (r == 0) throw std::runtime_error("除数不能为0");
-            return std::make_shared<NumberValue>(l / r);
+        TaggedValue out;
+        if (ApplyNumeric(op, static_cast<NumberValue *>(left.get())->Value,
+                         static_cast<NumberValue *>(right.get())->Value, out)) {
+            return out.ToValue();
         }
-        if (o == "%") return std::make_shared<NumberValue>(fmod(l, r));
-        // 比较
-        if (o == "<") return std::make_shared<BoolValue>(l < r);
-        if (o == ">") return std::make_shared<BoolValue>(l > r);
-        if (o == "<=") return std::make_shared<BoolValue>(l <= r);
-        if (o == ">=") return std::make_shared<BoolValue>(l >= r);
-        if (o == "==") return std::make_shared<BoolValue>(l == r);
-        if (o == "!=") return std::make_shared<BoolValue>(l != r);
-    }
-    // 字符串拼接
-    if (o == "+") {
-        if (left->type == ValueType::STRING || right->type == ValueType::STRING) {
-            return std::make_shared<StringValue>(left->ToString() + right->ToString());
-        }
-    }
-    // 通用相等性检查
-    if (o == "==") return std::make_shared<BoolValue>(left->Equal(right));
-    if (o == "!=") return std::make_shared<BoolValue>(!left->Equal(right));
-    throw std::runtime_error("不支持的操作: " + left->ToString() + " " + o + " " + right->ToString());
+    }
+    switch (op) {
+        // 字符串拼接
+        case OperatorKind::ADD:
+            if (left->type == ValueType::STRING && right->type == ValueType::STRING) {
+                const std::string &l = static_cast<StringValue *>(left.get())->Value;
+                const std::string &r = static_cast<StringValue *>(right.get())->Value;
+                std::string joined;
+                joined.reserve(l.size() + r.size());
+                joined.append(l).append(r);
+                return std::make_shared<StringValue>(std::move(joined));
+            }
+            if (left->type == ValueType::STRING || right->type == ValueType::STRING) {
+                return std::make_shared<StringValue>(left->ToString() + right->ToString());
+            }
+            break;
+        // 通用相等性检查
+        case OperatorKind::EQ:
+            return BoolValue::Of(left->Equal(right));
+        case OperatorKind::NE:
+            return BoolValue::Of(!left->Equal(right));
+        default:
+            break;
+    }
+    throw std::runtime_error("不支持的操作: " + left->ToString() + " " + OperatorText(op) + " " + right->ToString());
+}
+
+bool Interpreter::IsStdModule(const ImportStatement *stmt) {
+    return stmt->Path.size() >= 2 && stmt->Path[0] == "std" && StdModules.find(stmt->Path[1]) != StdModules.end();
+}
+
+void Interpreter::PrefetchModules(const Program &program) {
+    std::mutex lock;
+    std::condition_variable changed;
+    std::deque<std::string> queue;
+    size_t parsing = 0;
+    std::vector<std::thread> workers;
+    const size_t threads = std::max(2u, std::thread::hardware_concurrency());
+    // 调用时持有 lock; 找不到文件的留到执行时按原流程报错
+    const auto discover = [&](const std::vector<NodePtr<ImportStatement> > &imports) {
+        for (const auto &stmt: imports) {
+            if (IsStdModule(stmt.get())) {
+                continue;
+            }
+            std::string filePath;
+            try {
+                filePath = ModuleHelper::ResolvePath(stmt->Path);
+            } catch (const std::exception &) {
+                continue;
+            }
+            if (ModuleCache.find(filePath) != ModuleCache.end()
+                || ParsedModules.find(filePath) != ParsedModules.end()) {
+                continue;
+            }
+            ParsedModules[filePath] = {};
+            queue.push_back(std::move(filePath));
+        }
+    };
+    std::function<void()> work = [&] {
+        std::unique_lock<std::mutex> guard(lock);
+        while (true) {
+            changed.wait(guard, [&] { return !queue.empty() || parsing == 0; });
+            if (queue.empty()) {
+                return;
+            }
+            const std::string filePath = std::move(queue.front());
+            queue.pop_front();
+            ++parsing;
+            guard.unlock();
+            ParsedModule parsed;
+            try {
+                parsed.Tree = std::make_shared<Program>(ProgramCache::ParseFile(filePath));
+            } catch (...) {
+                parsed.Error = std::current_exception();
+            }
+            guard.lock();
+            if (parsed.Tree) {
+                discover(parsed.Tree->Imports);
+            }
+            ParsedModules[filePath] = std::move(parsed);
+            // 待解析的文件多于线程时补充工作线程, 导入链是一条直线时不会多开
+            while (workers.size() + 1 < std::min(threads, queue.size() + parsing)) {
+                workers.emplace_back(work);
+            }
+            --parsing;
+            changed.notify_all();
+        }
+    };
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        discover(program.Imports);
+        while (workers.size() + 1 < std::min(threads, queue.size())) {
+            workers.emplace_back(work);
+        }
+    }
+    // 主线程也参与解析, 全部解析完成后不会再有新的工作线程
+    work();
+    for (auto &worker: workers) {
+        worker.join();
+    }
 }
 
 void Interpreter::LoadModule(const ImportStatement *stmt, std::shared_ptr<Environment> env) {
@@ -499,12 +871,35 @@ void Interpreter::LoadModule(const ImportStatement *stmt, std::shared_ptr<Enviro
         env->DeclareVar(stmt->AliasName, ModuleCache[filePath]);
         return;
     }
-    const std::string code = ModuleHelper::ReadFile(filePath);
-    Parser parser(code);
-    const auto programPtr = std::make_shared<Program>(parser.ParseProgram());
+    if (std::find(LoadingModules.begin(), LoadingModules.end(), filePath) != LoadingModules.end()) {
+        std::string chain;
+        for (auto it = std::find(LoadingModules.begin(), LoadingModules.end(), filePath);
+             it != LoadingModules.end(); ++it) {
+            chain += *it + " -> ";
+        }
+        throw std::runtime_error("模块循环导入: " + chain + filePath);
+    }
+    std::shared_ptr<Program> programPtr;
+    if (const auto it = ParsedModules.find(filePath); it != ParsedModules.end()) {
+        ParsedModule parsed = std::move(it->second);
+        ParsedModules.erase(it);
+        if (parsed.Error) {
+            std::rethrow_exception(parsed.Error);
+        }
+        programPtr = std::move(parsed.Tree);
+    } else {
+        programPtr = std::make_shared<Program>(ProgramCache::ParseFile(filePath));
+    }
     ModuleAST[filePath] = programPtr;
     const auto moduleEnv = std::make_shared<Environment>(env);
-    EvaluateProgram(*programPtr, moduleEnv);
+    LoadingModules.push_back(filePath);
+    try {
+        EvaluateProgram(*programPtr, moduleEnv);
+    } catch (...) {
+        LoadingModules.pop_back();
+        throw;
+    }
+    LoadingModules.pop_back();
     const auto moduleObj = std::make_shared<ObjectValue>();
     for (const auto &pair: moduleEnv->variables) {
         moduleObj->Set(pair.first, pair.second);
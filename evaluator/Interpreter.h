@@ -14,26 +14,45 @@
 #ifndef BXSCRIPT_INTERPRETER_H
 #define BXSCRIPT_INTERPRETER_H
 
+#include <exception>
 #include <utility>
 
 #include "Value.h"
+#include "TaggedValue.h"
 #include "parser/Expression.h"
 #include "Environment.h"
 #include "common/ModuleHelper.h"
 #include "parser/Parser.h"
 
+// 语句的执行结果: 正常结束 / return / break / continue, 按值返回不分配堆对象
+enum class CompletionType : uint8_t {
+    NORMAL, RETURN, BREAK, CONTINUE
+};
+
+struct Completion {
+    CompletionType Type = CompletionType::NORMAL;
+    // NORMAL 时为语句的值, RETURN 时为返回值, 数字与布尔不装箱
+    TaggedValue Value;
+
+    [[nodiscard]] bool IsAbrupt() const { return Type != CompletionType::NORMAL; }
+};
+
 class Interpreter {
 public:
     static std::unordered_map<std::string, ValuePtr> ModuleCache;
     static std::unordered_map<std::string, std::shared_ptr<Program> > ModuleAST;
-    static std::vector<std::shared_ptr<Program> > ASTRegistry;
+    // C++ 实现的标准库模块, 第一次导入时创建并放入 CppStdCache, 成员在首次访问时才创建
+    static const std::unordered_map<std::string, ValuePtr (*)()> StdModules;
     static std::unordered_map<std::string, ValuePtr> CppStdCache;
+    // 为 true 时使用字节码虚拟机执行, 否则使用语法树解释执行
+    static bool UseBytecode;
 
     // 环境预热
     static void SetupEnvironment(const std::shared_ptr<Environment>& env);
 
-    // 公用函数执行
-    static ValuePtr CallFunction(const ValuePtr &callee, const std::vector<ValuePtr> &args);
+    // 公用函数执行, self 非空时作为 this 传入 (方法调用), 否则使用函数值绑定的 This
+    static ValuePtr CallFunction(const ValuePtr &callee, const std::vector<ValuePtr> &args,
+                                 const ValuePtr &self = nullptr);
 
     // 运行代码
     static ValuePtr Run(const std::string &sourceCode, std::shared_ptr<Environment> globalEnv = nullptr) {
@@ -42,9 +61,8 @@ public:
         }
         SetupEnvironment(globalEnv);
         Parser parser(sourceCode);
-        auto const programPtr = std::make_shared<Program>(parser.ParseProgram());
-        ASTRegistry.push_back(programPtr);
-        auto res = EvaluateProgram(*programPtr, globalEnv);
+        const Program program = parser.ParseProgram();
+        auto res = EvaluateProgram(program, globalEnv);
         return std::move(res);
     }
 
@@ -52,17 +70,62 @@ public:
     static ValuePtr EvaluateProgram(const Program &program, const std::shared_ptr<Environment>& env);
 
 private:
+    friend class VirtualMachine;
+    friend class Compiler;
+
+    // 内置的 String/Number/Array/Function/Object/Boolean 对象, 进程内只构建一次
+    static const std::vector<std::pair<Atom, std::shared_ptr<ObjectValue> > > &BuiltinSnapshot();
+
     // Statement 执行层 (Execute): 负责逻辑控制、变量声明、代码块
-    static ValuePtr Execute(Statement *stmt, const std::shared_ptr<Environment>& env);
+    static Completion Execute(Statement *stmt, const std::shared_ptr<Environment>& env);
+
+    // 在给定环境中依次执行代码块的语句
+    static Completion ExecuteBlock(const BlockStatement *block, const std::shared_ptr<Environment> &blockEnv);
 
     // Expression 求值层 (Evaluate): 负责数据计算、赋值、成员访问
     static ValuePtr Evaluate(Expression *expr, std::shared_ptr<Environment> env);
 
+    // 不装箱的求值, 数字与布尔的中间结果不分配堆对象, 其余表达式交给 Evaluate
+    static TaggedValue EvaluateTagged(Expression *expr, const std::shared_ptr<Environment> &env);
+
+    // 按 Resolver 的结果读写变量, 未解析的按名字查找
+    static TaggedValue LookupIdentifier(const Identifier *id, Environment &env);
+
+    static void AssignIdentifier(const Identifier *id, Environment &env, const TaggedValue &value);
+
+    static bool SameVariable(const Identifier *a, const Identifier *b);
+
+    // s += x 与 s = s + x: current 是字符串且只被变量本身引用时原地追加, 循环拼接不再是平方复杂度
+    static bool AppendInPlace(const TaggedValue &current, const TaggedValue &piece);
+
     // 字面量转Bool
     static bool IsTruthy(const ValuePtr &v);
 
+    static bool IsTruthy(const TaggedValue &v);
+
     // 数学运算等
-    static ValuePtr ApplyBinary(const Token &op, const ValuePtr &left, const ValuePtr &right);
+    static ValuePtr ApplyBinary(OperatorKind op, const ValuePtr &left, const ValuePtr &right);
+
+    static TaggedValue ApplyBinary(OperatorKind op, const TaggedValue &left, const TaggedValue &right);
+
+    // 数字之间的算术与比较, op 不是数字运算符时返回 false
+    static bool ApplyNumeric(OperatorKind op, double l, double r, TaggedValue &out);
+
+    // 预先解析好的模块: 解析失败时保存异常, 执行到对应的 import 时再抛出
+    struct ParsedModule {
+        std::shared_ptr<Program> Tree{};
+        std::exception_ptr Error{};
+    };
+
+    static std::unordered_map<std::string, ParsedModule> ParsedModules;
+    // 正在执行的模块路径 (导入链), 用于发现循环导入
+    static std::vector<std::string> LoadingModules;
+
+    // import std.<名字> 且名字在 StdModules 中
+    static bool IsStdModule(const ImportStatement *stmt);
+
+    // 从入口程序出发找出全部依赖的模块文件, 在工作线程中并行读取并解析
+    static void PrefetchModules(const Program &program);
 
     // 模块加载
     static void LoadModule(const ImportStatement *stmt, std::shared_ptr<Environment> env);
@@ -0,0 +1,82 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    隐藏类的查找与转换
+ */
+
+#include "Shape.h"
+
+#include <algorithm>
+
+std::atomic<uint64_t> Shape::nextId{1};
+
+const std::shared_ptr<Shape> &Shape::Empty() {
+    static const std::shared_ptr<Shape> empty = std::make_shared<Shape>();
+    return empty;
+}
+
+int Shape::Find(const Atom &key) const {
+    if (keys.size() <= IndexThreshold) {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (keys[i] == key) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+    const auto it = index.find(key);
+    return it == index.end() ? -1 : it->second;
+}
+
+int Shape::Find(const std::string &key) const {
+    if (keys.empty()) {
+        return -1;
+    }
+    // 属性较少时直接比较内容, 省去查驻留表
+    if (keys.size() <= IndexThreshold) {
+        for (size_t i = 0; i < keys.size(); ++i) {
+            if (keys[i].Str() == key) {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+    Atom atom;
+    return Atom::Find(key, atom) ? Find(atom) : -1;
+}
+
+std::shared_ptr<Shape> Shape::Add(const Atom &key) {
+    std::lock_guard<std::mutex> lock(transitionLock);
+    auto &entry = transitions[key];
+    if (auto existing = entry.lock()) {
+        recent = existing;
+        return existing;
+    }
+    auto next = std::make_shared<Shape>();
+    next->keys = keys;
+    next->keys.push_back(key);
+    for (const Atom &k: next->keys) {
+        Atom::Retain(k);
+    }
+    if (next->keys.size() > IndexThreshold) {
+        for (size_t i = 0; i < next->keys.size(); ++i) {
+            next->index.emplace(next->keys[i], static_cast<int>(i));
+        }
+    }
+    entry = next;
+    recent = next;
+    if (transitions.size() >= sweepAt) {
+        for (auto it = transitions.begin(); it != transitions.end();) {
+            it = it->second.expired() ? transitions.erase(it) : std::next(it);
+        }
+        sweepAt = std::max(SweepThreshold, transitions.size() * 2);
+    }
+    return next;
+}
@@ -0,0 +1,89 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    隐藏类: 按相同顺序添加属性的对象共享同一个 Shape
+ */
+
+#ifndef BXSCRIPT_SHAPE_H
+#define BXSCRIPT_SHAPE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/Atom.h"
+
+// Shape 只记录属性名到槽位的映射, 属性值存放在对象自己的槽位数组中.
+// 从空 Shape 出发, 每添加一个属性沿转换树走到下一个 Shape, 创建后不再修改.
+// 转换树只弱引用子 Shape, 没有对象再使用的 Shape 随之释放, 不会因出现过的属性组合越积越多;
+// 每个 Shape 另外强引用最近一次转换的结果, 循环中反复创建又释放的同形对象仍得到同一个 Shape.
+class Shape {
+public:
+    Shape() : Id(nextId.fetch_add(1, std::memory_order_relaxed)) {
+    }
+
+    // 持有每个属性名的引用, 运行时产生的属性名在最后一个使用它的 Shape 释放后移出 Atom 表
+    ~Shape() {
+        for (const Atom &key: keys) {
+            Atom::Release(key);
+        }
+    }
+
+    Shape(const Shape &) = delete;
+
+    Shape &operator=(const Shape &) = delete;
+
+    // 全局唯一编号, 内联缓存以它识别 Shape (0 保留给空的缓存项); Shape 释放后会不断创建新的, 用 64 位不会回绕
+    const uint64_t Id;
+
+    // 超过该数量的对象转为字典模式, 避免为当作哈希表使用的对象生成过长的转换链
+    static constexpr size_t MaxProperties = 64;
+
+    // 所有对象的起点
+    static const std::shared_ptr<Shape> &Empty();
+
+    // 属性所在槽位, 不存在返回 -1; 属性名已驻留, 只比较指针
+    [[nodiscard]] int Find(const Atom &key) const;
+
+    // 任意字符串形式的属性名, 没有驻留过的名字必然不存在
+    [[nodiscard]] int Find(const std::string &key) const;
+
+    // 添加一个属性后的 Shape, 相同的转换返回同一个对象; 调用期间 key 须有效 (永久驻留或由调用方持有引用)
+    std::shared_ptr<Shape> Add(const Atom &key);
+
+    // 按槽位顺序 (即添加顺序) 排列的属性名
+    [[nodiscard]] const std::vector<Atom> &Keys() const { return keys; }
+
+    [[nodiscard]] size_t Size() const { return keys.size(); }
+
+private:
+    // 属性较少时线性查找比哈希更快, 较多时才建立索引
+    static constexpr size_t IndexThreshold = 8;
+    // 转换表达到该大小后才开始清理已释放的子 Shape
+    static constexpr size_t SweepThreshold = 16;
+
+    static std::atomic<uint64_t> nextId;
+
+    std::vector<Atom> keys{};
+    std::unordered_map<Atom, int> index{};
+    std::unordered_map<Atom, std::weak_ptr<Shape> > transitions{};
+    // 转换表增长到这个大小时清理一次失效项, 清理后按剩余项数加倍
+    size_t sweepAt = SweepThreshold;
+    // 最近一次转换的结果, 只保留一个, 被保留的 Shape 链最长为 MaxProperties
+    std::shared_ptr<Shape> recent{};
+    // 脚本可能在多个线程中创建对象, 转换表需要加锁
+    std::mutex transitionLock{};
+};
+
+#endif //BXSCRIPT_SHAPE_H
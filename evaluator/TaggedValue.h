@@ -0,0 +1,103 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    未装箱的运行时值: 数字与布尔直接存放, 只有堆对象才持有 ValuePtr
+ */
+
+#ifndef BXSCRIPT_TAGGEDVALUE_H
+#define BXSCRIPT_TAGGEDVALUE_H
+
+#include <cstdint>
+
+#include "Value.h"
+
+// 表达式求值的中间结果、虚拟机寄存器与局部变量槽位使用该类型,
+// 只有写入容器、按名字存放的变量、传参或返回时才通过 ToValue 装箱.
+class TaggedValue {
+public:
+    enum class Tag : uint8_t {
+        NUMBER, BOOL, BOXED
+    };
+
+    TaggedValue() = default;
+
+    static TaggedValue FromNumber(const double v) {
+        TaggedValue t;
+        t.tag = Tag::NUMBER;
+        t.number = v;
+        return t;
+    }
+
+    static TaggedValue FromBool(const bool v) {
+        TaggedValue t;
+        t.tag = Tag::BOOL;
+        t.number = v ? 1 : 0;
+        return t;
+    }
+
+    static TaggedValue FromValue(ValuePtr v) {
+        TaggedValue t;
+        t.boxed = std::move(v);
+        return t;
+    }
+
+    [[nodiscard]] ValueType Type() const {
+        switch (tag) {
+            case Tag::NUMBER:
+                return ValueType::NUMBER;
+            case Tag::BOOL:
+                return ValueType::BOOL;
+            default:
+                return boxed->type;
+        }
+    }
+
+    // 默认构造、尚未写入值
+    [[nodiscard]] bool Empty() const {
+        return tag == Tag::BOXED && !boxed;
+    }
+
+    [[nodiscard]] bool IsNumber() const {
+        return Type() == ValueType::NUMBER;
+    }
+
+    // 调用前需确认 IsNumber()
+    [[nodiscard]] double AsNumber() const {
+        return tag == Tag::NUMBER ? number : static_cast<NumberValue *>(boxed.get())->Value;
+    }
+
+    // 调用前需确认 Type() == ValueType::BOOL
+    [[nodiscard]] bool AsBool() const {
+        return tag == Tag::BOOL ? number != 0 : static_cast<BoolValue *>(boxed.get())->Value;
+    }
+
+    // 数字与布尔没有堆对象, 返回空指针; 供 GC 遍历
+    [[nodiscard]] const ValuePtr &Boxed() const {
+        return boxed;
+    }
+
+    [[nodiscard]] ValuePtr ToValue() const {
+        switch (tag) {
+            case Tag::NUMBER:
+                return NumberValue::Of(number);
+            case Tag::BOOL:
+                return BoolValue::Of(number != 0);
+            default:
+                return boxed;
+        }
+    }
+
+private:
+    Tag tag = Tag::BOXED;
+    double number = 0;
+    ValuePtr boxed{};
+};
+
+#endif //BXSCRIPT_TAGGEDVALUE_H
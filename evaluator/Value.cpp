@@ -24,13 +24,44 @@ std::shared_ptr<ObjectValue> BufferValue::Prototype = std::make_shared<ObjectVal
 
 ValuePtr RuntimeValue::Get(const std::string &key) {
     Logger::Error("类型错误,不能获取属性'" + key + "' 来自: " + this->ToString());
-    return std::make_shared<NullValue>();
+    return NullValue::Instance();
 }
 
 void RuntimeValue::Set(const std::string &key, ValuePtr value) {
     Logger::Error("类型错误,不能设置属性'" + key + "' 来自: " + this->ToString());
 }
 
+const NativeMethod *RuntimeValue::LookupMethod(const std::string &key, PropertyCache &cache) const {
+    const NativeMethod *method = cache.Method();
+    if (method && method->Receiver == type) {
+        return method;
+    }
+    method = FindMethod(key);
+    if (method) {
+        cache.RecordMethod(method);
+    }
+    return method;
+}
+
+ValuePtr RuntimeValue::BindMethod(const NativeMethod *method) {
+    // 接收者由 Bound 持有, 函数存活期间 self 一直有效
+    return std::make_shared<NativeFunctionValue>(
+        [self = this, method](const std::vector<ValuePtr> &args) -> ValuePtr {
+            return method->Call(*self, args);
+        }, shared_from_this());
+}
+
+ValuePtr RuntimeValue::BindThis(const ValuePtr &method) {
+    const auto fn = std::static_pointer_cast<FunctionValue>(method);
+    return std::make_shared<FunctionValue>(fn->Declaration, fn->Closure, shared_from_this());
+}
+
+ValuePtr RuntimeValue::PrototypeMember(ObjectValue &proto, const std::string &key, bool &bindThis) {
+    ValuePtr member = proto.Get(key);
+    bindThis = member->type == ValueType::FUNCTION;
+    return member;
+}
+
 bool RuntimeValue::Equal(ValuePtr v) {
     return false;
 }
\ No newline at end of file
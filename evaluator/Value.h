@@ -14,22 +14,35 @@
 #ifndef BXSCRIPT_VALUE_H
 #define BXSCRIPT_VALUE_H
 
+#include <atomic>
 #include <functional>
 #include <iomanip>
 #include <string>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
+#include "Collector.h"
+#include "Shape.h"
+#include "common/PropertyCache.h"
+
 class RuntimeValue;
 class ObjectValue;
 class FunctionLiteral;
 class Environment;
+class AstArena;
 
 using ValuePtr = std::shared_ptr<RuntimeValue>;
 
 enum class ValueType {
-    NULL_TYPE, NUMBER, STRING, BOOL, OBJECT, FUNCTION, NATIVE_FUNCTION, ARRAY, RETURN, BREAK, CONTINUE, BUFFER
+    NULL_TYPE, NUMBER, STRING, BOOL, OBJECT, FUNCTION, NATIVE_FUNCTION, ARRAY, BUFFER
+};
+
+// 内置方法 (arr.push, str.substr ...): 接收者作为参数显式传入, 方法表按类型静态建立, 查找时不分配
+struct NativeMethod {
+    ValueType Receiver;
+    ValuePtr (*Call)(RuntimeValue &self, const std::vector<ValuePtr> &args);
 };
 
 class BxScriptException : public std::exception {
@@ -58,7 +71,34 @@ public:
 
     virtual void Set(const std::string &key, ValuePtr value);
 
+    // 点号访问 (obj.name) 走这两个入口, 与 Get/Set 语义相同; 对象命中访问点的内联缓存时按槽位直接读写
+    virtual ValuePtr GetCached(const Atom &key, PropertyCache &) { return Get(key); }
+
+    virtual void SetCached(const Atom &key, ValuePtr value, PropertyCache &) { Set(key, std::move(value)); }
+
+    // 方法调用 (recv.key(...)) 取被调函数: 原型上的脚本函数不绑定, 置 bindThis 由调用方以 recv 作为 this 调用
+    virtual ValuePtr GetMethod(const Atom &key, PropertyCache &cache, bool &bindThis) {
+        bindThis = false;
+        return GetCached(key, cache);
+    }
+
+    // 该类型的内置方法, 没有返回 nullptr
+    [[nodiscard]] virtual const NativeMethod *FindMethod(const std::string &key) const { return nullptr; }
+
+    // 调用点使用的 FindMethod, 结果记在访问点的缓存中
+    const NativeMethod *LookupMethod(const std::string &key, PropertyCache &cache) const;
+
     virtual bool Equal(ValuePtr v);
+
+protected:
+    // 以属性形式读取内置方法时 (let f = arr.push), 才绑定成函数值
+    ValuePtr BindMethod(const NativeMethod *method);
+
+    // 以属性形式读取原型上的脚本函数时, 绑定当前值作为 this
+    ValuePtr BindThis(const ValuePtr &method);
+
+    // 原型上的成员, 脚本函数置 bindThis 而不绑定
+    static ValuePtr PrototypeMember(ObjectValue &proto, const std::string &key, bool &bindThis);
 };
 
 class BufferValue : public RuntimeValue {
@@ -84,15 +124,28 @@ public:
 // 原生函数
 using NativeFunctionType = std::function<ValuePtr(const std::vector<ValuePtr> &)>;
 
-class NativeFunctionValue : public RuntimeValue {
+class NativeFunctionValue : public RuntimeValue, public GcNode {
 public:
     NativeFunctionType Function;
+    // 绑定的接收者 (arr.push 作为值取出时), 由这里持有而不是捕获在 Function 中, 回收器才能看到这条引用
+    ValuePtr Bound;
 
-    explicit NativeFunctionValue(NativeFunctionType func)
-        : RuntimeValue(ValueType::NATIVE_FUNCTION), Function(std::move(func)) {
+    explicit NativeFunctionValue(NativeFunctionType func, ValuePtr bound = nullptr)
+        : RuntimeValue(ValueType::NATIVE_FUNCTION), GcNode(Kind::FUNCTION), Function(std::move(func)),
+          Bound(std::move(bound)) {
+        Collector::Track(this);
     }
 
     [[nodiscard]] std::string ToString() const override { return "[native code]"; }
+
+    [[nodiscard]] long RefCount() const override { return weak_from_this().use_count(); }
+
+    void Trace(std::vector<GcNode *> &out) const override;
+
+    // Function 捕获的引用无法列出, 回收时一并释放
+    void Unlink() override;
+
+    [[nodiscard]] std::shared_ptr<void> Retain() override { return shared_from_this(); }
 };
 
 class NullValue : public RuntimeValue {
@@ -100,6 +153,9 @@ public:
     explicit NullValue() : RuntimeValue(ValueType::NULL_TYPE) {
     }
 
+    // 全局唯一的 null, 不可变, 无需每次分配
+    static const ValuePtr &Instance();
+
     bool Equal(ValuePtr v) override;
 
     [[nodiscard]] std::string ToString() const override { return "null"; }
@@ -115,35 +171,79 @@ public:
     explicit NumberValue(double v) : RuntimeValue(ValueType::NUMBER), Value(v) {
     }
 
-    [[nodiscard]] std::string ToString() const override {
-        std::string s = std::to_string(Value);
+    // 小整数 [-128, 1023] 取预分配的缓存, 其余数字新建
+    static ValuePtr Of(double v);
+
+    // 数字转字符串, 去掉小数部分末尾的 0
+    static std::string Format(const double v) {
+        std::string s = std::to_string(v);
         s.erase(s.find_last_not_of('0') + 1, std::string::npos);
         if (s.back() == '.') s.pop_back();
         return s;
     }
 
+    [[nodiscard]] std::string ToString() const override { return Format(Value); }
+
     ValuePtr Get(const std::string &key) override;
 
+    ValuePtr GetMethod(const Atom &key, PropertyCache &cache, bool &bindThis) override;
+
+    [[nodiscard]] const NativeMethod *FindMethod(const std::string &key) const override;
+
     bool Equal(ValuePtr v) override;
+
+private:
+    ValuePtr Lookup(const std::string &key, bool &bindThis);
 };
 
 class StringValue : public RuntimeValue {
 public:
     std::string Value;
-    std::u32string U32Value;
     static std::shared_ptr<ObjectValue> Prototype;
 
     explicit StringValue(std::string v);
 
     explicit StringValue(char32_t v);
 
+    // 全部为 ASCII 时按字节下标访问, 不需要解码
+    [[nodiscard]] bool IsAscii() const { return ascii; }
+
+    // 码点个数
+    [[nodiscard]] size_t Length() const { return ascii ? Value.size() : U32().size(); }
+
+    // 第 index 个码点, 调用前需确认 index < Length()
+    [[nodiscard]] char32_t CodePointAt(const size_t index) const {
+        return ascii ? static_cast<unsigned char>(Value[index]) : U32()[index];
+    }
+
+    // 从第 start 个码点起 count 个码点组成的子串, 调用前需确认范围有效
+    [[nodiscard]] std::string Substr(size_t start, size_t count) const;
+
+    // UTF-32 形式, 只有非 ASCII 字符串按码点访问时才解码, 结果缓存
+    [[nodiscard]] const std::u32string &U32() const;
+
+    // 原地追加, 只能在确认没有其他持有者时调用 (字符串对脚本而言是不可变的)
+    void Append(const std::string &piece);
+
     static ValuePtr InitBuiltins();
 
     ValuePtr Get(const std::string &key) override;
 
+    ValuePtr GetMethod(const Atom &key, PropertyCache &cache, bool &bindThis) override;
+
+    [[nodiscard]] const NativeMethod *FindMethod(const std::string &key) const override;
+
     [[nodiscard]] std::string ToString() const override { return Value; }
 
     bool Equal(ValuePtr v) override;
+
+private:
+    bool ascii;
+    mutable std::u32string u32{};
+    // 字符串可能被多个线程共享, 解码只做一次
+    mutable std::once_flag decodeOnce{};
+
+    ValuePtr Lookup(const std::string &key, bool &bindThis);
 };
 
 class BoolValue : public RuntimeValue {
@@ -154,6 +254,9 @@ public:
     explicit BoolValue(const bool v) : RuntimeValue(ValueType::BOOL), Value(v) {
     }
 
+    // 全局唯一的 true / false
+    static const ValuePtr &Of(bool v);
+
     static ValuePtr InitBuiltins();
 
     bool Equal(ValuePtr v) override;
@@ -161,92 +264,244 @@ public:
     [[nodiscard]] std::string ToString() const override { return Value ? "true" : "false"; }
 };
 
-class ArrayValue : public RuntimeValue {
+class ArrayValue : public RuntimeValue, public GcNode {
 public:
-    std::vector<ValuePtr> Elements;
     static std::shared_ptr<ObjectValue> Prototype;
 
-    explicit ArrayValue(std::vector<ValuePtr> elements)
-        : RuntimeValue(ValueType::ARRAY), Elements(std::move(elements)) {
-    }
+    // 元素全部是数字 (包括空数组) 时以紧凑模式存放
+    explicit ArrayValue(std::vector<ValuePtr> elements);
 
-    static ValuePtr InitBuiltins();
+    explicit ArrayValue(std::vector<double> numbers)
+        : RuntimeValue(ValueType::ARRAY), GcNode(Kind::ARRAY), packed(true), numbers(std::move(numbers)) {
+    }
 
-    [[nodiscard]] std::string ToString() const override {
-        std::string str = "[";
-        for (size_t i = 0; i < Elements.size(); ++i) {
-            str += Elements[i]->ToString();
-            if (i < Elements.size() - 1) str += ", ";
+    // 数字下标: 非负整数才能直接按下标访问, 其余 (小数、负数) 仍按字符串键处理
+    static bool ToIndex(double key, size_t &index) {
+        if (!(key >= 0) || key >= 9007199254740992.0 || key != static_cast<double>(static_cast<size_t>(key))) {
+            return false;
         }
-        str += "]";
-        return str;
+        index = static_cast<size_t>(key);
+        return true;
     }
 
+    static ValuePtr InitBuiltins();
+
+    // 紧凑模式: 元素是连续的 double, 不为每个数字单独分配对象; 写入非数字后转为通用模式, 不再转回
+    [[nodiscard]] bool IsPacked() const { return packed; }
+
+    // 紧凑模式下的元素, 调用前需确认 IsPacked()
+    [[nodiscard]] const std::vector<double> &Numbers() const { return numbers; }
+
+    [[nodiscard]] size_t Size() const { return packed ? numbers.size() : elements.size(); }
+
+    [[nodiscard]] bool Empty() const { return Size() == 0; }
+
+    // 越界返回 null
+    [[nodiscard]] ValuePtr At(size_t index) const;
+
+    // 越界写入时中间用 null 填充
+    void SetAt(size_t index, ValuePtr value);
+
+    void SetNumberAt(size_t index, double value);
+
+    void Push(ValuePtr value);
+
+    // 通用模式的元素, 紧凑模式会先转换; 供需要直接修改元素的原生模块使用
+    std::vector<ValuePtr> &Boxed();
+
+    [[nodiscard]] std::string ToString() const override;
+
     ValuePtr Get(const std::string &key) override;
 
+    ValuePtr GetMethod(const Atom &key, PropertyCache &cache, bool &bindThis) override;
+
+    [[nodiscard]] const NativeMethod *FindMethod(const std::string &key) const override;
+
     void Set(const std::string &key, ValuePtr value) override;
 
     bool Equal(ValuePtr v) override;
+
+    // 紧凑数组不持有引用, 转为通用模式时才登记到回收器
+    [[nodiscard]] long RefCount() const override { return weak_from_this().use_count(); }
+
+    void Trace(std::vector<GcNode *> &out) const override;
+
+    void Unlink() override;
+
+    [[nodiscard]] std::shared_ptr<void> Retain() override { return shared_from_this(); }
+
+    // 以下供内置方法使用, 调用前需确认范围有效
+    void Truncate(size_t size);
+
+    void Erase(size_t index, size_t count);
+
+    void Insert(size_t index, const std::vector<ValuePtr> &items);
+
+    // [begin, end) 的元素
+    [[nodiscard]] std::vector<ValuePtr> Slice(size_t begin, size_t end) const;
+
+    // [begin, end) 组成的新数组, 保持紧凑模式
+    [[nodiscard]] ValuePtr SliceArray(size_t begin, size_t end) const;
+
+private:
+    bool packed;
+    std::vector<double> numbers{};
+    std::vector<ValuePtr> elements{};
+
+    ValuePtr Lookup(const std::string &key, bool &bindThis);
 };
 
-class ObjectValue final : public RuntimeValue {
+class ObjectValue final : public RuntimeValue, public GcNode {
 public:
-    std::unordered_map<std::string, ValuePtr> Properties;
     static std::shared_ptr<ObjectValue> Prototype;
 
-    explicit ObjectValue() : RuntimeValue(ValueType::OBJECT) {
+    explicit ObjectValue() : RuntimeValue(ValueType::OBJECT), GcNode(Kind::OBJECT), shape(Shape::Empty()) {
+        Collector::Track(this);
+    }
+
+    // 自身属性, 不存在返回 nullptr (不查找原型)
+    [[nodiscard]] ValuePtr Find(const std::string &key) const;
+
+    // 删除属性后转为字典模式
+    bool Remove(const std::string &key);
+
+    [[nodiscard]] size_t Size() const { return dictionary ? dictionary->size() : slots.size(); }
+
+    [[nodiscard]] bool Empty() const { return Size() == 0; }
+
+    // 按添加顺序遍历自身属性 (字典模式下顺序不定), fn(const std::string &key, const ValuePtr &value)
+    template<typename Fn>
+    void ForEach(Fn &&fn) const {
+        if (dictionary) {
+            for (const auto &[key, value]: *dictionary) {
+                fn(key, value);
+            }
+            return;
+        }
+        const auto &keys = shape->Keys();
+        for (size_t i = 0; i < keys.size(); ++i) {
+            fn(keys[i], slots[i]);
+        }
     }
 
+    // 当前的 Shape, 字典模式下为 nullptr
+    [[nodiscard]] const Shape *CurrentShape() const { return dictionary ? nullptr : shape.get(); }
+
+        // 浅拷贝: 共享 Shape 与属性值, 之后各自修改互不影响
+    [[nodiscard]] std::shared_ptr<ObjectValue> Clone() const;
+
+    // 标准库模块的成员: 第一次访问时由 Init 在模块上创建
+    struct LazyMember {
+        const char *Name;
+
+        void (*Init)(std::shared_ptr<ObjectValue> &);
+    };
+
+    // 成员按需创建的模块对象, members 须长期有效 (函数内的静态表)
+    static std::shared_ptr<ObjectValue> Lazy(const std::vector<LazyMember> &members);
+
+    // 创建全部尚未创建的成员, 枚举或比较属性前调用
+    void MaterializeAll();
+
     static ValuePtr InitBuiltins();
 
     [[nodiscard]] std::string ToString() const override { return "[object Object]"; }
 
     ValuePtr Get(const std::string &key) override;
 
+    // 运行时产生的属性名按引用计数驻留, 不会永久留在 Atom 表中
     void Set(const std::string &key, ValuePtr value) override;
 
-    bool Equal(ValuePtr v) override;
-};
+    // 已驻留的属性名 (对象字面量、模块导出的变量名), 直接沿 Shape 转换
+    void Set(const Atom &key, ValuePtr value);
 
-class ReturnValue : public RuntimeValue {
-public:
-    ValuePtr Value;
+    ValuePtr GetCached(const Atom &key, PropertyCache &cache) override;
 
-    explicit ReturnValue(ValuePtr v) : RuntimeValue(ValueType::RETURN), Value(std::move(v)) {
-    }
+    void SetCached(const Atom &key, ValuePtr value, PropertyCache &cache) override;
 
-    [[nodiscard]] std::string ToString() const override { return Value->ToString(); }
-};
+    ValuePtr GetMethod(const Atom &key, PropertyCache &cache, bool &bindThis) override;
 
-class BreakValue : public RuntimeValue {
-public:
-    explicit BreakValue() : RuntimeValue(ValueType::BREAK) {
-    }
+    bool Equal(ValuePtr v) override;
 
-    [[nodiscard]] std::string ToString() const override { return "break"; }
-};
+    [[nodiscard]] long RefCount() const override { return weak_from_this().use_count(); }
+
+    void Trace(std::vector<GcNode *> &out) const override;
+
+    void Unlink() override;
+
+    [[nodiscard]] std::shared_ptr<void> Retain() override { return shared_from_this(); }
+
+private:
+    // 共享的隐藏类, 字典模式下不再使用
+    std::shared_ptr<Shape> shape;
+    // 与 shape->Keys() 一一对应的属性值
+    std::vector<ValuePtr> slots{};
+    // 删除过属性或属性过多时改用哈希表
+    std::unique_ptr<std::unordered_map<std::string, ValuePtr> > dictionary{};
+
+    struct LazyState {
+        const std::vector<LazyMember> *Members;
+        // 已创建, 或已被脚本赋值、删除, 不再按需创建
+        std::vector<bool> Done;
+        // 尚未处理的成员数
+        size_t Pending = 0;
+        // 全部成员处理完毕后置位, 之后读写不再加锁
+        std::atomic<bool> Complete{false};
+        // 模块在多个线程间共享, 同一个成员只创建一次; 创建时可能读取模块的其他成员
+        std::recursive_mutex Lock{};
+
+        // 持有 Lock 时调用: 成员 i 处理完毕
+        void Finish(const size_t i) {
+            Done[i] = true;
+            if (--Pending == 0) {
+                Complete.store(true, std::memory_order_release);
+            }
+        }
+    };
 
-class ContinueValue : public RuntimeValue {
-public:
-    explicit ContinueValue() : RuntimeValue(ValueType::CONTINUE) {
+    std::unique_ptr<LazyState> lazy{};
+
+    // 成员未全部创建前, 创建会改变 Shape 与槽位, 其他线程的读写都要与之互斥
+    [[nodiscard]] std::unique_lock<std::recursive_mutex> LockLazy() const {
+        if (lazy && !lazy->Complete.load(std::memory_order_acquire)) {
+            return std::unique_lock<std::recursive_mutex>(lazy->Lock);
+        }
+        return {};
     }
 
-    [[nodiscard]] std::string ToString() const override { return "continue"; }
+    // 按需创建名为 key 的成员, 不是待创建的成员时返回 nullptr
+    ValuePtr Materialize(const std::string &key);
+
+    void ToDictionary();
+
+    // 新增属性: 切换到下一个 Shape, 属性过多时转为字典模式
+    void AddProperty(const Atom &key, ValuePtr value);
 };
 
-class FunctionValue : public RuntimeValue {
+class FunctionValue : public RuntimeValue, public GcNode {
 public:
     FunctionLiteral *Declaration;
     std::shared_ptr<Environment> Closure;
+    // 经原型取出的方法所绑定的 this, 调用时声明在函数作用域中
+    ValuePtr This;
+    // 声明所在的语法树, 函数值存活期间不能释放
+    std::shared_ptr<AstArena> Source;
     static std::shared_ptr<ObjectValue> Prototype;
 
     static ValuePtr InitBuiltins();
 
-    explicit FunctionValue(FunctionLiteral *decl, std::shared_ptr<Environment> closure)
-        : RuntimeValue(ValueType::FUNCTION), Declaration(decl), Closure(std::move(closure)) {
-    }
+    // 捕获的环境从此可能出现在引用环上, 连同外层环境一起登记到回收器
+    explicit FunctionValue(FunctionLiteral *decl, std::shared_ptr<Environment> closure, ValuePtr self = nullptr);
 
     [[nodiscard]] std::string ToString() const override { return "[function]"; }
+
+    [[nodiscard]] long RefCount() const override { return weak_from_this().use_count(); }
+
+    void Trace(std::vector<GcNode *> &out) const override;
+
+    void Unlink() override;
+
+    [[nodiscard]] std::shared_ptr<void> Retain() override { return shared_from_this(); }
 };
 
 #endif //BXSCRIPT_VALUE_H
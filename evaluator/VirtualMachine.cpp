@@ -0,0 +1,295 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    寄存器虚拟机, switch 分发
+ */
+
+#include "VirtualMachine.h"
+
+#include "Compiler.h"
+#include "Interpreter.h"
+
+namespace {
+    // 异常处理记录, 由 TRY_BEGIN 压入
+    struct Handler {
+        size_t Target;
+        int Register;
+        std::shared_ptr<Environment> Env;
+    };
+
+    OperatorKind BinaryOperator(const OpCode op) {
+        static const OperatorKind operators[] = {
+            OperatorKind::ADD, OperatorKind::SUB, OperatorKind::MUL, OperatorKind::DIV, OperatorKind::MOD,
+            OperatorKind::LT, OperatorKind::GT, OperatorKind::LE, OperatorKind::GE, OperatorKind::EQ, OperatorKind::NE,
+        };
+        return operators[static_cast<int>(op) - static_cast<int>(OpCode::ADD)];
+    }
+
+    TaggedValue Step(const TaggedValue &current, const double change) {
+        if (!current.IsNumber()) {
+            throw std::runtime_error("自增/自减只能作用于数字类型");
+        }
+        return TaggedValue::FromNumber(current.AsNumber() + change);
+    }
+
+    std::vector<ValuePtr> BoxRange(const std::vector<TaggedValue> &R, const int from, const int count) {
+        std::vector<ValuePtr> values;
+        values.reserve(count);
+        for (int i = from; i < from + count; ++i) {
+            values.push_back(R[i].ToValue());
+        }
+        return values;
+    }
+}
+
+ValuePtr VirtualMachine::Invoke(const std::shared_ptr<FunctionValue> &fn, const std::vector<ValuePtr> &args,
+                                const ValuePtr &self) {
+    const auto scope = std::make_shared<Environment>(fn->Closure, &fn->Declaration->Scope);
+    for (size_t i = 0; i < fn->Declaration->Parameters->Parameters.size(); ++i) {
+        const auto paramId = static_cast<Identifier *>(fn->Declaration->Parameters->Parameters[i].get());
+        const ValuePtr argVal = (i < args.size()) ? args[i] : NullValue::Instance();
+        scope->DeclareSlot(paramId->Slot, argVal);
+    }
+    if (self && fn->Declaration->ThisSlot >= 0) {
+        scope->DeclareSlot(fn->Declaration->ThisSlot, self);
+    }
+    return Execute(Compiler::CompileFunction(fn->Declaration), scope);
+}
+
+ValuePtr VirtualMachine::Execute(const BytecodeChunk &chunk, std::shared_ptr<Environment> env) {
+    // 寄存器不装箱, 只有写入变量/对象/参数或返回时才分配
+    std::vector<TaggedValue> R(chunk.RegisterCount);
+    std::vector<Handler> handlers{};
+    const Instruction *code = chunk.Code.data();
+    size_t pc = 0;
+    while (true) {
+        try {
+            while (true) {
+                const Instruction &ins = code[pc++];
+                switch (ins.Op) {
+                    case OpCode::LOAD_CONST:
+                        R[ins.A] = TaggedValue::FromValue(chunk.Constants[ins.B]);
+                        break;
+                    case OpCode::LOAD_NULL:
+                        R[ins.A] = TaggedValue::FromValue(NullValue::Instance());
+                        break;
+                    case OpCode::MOVE:
+                        R[ins.A] = R[ins.B];
+                        break;
+                    case OpCode::LOAD_NAME:
+                        R[ins.A] = TaggedValue::FromValue(env->LookupName(chunk.Names[ins.B]));
+                        break;
+                    case OpCode::STORE_NAME:
+                        env->AssignName(chunk.Names[ins.B], R[ins.A].ToValue());
+                        break;
+                    case OpCode::DECLARE_NAME:
+                        env->DeclareVar(chunk.Names[ins.B], R[ins.A].ToValue());
+                        break;
+                    case OpCode::LOAD_LOCAL: {
+                        const auto &local = chunk.Locals[ins.B];
+                        R[ins.A] = env->LookupSlotTagged(local.Depth, local.Slot, chunk.Names[local.Name]);
+                        break;
+                    }
+                    case OpCode::STORE_LOCAL: {
+                        const auto &local = chunk.Locals[ins.B];
+                        env->AssignSlot(local.Depth, local.Slot, chunk.Names[local.Name], R[ins.A]);
+                        break;
+                    }
+                    case OpCode::DECLARE_LOCAL:
+                        env->DeclareSlot(ins.B, R[ins.A]);
+                        break;
+                    case OpCode::CONCAT_LOCAL: {
+                        const auto &local = chunk.Locals[ins.B];
+                        const Atom &name = chunk.Names[local.Name];
+                        // 求 R[C] 时变量可能被重新赋值, 此时 R[A] 已不是变量的值, 不能原地追加
+                        const bool bound = R[ins.A].Type() == ValueType::STRING &&
+                                           env->LookupSlotTagged(local.Depth, local.Slot, name).Boxed() == R[ins.A].Boxed();
+                        if (bound && Interpreter::AppendInPlace(R[ins.A], R[ins.C])) {
+                            break;
+                        }
+                        R[ins.A] = Interpreter::ApplyBinary(OperatorKind::ADD, R[ins.A], R[ins.C]);
+                        env->AssignSlot(local.Depth, local.Slot, name, R[ins.A]);
+                        break;
+                    }
+                    case OpCode::CONCAT_NAME: {
+                        const Atom &name = chunk.Names[ins.B];
+                        const bool bound = R[ins.A].Type() == ValueType::STRING &&
+                                           env->LookupName(name) == R[ins.A].Boxed();
+                        if (bound && Interpreter::AppendInPlace(R[ins.A], R[ins.C])) {
+                            break;
+                        }
+                        R[ins.A] = Interpreter::ApplyBinary(OperatorKind::ADD, R[ins.A], R[ins.C]);
+                        env->AssignName(name, R[ins.A].ToValue());
+                        break;
+                    }
+                    case OpCode::ENTER_SCOPE:
+                        env = std::make_shared<Environment>(env, chunk.Scopes[ins.A]);
+                        break;
+                    case OpCode::LEAVE_SCOPE:
+                        for (int i = 0; i < ins.A; ++i) {
+                            env = env->parent;
+                        }
+                        break;
+                    case OpCode::NEW_OBJECT:
+                        R[ins.A] = TaggedValue::FromValue(std::make_shared<ObjectValue>());
+                        break;
+                    case OpCode::NEW_ARRAY:
+                        R[ins.A] = TaggedValue::FromValue(std::make_shared<ArrayValue>(BoxRange(R, ins.B, ins.C)));
+                        break;
+                    case OpCode::GET_FIELD: {
+                        const auto &field = chunk.Fields[ins.C];
+                        R[ins.A] = TaggedValue::FromValue(
+                            R[ins.B].ToValue()->GetCached(chunk.Names[field.Name], *field.Cache));
+                        break;
+                    }
+                    case OpCode::SET_FIELD: {
+                        const auto &field = chunk.Fields[ins.B];
+                        if (field.Cache) {
+                            R[ins.A].ToValue()->SetCached(chunk.Names[field.Name], R[ins.C].ToValue(), *field.Cache);
+                        } else {
+                            R[ins.A].ToValue()->Set(chunk.Names[field.Name], R[ins.C].ToValue());
+                        }
+                        break;
+                    }
+                    case OpCode::GET_INDEX: {
+                        const ValuePtr obj = R[ins.B].ToValue();
+                        size_t index;
+                        if (obj->type == ValueType::ARRAY && R[ins.C].IsNumber() &&
+                            ArrayValue::ToIndex(R[ins.C].AsNumber(), index)) {
+                            const auto *array = static_cast<ArrayValue *>(obj.get());
+                            R[ins.A] = array->IsPacked() && index < array->Size()
+                                           ? TaggedValue::FromNumber(array->Numbers()[index])
+                                           : TaggedValue::FromValue(array->At(index));
+                            break;
+                        }
+                        R[ins.A] = TaggedValue::FromValue(obj->Get(R[ins.C].ToValue()->ToString()));
+                        break;
+                    }
+                    case OpCode::SET_INDEX: {
+                        const ValuePtr obj = R[ins.A].ToValue();
+                        size_t index;
+                        if (obj->type == ValueType::ARRAY && R[ins.B].IsNumber() &&
+                            ArrayValue::ToIndex(R[ins.B].AsNumber(), index)) {
+                            auto *array = static_cast<ArrayValue *>(obj.get());
+                            if (R[ins.C].IsNumber()) {
+                                array->SetNumberAt(index, R[ins.C].AsNumber());
+                            } else {
+                                array->SetAt(index, R[ins.C].ToValue());
+                            }
+                            break;
+                        }
+                        obj->Set(R[ins.B].ToValue()->ToString(), R[ins.C].ToValue());
+                        break;
+                    }
+                    case OpCode::ADD:
+                    case OpCode::SUB:
+                    case OpCode::MUL:
+                    case OpCode::DIV:
+                    case OpCode::MOD:
+                    case OpCode::LT:
+                    case OpCode::GT:
+                    case OpCode::LE:
+                    case OpCode::GE:
+                    case OpCode::EQ:
+                    case OpCode::NE:
+                        R[ins.A] = Interpreter::ApplyBinary(BinaryOperator(ins.Op), R[ins.B], R[ins.C]);
+                        break;
+                    case OpCode::NOT:
+                        R[ins.A] = TaggedValue::FromBool(!Interpreter::IsTruthy(R[ins.B]));
+                        break;
+                    case OpCode::NEG:
+                        if (!R[ins.B].IsNumber()) throw std::runtime_error("- 操作符只能用于数字");
+                        R[ins.A] = TaggedValue::FromNumber(-R[ins.B].AsNumber());
+                        break;
+                    case OpCode::POS:
+                        if (!R[ins.B].IsNumber()) throw std::runtime_error("+ 操作符只能用于数字");
+                        R[ins.A] = R[ins.B];
+                        break;
+                    case OpCode::INC:
+                        R[ins.A] = Step(R[ins.B], 1.0);
+                        break;
+                    case OpCode::DEC:
+                        R[ins.A] = Step(R[ins.B], -1.0);
+                        break;
+                    case OpCode::JUMP:
+                        // 向回跳转即循环的一轮结束
+                        if (static_cast<size_t>(ins.A) < pc) Collector::MaybeCollect();
+                        pc = ins.A;
+                        break;
+                    case OpCode::JUMP_IF_FALSE:
+                        if (!Interpreter::IsTruthy(R[ins.A])) pc = ins.B;
+                        break;
+                    case OpCode::JUMP_IF_TRUE:
+                        if (Interpreter::IsTruthy(R[ins.A])) pc = ins.B;
+                        break;
+                    case OpCode::CLOSURE:
+                        R[ins.A] = TaggedValue::FromValue(std::make_shared<FunctionValue>(chunk.Functions[ins.B], env));
+                        break;
+                    case OpCode::CALL: {
+                        const std::vector<ValuePtr> args = BoxRange(R, ins.B + 1, ins.C);
+                        R[ins.A] = TaggedValue::FromValue(Interpreter::CallFunction(R[ins.B].ToValue(), args));
+                        break;
+                    }
+                    case OpCode::GET_METHOD: {
+                        const auto &field = chunk.Fields[ins.B];
+                        const ValuePtr receiver = R[ins.A].ToValue();
+                        const Atom &name = chunk.Names[field.Name];
+                        if (receiver->LookupMethod(name, *field.Cache)) {
+                            R[ins.A + 1] = TaggedValue();
+                            break;
+                        }
+                        bool bindThis = false;
+                        R[ins.A + 1] = TaggedValue::FromValue(receiver->GetMethod(name, *field.Cache, bindThis));
+                        if (!bindThis) {
+                            R[ins.A] = TaggedValue();
+                        }
+                        break;
+                    }
+                    case OpCode::CALL_METHOD: {
+                        const std::vector<ValuePtr> args = BoxRange(R, ins.A + 2, ins.B);
+                        ValuePtr result;
+                        if (R[ins.A + 1].Empty()) {
+                            const auto &field = chunk.Fields[ins.C];
+                            const ValuePtr receiver = R[ins.A].ToValue();
+                            result = receiver->LookupMethod(chunk.Names[field.Name], *field.Cache)->Call(*receiver, args);
+                        } else {
+                            const ValuePtr self = R[ins.A].Empty() ? nullptr : R[ins.A].ToValue();
+                            result = Interpreter::CallFunction(R[ins.A + 1].ToValue(), args, self);
+                        }
+                        R[ins.A] = TaggedValue::FromValue(std::move(result));
+                        break;
+                    }
+                    case OpCode::RETURN:
+                        return R[ins.A].ToValue();
+                    case OpCode::THROW:
+                        throw BxScriptException(R[ins.A].ToValue());
+                    case OpCode::TRY_BEGIN:
+                        handlers.push_back(Handler{static_cast<size_t>(ins.A), ins.B, env});
+                        break;
+                    case OpCode::TRY_END:
+                        handlers.pop_back();
+                        break;
+                    case OpCode::FAIL:
+                        throw std::runtime_error(chunk.Constants[ins.A]->ToString());
+                }
+            }
+        } catch (const BxScriptException &e) {
+            // 只有脚本 throw 的异常会被 catch, 与 Execute 一致
+            if (handlers.empty()) {
+                throw;
+            }
+            auto handler = std::move(handlers.back());
+            handlers.pop_back();
+            env = std::move(handler.Env);
+            R[handler.Register] = TaggedValue::FromValue(e.ErrorValue);
+            pc = handler.Target;
+        }
+    }
+}
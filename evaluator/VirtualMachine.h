@@ -0,0 +1,30 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    寄存器虚拟机, 执行 Compiler 生成的字节码
+ */
+
+#ifndef BXSCRIPT_VIRTUALMACHINE_H
+#define BXSCRIPT_VIRTUALMACHINE_H
+
+#include "Bytecode.h"
+#include "Environment.h"
+
+class VirtualMachine {
+public:
+    // 执行一段字节码, 返回 RETURN 的值
+    static ValuePtr Execute(const BytecodeChunk &chunk, std::shared_ptr<Environment> env);
+
+    // 调用脚本函数: 绑定参数后执行函数体字节码
+    static ValuePtr Invoke(const std::shared_ptr<FunctionValue> &fn, const std::vector<ValuePtr> &args,
+                           const ValuePtr &self);
+};
+
+#endif //BXSCRIPT_VIRTUALMACHINE_H
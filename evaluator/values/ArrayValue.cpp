@@ -17,288 +17,475 @@
 #include <cmath>
 #include "../Logger.h"
 #include "../Environment.h"
+#include "common/StringKit.h"
+
+ArrayValue::ArrayValue(std::vector<ValuePtr> elements) : RuntimeValue(ValueType::ARRAY), GcNode(Kind::ARRAY),
+                                                         packed(true) {
+    const bool allNumbers = std::all_of(elements.begin(), elements.end(), [](const ValuePtr &e) {
+        return e->type == ValueType::NUMBER;
+    });
+    if (!allNumbers) {
+        packed = false;
+        this->elements = std::move(elements);
+        Collector::Track(this);
+        return;
+    }
+    numbers.reserve(elements.size());
+    for (const auto &e: elements) {
+        numbers.push_back(static_cast<NumberValue *>(e.get())->Value);
+    }
+}
+
+ValuePtr ArrayValue::At(const size_t index) const {
+    if (index >= Size()) {
+        return NullValue::Instance();
+    }
+    return packed ? NumberValue::Of(numbers[index]) : elements[index];
+}
+
+void ArrayValue::SetAt(const size_t index, ValuePtr value) {
+    if (packed && value->type == ValueType::NUMBER) {
+        SetNumberAt(index, static_cast<NumberValue *>(value.get())->Value);
+        return;
+    }
+    std::vector<ValuePtr> &boxed = Boxed();
+    if (index >= boxed.size()) boxed.resize(index + 1, NullValue::Instance());
+    boxed[index] = std::move(value);
+}
+
+void ArrayValue::SetNumberAt(const size_t index, const double value) {
+    if (!packed) {
+        SetAt(index, NumberValue::Of(value));
+        return;
+    }
+    if (index < numbers.size()) {
+        numbers[index] = value;
+    } else if (index == numbers.size()) {
+        numbers.push_back(value);
+    } else {
+        // 中间的空位是 null, 只能用通用模式表示
+        std::vector<ValuePtr> &boxed = Boxed();
+        boxed.resize(index + 1, NullValue::Instance());
+        boxed[index] = NumberValue::Of(value);
+    }
+}
+
+void ArrayValue::Push(ValuePtr value) {
+    if (packed && value->type == ValueType::NUMBER) {
+        numbers.push_back(static_cast<NumberValue *>(value.get())->Value);
+        return;
+    }
+    Boxed().push_back(std::move(value));
+}
+
+std::vector<ValuePtr> &ArrayValue::Boxed() {
+    if (packed) {
+        elements.reserve(numbers.size());
+        for (const double n: numbers) {
+            elements.push_back(NumberValue::Of(n));
+        }
+        numbers.clear();
+        numbers.shrink_to_fit();
+        packed = false;
+        Collector::Track(this);
+    }
+    return elements;
+}
+
+void ArrayValue::Trace(std::vector<GcNode *> &out) const {
+    for (const auto &e: elements) {
+        if (GcNode *node = Collector::Node(e)) out.push_back(node);
+    }
+}
+
+void ArrayValue::Unlink() {
+    elements.clear();
+}
+
+std::string ArrayValue::ToString() const {
+    std::string str = "[";
+    const size_t size = Size();
+    for (size_t i = 0; i < size; ++i) {
+        str += packed ? NumberValue::Format(numbers[i]) : elements[i]->ToString();
+        if (i < size - 1) str += ", ";
+    }
+    str += "]";
+    return str;
+}
 
 bool ArrayValue::Equal(ValuePtr v) {
     if (v->type != ValueType::ARRAY) {
         return false;
     }
     const auto otherArray = std::static_pointer_cast<ArrayValue>(v);
-    if (this->Elements.size() != otherArray->Elements.size()) return false;
-    for (size_t i = 0; i < this->Elements.size(); ++i) {
-        if (!this->Elements[i]->Equal(otherArray->Elements[i])) {
+    if (Size() != otherArray->Size()) return false;
+    if (packed && otherArray->packed) {
+        return numbers == otherArray->numbers;
+    }
+    for (size_t i = 0; i < Size(); ++i) {
+        if (!At(i)->Equal(otherArray->At(i))) {
             return false;
         }
     }
     return true;
 }
 
-ValuePtr ArrayValue::Get(const std::string &key) {
-    try {
-        const size_t index = std::stoul(key);
-        if (index < Elements.size()) return Elements[index];
-        return std::make_shared<NullValue>();
-    } catch (...) {
-        if (key == "toString") {
-            auto fn = [self = std::static_pointer_cast<ArrayValue>(shared_from_this())](
-                const std::vector<ValuePtr> &args) -> ValuePtr {
-                return std::make_shared<StringValue>(self->ToString());
-            };
-            return std::make_shared<NativeFunctionValue>(fn);
-        }
-        if (key == "length") return std::make_shared<NumberValue>(static_cast<double>(Elements.size()));
-        if (key == "push") {
-            auto fn = [self = std::static_pointer_cast<ArrayValue>(shared_from_this())](
-                const std::vector<ValuePtr> &args) -> ValuePtr {
-                for (const auto &arg: args) self->Elements.push_back(arg);
-                return std::make_shared<NumberValue>(static_cast<double>(self->Elements.size()));
-            };
-            return std::make_shared<NativeFunctionValue>(fn);
-        }
-        if (key == "pop") {
-            auto fn = [self = std::static_pointer_cast<ArrayValue>(shared_from_this())](
-                const std::vector<ValuePtr> &args) -> ValuePtr {
-                if (self->Elements.empty()) return std::make_shared<NullValue>();
-                ValuePtr last = self->Elements.back();
-                self->Elements.pop_back();
-                return last;
-            };
-            return std::make_shared<NativeFunctionValue>(fn);
-        }
-        if (key == "shift") {
-            auto fn = [self = std::static_pointer_cast<ArrayValue>(shared_from_this())]
-            (const std::vector<ValuePtr> &args) -> ValuePtr {
-                if (self->Elements.empty()) return std::make_shared<NullValue>();
-                auto v = self->Elements.front();
-                self->Elements.erase(self->Elements.begin());
-                return v;
-            };
-            return std::make_shared<NativeFunctionValue>(fn);
-        }
-        if (key == "unshift") {
-            auto fn = [self = std::static_pointer_cast<ArrayValue>(shared_from_this())]
-            (const std::vector<ValuePtr> &args) -> ValuePtr {
-                if (args.empty()) {
-                    return std::make_shared<NumberValue>(self->Elements.size());
-                }
-                self->Elements.insert(self->Elements.begin(), args.begin(), args.end());
-                return std::make_shared<NumberValue>(self->Elements.size());
-            };
-            return std::make_shared<NativeFunctionValue>(fn);
-        }
-        if (key == "concat") {
-            auto fn = [self = std::static_pointer_cast<ArrayValue>(shared_from_this())]
-            (const std::vector<ValuePtr> &args) -> ValuePtr {
-                std::vector<ValuePtr> newElements = self->Elements;
-                for (const auto &arg: args) {
-                    if (arg->type == ValueType::ARRAY) {
-                        auto otherArr = std::static_pointer_cast<ArrayValue>(arg);
-                        newElements.insert(newElements.end(), otherArr->Elements.begin(), otherArr->Elements.end());
-                    } else {
-                        newElements.push_back(arg);
-                    }
-                }
-                return std::make_shared<ArrayValue>(std::move(newElements));
-            };
-            return std::make_shared<NativeFunctionValue>(fn);
-        }
-        if (key == "join") {
-            auto fn = [self = std::static_pointer_cast<ArrayValue>(shared_from_this())]
-            (const std::vector<ValuePtr> &args) -> ValuePtr {
-                std::string sep = ",";
-                if (!args.empty()) {
-                    sep = args[0]->ToString();
-                }
-                if (self->Elements.empty()) {
-                    return std::make_shared<StringValue>("");
-                }
-                std::ostringstream ss;
-                for (size_t i = 0; i < self->Elements.size(); ++i) {
-                    ss << self->Elements[i]->ToString();
-                    if (i < self->Elements.size() - 1) {
-                        ss << sep;
-                    }
-                }
-                return std::make_shared<StringValue>(ss.str());
-            };
-            return std::make_shared<NativeFunctionValue>(fn);
-        }
-        if (key == "remove") {
-            auto fn = [self = std::static_pointer_cast<ArrayValue>(shared_from_this())]
-            (const std::vector<ValuePtr> &args) -> ValuePtr {
-                if (args.empty()) {
-                    Logger::Error("参数错误: remove(index, [count])");
-                }
-                if (args[0]->type != ValueType::NUMBER) {
-                    Logger::Error("参数错误: 索引必须是数字");
-                }
-                const long index = static_cast<long>(std::static_pointer_cast<NumberValue>(args[0])->Value);
-                long count = 1;
-                if (args.size() > 1) {
-                    if (args[1]->type != ValueType::NUMBER) {
-                        Logger::Error("参数错误: 数量必须是数字");
-                    }
-                    count = static_cast<long>(std::static_pointer_cast<NumberValue>(args[1])->Value);
-                }
-                if (index < 0 || index >= self->Elements.size()) {
-                    return std::make_shared<NullValue>();
-                }
-                if (count <= 0) {
-                    return std::make_shared<NullValue>();
-                }
-                if (index + count > self->Elements.size()) {
-                    count = self->Elements.size() - index;
-                }
-                std::vector<ValuePtr> removedItems;
-                const auto startIt = self->Elements.begin() + index;
-                const auto endIt = startIt + count;
-                removedItems.assign(startIt, endIt);
-                self->Elements.erase(startIt, endIt);
-                return std::make_shared<ArrayValue>(removedItems);
-            };
-            return std::make_shared<NativeFunctionValue>(fn);
-        }
-        if (key == "insert") {
-            auto fn = [self = std::static_pointer_cast<ArrayValue>(shared_from_this())]
-            (const std::vector<ValuePtr> &args) -> ValuePtr {
-                if (args.size() < 2) {
-                    Logger::Error("参数错误: insert(index, item)");
-                }
-                if (args[0]->type != ValueType::NUMBER) {
-                    Logger::Error("参数错误: 索引必须是数字");
-                }
-                const long index = static_cast<long>(std::static_pointer_cast<NumberValue>(args[0])->Value);
-                if (index < 0 || index > self->Elements.size()) {
-                    Logger::Error("参数错误: insert 索引越界");
-                }
-                self->Elements.insert(self->Elements.begin() + index, args[1]);
-                return std::make_shared<NumberValue>(self->Elements.size());
-            };
-            return std::make_shared<NativeFunctionValue>(fn);
-        }
-        if (key == "slice") {
-            auto fn = [self = std::static_pointer_cast<ArrayValue>(shared_from_this())]
-            (const std::vector<ValuePtr> &args) -> ValuePtr {
-                if (args.empty()) {
-                    return std::make_shared<ArrayValue>(std::vector(self->Elements));
-                }
-                if (args[0]->type != ValueType::NUMBER) {
-                    Logger::Error("参数错误: slice(number, [end])");
-                }
-                auto len = self->Elements.size();
-                auto start = static_cast<long long>(std::static_pointer_cast<NumberValue>(args[0])->Value);
-                if (start < 0) {
-                    start = len + start;
-                    if (start < 0) {
-                        start = 0;
-                    }
-                }
-                if (start > len) {
-                    return std::make_shared<ArrayValue>(std::vector<ValuePtr>());
-                }
-                auto begin = self->Elements.begin() + start;
-                if (args.size() > 1) {
-                    if (args[1]->type != ValueType::NUMBER) {
-                        Logger::Error("参数错误: slice(number, [end])");
-                    }
-                    auto end = static_cast<long long>(std::static_pointer_cast<NumberValue>(args[1])->Value);
-                    if (end < 0) {
-                        end = len + end;
-                    }
-                    if (start >= end) {
-                        return std::make_shared<ArrayValue>(std::vector<ValuePtr>());
-                    }
-                    if (end > len) {
-                        return std::make_shared<ArrayValue>(std::vector(begin, self->Elements.end()));
-                    }
-                    return std::make_shared<ArrayValue>(std::vector(begin, self->Elements.begin() + end));
-                }
-                return std::make_shared<ArrayValue>(std::vector(begin, self->Elements.end()));
-            };
-            return std::make_shared<NativeFunctionValue>(fn);
-        }
-        if (key == "indexOf") {
-            auto fn = [self = std::static_pointer_cast<ArrayValue>(shared_from_this())]
-            (const std::vector<ValuePtr> &args) -> ValuePtr {
-                if (args.empty() || self->Elements.empty()) {
-                    return std::make_shared<NumberValue>(-1);
-                }
-                auto ele = args[0];
-                long long start = 0;
-                if (args.size() > 1) {
-                    if (args[1]->type != ValueType::NUMBER) {
-                        Logger::Error("参数错误: array.indexOf(ele, [start])");
-                    }
-                    start = static_cast<long long>(std::static_pointer_cast<NumberValue>(args[1])->Value);
-                }
-                if (start > self->Elements.size()) {
-                    return std::make_shared<NumberValue>(-1);
-                }
-                if (start < 0) {
-                    start = 0;
-                }
-                for (long long i = start; i < self->Elements.size(); i++) {
-                    auto e = self->Elements.at(i);
-                    if (e->Equal(ele)) {
-                        return std::make_shared<NumberValue>(i);
-                    }
-                }
-                return std::make_shared<NumberValue>(-1);
-            };
-            return std::make_shared<NativeFunctionValue>(fn);
+// 数组的内置方法, 接收者由 value 传入; 紧凑模式的数组直接在 double 上操作
+namespace {
+    bool AllNumbers(const std::vector<ValuePtr> &args) {
+        return std::all_of(args.begin(), args.end(), [](const ValuePtr &arg) {
+            return arg->type == ValueType::NUMBER;
+        });
+    }
+
+    double NumberOf(const ValuePtr &v) {
+        return static_cast<NumberValue *>(v.get())->Value;
+    }
+
+    ValuePtr ArrayToString(RuntimeValue &value, const std::vector<ValuePtr> &args) {
+        auto *self = static_cast<ArrayValue *>(&value);
+        return std::make_shared<StringValue>(self->ToString());
+    }
+
+    ValuePtr ArrayPush(RuntimeValue &value, const std::vector<ValuePtr> &args) {
+        auto *self = static_cast<ArrayValue *>(&value);
+        for (const auto &arg: args) self->Push(arg);
+        return NumberValue::Of(static_cast<double>(self->Size()));
+    }
+
+    ValuePtr ArrayPop(RuntimeValue &value, const std::vector<ValuePtr> &args) {
+        auto *self = static_cast<ArrayValue *>(&value);
+        if (self->Empty()) return NullValue::Instance();
+        ValuePtr last = self->At(self->Size() - 1);
+        if (self->IsPacked()) {
+            self->Truncate(self->Size() - 1);
+        } else {
+            self->Boxed().pop_back();
         }
+        return last;
+    }
 
-        if (key == "lastIndexOf") {
-            auto fn = [self = std::static_pointer_cast<ArrayValue>(shared_from_this())]
-            (const std::vector<ValuePtr> &args) -> ValuePtr {
-                if (args.empty() || self->Elements.empty()) {
-                    return std::make_shared<NumberValue>(-1);
-                }
-                auto ele = args[0];
-                long long start = 0;
-                if (args.size() > 1) {
-                    if (args[1]->type != ValueType::NUMBER) {
-                        Logger::Error("参数错误: array.indexOf(ele, [start])");
-                    }
-                    start = static_cast<long long>(std::static_pointer_cast<NumberValue>(args[1])->Value);
-                }
-                if (start > self->Elements.size()) {
-                    return std::make_shared<NumberValue>(-1);
-                }
-                if (start < 0) {
-                    start = 0;
-                }
-                for (long long i = self->Elements.size() - 1; i >= 0; i--) {
-                    auto e = self->Elements.at(i);
-                    if (e->Equal(ele)) {
-                        return std::make_shared<NumberValue>(i);
-                    }
-                }
-                return std::make_shared<NumberValue>(-1);
-            };
-            return std::make_shared<NativeFunctionValue>(fn);
-        }
-
-        if (Prototype) {
-            ValuePtr method = Prototype->Get(key);
-            if (method) {
-                if (method->type == ValueType::FUNCTION) {
-                    auto originalFn = std::static_pointer_cast<FunctionValue>(method);
-                    auto thisEnv = std::make_shared<Environment>(originalFn->Closure);
-                    thisEnv->DeclareVar("this", shared_from_this());
-                    return std::make_shared<FunctionValue>(originalFn->Declaration, thisEnv);
+    ValuePtr ArrayShift(RuntimeValue &value, const std::vector<ValuePtr> &args) {
+        auto *self = static_cast<ArrayValue *>(&value);
+        if (self->Empty()) return NullValue::Instance();
+        auto v = self->At(0);
+        self->Erase(0, 1);
+        return v;
+    }
+
+    ValuePtr ArrayUnshift(RuntimeValue &value, const std::vector<ValuePtr> &args) {
+        auto *self = static_cast<ArrayValue *>(&value);
+        if (args.empty()) {
+            return NumberValue::Of(self->Size());
+        }
+        self->Insert(0, args);
+        return NumberValue::Of(self->Size());
+    }
+
+    ValuePtr ArrayConcat(RuntimeValue &value, const std::vector<ValuePtr> &args) {
+        auto *self = static_cast<ArrayValue *>(&value);
+        // 参数都是数字或紧凑数组时结果仍是紧凑数组
+        const bool packable = self->IsPacked() && std::all_of(args.begin(), args.end(), [](const ValuePtr &arg) {
+            return arg->type == ValueType::NUMBER ||
+                   (arg->type == ValueType::ARRAY && static_cast<ArrayValue *>(arg.get())->IsPacked());
+        });
+        if (packable) {
+            std::vector<double> newNumbers = self->Numbers();
+            for (const auto &arg: args) {
+                if (arg->type == ValueType::ARRAY) {
+                    const auto &other = static_cast<ArrayValue *>(arg.get())->Numbers();
+                    newNumbers.insert(newNumbers.end(), other.begin(), other.end());
+                } else {
+                    newNumbers.push_back(NumberOf(arg));
                 }
-                return method;
             }
+            return std::make_shared<ArrayValue>(std::move(newNumbers));
         }
+        std::vector<ValuePtr> newElements = self->Slice(0, self->Size());
+        for (const auto &arg: args) {
+            if (arg->type == ValueType::ARRAY) {
+                auto otherArr = std::static_pointer_cast<ArrayValue>(arg);
+                const auto otherElements = otherArr->Slice(0, otherArr->Size());
+                newElements.insert(newElements.end(), otherElements.begin(), otherElements.end());
+            } else {
+                newElements.push_back(arg);
+            }
+        }
+        return std::make_shared<ArrayValue>(std::move(newElements));
+    }
+
+    ValuePtr ArrayJoin(RuntimeValue &value, const std::vector<ValuePtr> &args) {
+        auto *self = static_cast<ArrayValue *>(&value);
+        std::string sep = ",";
+        if (!args.empty()) {
+            sep = args[0]->ToString();
+        }
+        if (self->Empty()) {
+            return std::make_shared<StringValue>("");
+        }
+        std::string joined;
+        const size_t size = self->Size();
+        for (size_t i = 0; i < size; ++i) {
+            joined += self->IsPacked() ? NumberValue::Format(self->Numbers()[i]) : self->At(i)->ToString();
+            if (i < size - 1) {
+                joined += sep;
+            }
+        }
+        return std::make_shared<StringValue>(std::move(joined));
+    }
+
+    ValuePtr ArrayRemove(RuntimeValue &value, const std::vector<ValuePtr> &args) {
+        auto *self = static_cast<ArrayValue *>(&value);
+        if (args.empty()) {
+            Logger::Error("参数错误: remove(index, [count])");
+        }
+        if (args[0]->type != ValueType::NUMBER) {
+            Logger::Error("参数错误: 索引必须是数字");
+        }
+        const long index = static_cast<long>(std::static_pointer_cast<NumberValue>(args[0])->Value);
+        long count = 1;
+        if (args.size() > 1) {
+            if (args[1]->type != ValueType::NUMBER) {
+                Logger::Error("参数错误: 数量必须是数字");
+            }
+            count = static_cast<long>(std::static_pointer_cast<NumberValue>(args[1])->Value);
+        }
+        if (index < 0 || index >= self->Size()) {
+            return NullValue::Instance();
+        }
+        if (count <= 0) {
+            return NullValue::Instance();
+        }
+        if (index + count > self->Size()) {
+            count = self->Size() - index;
+        }
+        auto removedItems = self->SliceArray(index, index + count);
+        self->Erase(index, count);
+        return removedItems;
+    }
+
+    ValuePtr ArrayInsert(RuntimeValue &value, const std::vector<ValuePtr> &args) {
+        auto *self = static_cast<ArrayValue *>(&value);
+        if (args.size() < 2) {
+            Logger::Error("参数错误: insert(index, item)");
+        }
+        if (args[0]->type != ValueType::NUMBER) {
+            Logger::Error("参数错误: 索引必须是数字");
+        }
+        const long index = static_cast<long>(std::static_pointer_cast<NumberValue>(args[0])->Value);
+        if (index < 0 || index > self->Size()) {
+            Logger::Error("参数错误: insert 索引越界");
+        }
+        self->Insert(index, {args[1]});
+        return NumberValue::Of(self->Size());
+    }
+
+    ValuePtr ArraySlice(RuntimeValue &value, const std::vector<ValuePtr> &args) {
+        auto *self = static_cast<ArrayValue *>(&value);
+        auto len = self->Size();
+        if (args.empty()) {
+            return self->SliceArray(0, len);
+        }
+        if (args[0]->type != ValueType::NUMBER) {
+            Logger::Error("参数错误: slice(number, [end])");
+        }
+        auto start = static_cast<long long>(std::static_pointer_cast<NumberValue>(args[0])->Value);
+        if (start < 0) {
+            start = len + start;
+            if (start < 0) {
+                start = 0;
+            }
+        }
+        if (start > len) {
+            return self->SliceArray(0, 0);
+        }
+        if (args.size() > 1) {
+            if (args[1]->type != ValueType::NUMBER) {
+                Logger::Error("参数错误: slice(number, [end])");
+            }
+            auto end = static_cast<long long>(std::static_pointer_cast<NumberValue>(args[1])->Value);
+            if (end < 0) {
+                end = len + end;
+            }
+            if (start >= end) {
+                return self->SliceArray(0, 0);
+            }
+            if (end > len) {
+                return self->SliceArray(start, len);
+            }
+            return self->SliceArray(start, end);
+        }
+        return self->SliceArray(start, len);
+    }
+
+    ValuePtr ArrayIndexOf(RuntimeValue &value, const std::vector<ValuePtr> &args) {
+        auto *self = static_cast<ArrayValue *>(&value);
+        if (args.empty() || self->Empty()) {
+            return NumberValue::Of(-1);
+        }
+        auto ele = args[0];
+        long long start = 0;
+        if (args.size() > 1) {
+            if (args[1]->type != ValueType::NUMBER) {
+                Logger::Error("参数错误: array.indexOf(ele, [start])");
+            }
+            start = static_cast<long long>(std::static_pointer_cast<NumberValue>(args[1])->Value);
+        }
+        if (start > self->Size()) {
+            return NumberValue::Of(-1);
+        }
+        if (start < 0) {
+            start = 0;
+        }
+        if (self->IsPacked()) {
+            if (ele->type != ValueType::NUMBER) {
+                return NumberValue::Of(-1);
+            }
+            const auto &numbers = self->Numbers();
+            const auto it = std::find(numbers.begin() + start, numbers.end(), NumberOf(ele));
+            return NumberValue::Of(it == numbers.end() ? -1 : static_cast<double>(it - numbers.begin()));
+        }
+        for (long long i = start; i < self->Size(); i++) {
+            auto e = self->At(i);
+            if (e->Equal(ele)) {
+                return NumberValue::Of(i);
+            }
+        }
+        return NumberValue::Of(-1);
+    }
+
+    ValuePtr ArrayLastIndexOf(RuntimeValue &value, const std::vector<ValuePtr> &args) {
+        auto *self = static_cast<ArrayValue *>(&value);
+        if (args.empty() || self->Empty()) {
+            return NumberValue::Of(-1);
+        }
+        auto ele = args[0];
+        long long start = 0;
+        if (args.size() > 1) {
+            if (args[1]->type != ValueType::NUMBER) {
+                Logger::Error("参数错误: array.indexOf(ele, [start])");
+            }
+            start = static_cast<long long>(std::static_pointer_cast<NumberValue>(args[1])->Value);
+        }
+        if (start > self->Size()) {
+            return NumberValue::Of(-1);
+        }
+        if (start < 0) {
+            start = 0;
+        }
+        if (self->IsPacked()) {
+            if (ele->type != ValueType::NUMBER) {
+                return NumberValue::Of(-1);
+            }
+            const auto &numbers = self->Numbers();
+            const auto it = std::find(numbers.rbegin(), numbers.rend(), NumberOf(ele));
+            return NumberValue::Of(it == numbers.rend() ? -1 : static_cast<double>(numbers.rend() - it - 1));
+        }
+        for (long long i = self->Size() - 1; i >= 0; i--) {
+            auto e = self->At(i);
+            if (e->Equal(ele)) {
+                return NumberValue::Of(i);
+            }
+        }
+        return NumberValue::Of(-1);
+    }
+}
+
+void ArrayValue::Truncate(const size_t size) {
+    if (packed) {
+        numbers.resize(std::min(size, numbers.size()));
+    } else {
+        elements.resize(std::min(size, elements.size()));
+    }
+}
+
+void ArrayValue::Erase(const size_t index, const size_t count) {
+    if (packed) {
+        numbers.erase(numbers.begin() + index, numbers.begin() + index + count);
+    } else {
+        elements.erase(elements.begin() + index, elements.begin() + index + count);
+    }
+}
+
+void ArrayValue::Insert(const size_t index, const std::vector<ValuePtr> &items) {
+    if (packed && AllNumbers(items)) {
+        std::vector<double> values;
+        values.reserve(items.size());
+        for (const auto &item: items) values.push_back(NumberOf(item));
+        numbers.insert(numbers.begin() + index, values.begin(), values.end());
+        return;
+    }
+    std::vector<ValuePtr> &boxed = Boxed();
+    boxed.insert(boxed.begin() + index, items.begin(), items.end());
+}
+
+std::vector<ValuePtr> ArrayValue::Slice(const size_t begin, const size_t end) const {
+    if (!packed) {
+        return {elements.begin() + begin, elements.begin() + end};
+    }
+    std::vector<ValuePtr> result;
+    result.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i) {
+        result.push_back(NumberValue::Of(numbers[i]));
+    }
+    return result;
+}
+
+ValuePtr ArrayValue::SliceArray(const size_t begin, const size_t end) const {
+    if (packed) {
+        return std::make_shared<ArrayValue>(std::vector<double>(numbers.begin() + begin, numbers.begin() + end));
+    }
+    return std::make_shared<ArrayValue>(Slice(begin, end));
+}
+
+ValuePtr ArrayValue::Get(const std::string &key) {
+    bool bindThis = false;
+    ValuePtr value = Lookup(key, bindThis);
+    return bindThis ? BindThis(value) : value;
+}
+
+ValuePtr ArrayValue::GetMethod(const Atom &key, PropertyCache &, bool &bindThis) {
+    return Lookup(key, bindThis);
+}
+
+ValuePtr ArrayValue::Lookup(const std::string &key, bool &bindThis) {
+    bindThis = false;
+    if (size_t index; StringKit::ToIndex(key, index)) {
+        return At(index);
+    }
+    if (key == "length") return NumberValue::Of(static_cast<double>(Size()));
+    if (const NativeMethod *method = FindMethod(key)) {
+        return BindMethod(method);
+    }
+    if (Prototype) {
+        return PrototypeMember(*Prototype, key, bindThis);
     }
     return RuntimeValue::Get(key);
 }
 
+const NativeMethod *ArrayValue::FindMethod(const std::string &key) const {
+    static const std::unordered_map<std::string, NativeMethod> methods = {
+        {"toString", {ValueType::ARRAY, ArrayToString}},
+        {"push", {ValueType::ARRAY, ArrayPush}},
+        {"pop", {ValueType::ARRAY, ArrayPop}},
+        {"shift", {ValueType::ARRAY, ArrayShift}},
+        {"unshift", {ValueType::ARRAY, ArrayUnshift}},
+        {"concat", {ValueType::ARRAY, ArrayConcat}},
+        {"join", {ValueType::ARRAY, ArrayJoin}},
+        {"remove", {ValueType::ARRAY, ArrayRemove}},
+        {"insert", {ValueType::ARRAY, ArrayInsert}},
+        {"slice", {ValueType::ARRAY, ArraySlice}},
+        {"indexOf", {ValueType::ARRAY, ArrayIndexOf}},
+        {"lastIndexOf", {ValueType::ARRAY, ArrayLastIndexOf}},
+    };
+    const auto it = methods.find(key);
+    return it == methods.end() ? nullptr : &it->second;
+}
+
 void ArrayValue::Set(const std::string &key, const ValuePtr value) {
     try {
         const size_t index = std::stoul(key);
-        if (index >= Elements.size()) Elements.resize(index + 1, std::make_shared<NullValue>());
-        Elements[index] = value;
+        SetAt(index, value);
     } catch (...) {
         Logger::Error("数组索引必须是整数: " + key);
     }
@@ -310,9 +497,9 @@ ValuePtr ArrayValue::InitBuiltins() {
     const auto isArrayFn = std::make_shared<NativeFunctionValue>(
         [](const std::vector<ValuePtr> &args) -> ValuePtr {
             if (args.empty()) {
-                return std::make_shared<BoolValue>(false);
+                return BoolValue::Of(false);
             }
-            return std::make_shared<BoolValue>(args[0]->type == ValueType::ARRAY);
+            return BoolValue::Of(args[0]->type == ValueType::ARRAY);
         });
     arrayObj->Set("isArray", isArrayFn);
     return arrayObj;
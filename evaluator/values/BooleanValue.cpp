@@ -13,6 +13,12 @@
 
 #include "../Value.h"
 
+const ValuePtr &BoolValue::Of(const bool v) {
+    static const ValuePtr trueValue = std::make_shared<BoolValue>(true);
+    static const ValuePtr falseValue = std::make_shared<BoolValue>(false);
+    return v ? trueValue : falseValue;
+}
+
 bool BoolValue::Equal(ValuePtr v) {
     if (v->type != ValueType::BOOL) {
         return false;
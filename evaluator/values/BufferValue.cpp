@@ -12,17 +12,15 @@
  */
 
 #include "../Value.h"
+#include "common/StringKit.h"
 
 ValuePtr BufferValue::Get(const std::string &key) {
-    try {
-        size_t index = std::stoul(key);
+    if (size_t index; StringKit::ToIndex(key, index)) {
         if (index < Buffer.size()) {
-            return std::make_shared<NumberValue>(Buffer[index]);
-        }
-    } catch (...) {
-        if (key == "length" || key == "size") {
-            return std::make_shared<NumberValue>(static_cast<double>(Buffer.size()));
+            return NumberValue::Of(Buffer[index]);
         }
+    } else if (key == "length" || key == "size") {
+        return NumberValue::Of(static_cast<double>(Buffer.size()));
     }
     return RuntimeValue::Get(key);
 }
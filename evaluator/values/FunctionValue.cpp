@@ -12,6 +12,36 @@
  */
 
 #include "evaluator/Value.h"
+#include "evaluator/Environment.h"
+#include "parser/Expression.h"
+
+FunctionValue::FunctionValue(FunctionLiteral *decl, std::shared_ptr<Environment> closure, ValuePtr self)
+    : RuntimeValue(ValueType::FUNCTION), GcNode(Kind::FUNCTION), Declaration(decl), Closure(std::move(closure)),
+      This(std::move(self)), Source(decl->Owner ? decl->Owner->shared_from_this() : nullptr) {
+    Collector::Track(this);
+    for (Environment *env = Closure.get(); env && !env->Tracked(); env = env->parent.get()) {
+        Collector::Track(env);
+    }
+}
+
+void FunctionValue::Trace(std::vector<GcNode *> &out) const {
+    if (Closure) out.push_back(Closure.get());
+    if (GcNode *node = Collector::Node(This)) out.push_back(node);
+}
+
+void FunctionValue::Unlink() {
+    Closure.reset();
+    This.reset();
+}
+
+void NativeFunctionValue::Trace(std::vector<GcNode *> &out) const {
+    if (GcNode *node = Collector::Node(Bound)) out.push_back(node);
+}
+
+void NativeFunctionValue::Unlink() {
+    Bound.reset();
+    Function = nullptr;
+}
 
 ValuePtr FunctionValue::InitBuiltins() {
     auto funObj = std::make_shared<ObjectValue>();
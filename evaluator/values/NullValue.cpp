@@ -13,6 +13,11 @@
 
 #include "evaluator/Value.h"
 
+const ValuePtr &NullValue::Instance() {
+    static const ValuePtr instance = std::make_shared<NullValue>();
+    return instance;
+}
+
 bool NullValue::Equal(ValuePtr v) {
     if (v->type != ValueType::NULL_TYPE) {
         return false;
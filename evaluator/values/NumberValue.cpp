@@ -11,12 +11,34 @@
  * @brief    数字对象原型链和静态函数
  */
 
+#include <array>
+#include <cmath>
 #include <limits>
 
 #include "../Value.h"
 #include "../Logger.h"
 #include "../Environment.h"
 
+ValuePtr NumberValue::Of(const double v) {
+    constexpr int minCached = -128;
+    constexpr int maxCached = 1023;
+    static const auto cache = [] {
+        std::array<ValuePtr, maxCached - minCached + 1> values{};
+        for (int i = minCached; i <= maxCached; ++i) {
+            values[i - minCached] = std::make_shared<NumberValue>(i);
+        }
+        return values;
+    }();
+    // -0 需要保留符号, 不走缓存
+    if (v >= minCached && v <= maxCached && !(v == 0 && std::signbit(v))) {
+        const int i = static_cast<int>(v);
+        if (i == v) {
+            return cache[i - minCached];
+        }
+    }
+    return std::make_shared<NumberValue>(v);
+}
+
 bool NumberValue::Equal(ValuePtr v) {
     if (v->type != ValueType::NUMBER) {
         return false;
@@ -25,50 +47,59 @@ bool NumberValue::Equal(ValuePtr v) {
     return this->Value == other->Value;
 }
 
-ValuePtr NumberValue::Get(const std::string &key) {
-    if (key == "toFixed") {
-        return std::make_shared<NativeFunctionValue>(
-            [self = std::static_pointer_cast<NumberValue>(shared_from_this())]
-    (const std::vector<ValuePtr> &args) -> ValuePtr {
-                if (args.size() != 1) Logger::Error("toFixed参数错误: 需要1个参数");
-                if (args.at(0)->type != ValueType::NUMBER) Logger::Error("toFixed参数错误: 参数必须是数字");
-                const auto arg = std::static_pointer_cast<NumberValue>(args.at(0));
-                const int precision = static_cast<int>(arg->Value);
-                if (precision < 0 || precision > 100) Logger::Error("toFixed参数错误: 参数范围0~100");
-                std::ostringstream ss;
-                ss << std::fixed << std::setprecision(precision) << self->Value;
-                return std::make_shared<StringValue>(ss.str());
-            }
-        );
+// 数字的内置方法, 接收者由 value 传入
+namespace {
+    ValuePtr NumberToFixed(RuntimeValue &value, const std::vector<ValuePtr> &args) {
+        const auto *self = static_cast<NumberValue *>(&value);
+        if (args.size() != 1) Logger::Error("toFixed参数错误: 需要1个参数");
+        if (args.at(0)->type != ValueType::NUMBER) Logger::Error("toFixed参数错误: 参数必须是数字");
+        const auto arg = std::static_pointer_cast<NumberValue>(args.at(0));
+        const int precision = static_cast<int>(arg->Value);
+        if (precision < 0 || precision > 100) Logger::Error("toFixed参数错误: 参数范围0~100");
+        std::ostringstream ss;
+        ss << std::fixed << std::setprecision(precision) << self->Value;
+        return std::make_shared<StringValue>(ss.str());
     }
-    if (key == "toString") {
-        return std::make_shared<NativeFunctionValue>(
-            [self = std::static_pointer_cast<NumberValue>(shared_from_this())]
-    (const std::vector<ValuePtr> &args)-> ValuePtr {
-                return std::make_shared<StringValue>(self->ToString());
-            }
-        );
+
+    ValuePtr NumberToString(RuntimeValue &value, const std::vector<ValuePtr> &args) {
+        return std::make_shared<StringValue>(value.ToString());
     }
+}
 
+ValuePtr NumberValue::Get(const std::string &key) {
+    bool bindThis = false;
+    ValuePtr value = Lookup(key, bindThis);
+    return bindThis ? BindThis(value) : value;
+}
+
+ValuePtr NumberValue::GetMethod(const Atom &key, PropertyCache &, bool &bindThis) {
+    return Lookup(key, bindThis);
+}
+
+ValuePtr NumberValue::Lookup(const std::string &key, bool &bindThis) {
+    bindThis = false;
+    if (const NativeMethod *method = FindMethod(key)) {
+        return BindMethod(method);
+    }
     if (Prototype) {
-        ValuePtr method = Prototype->Get(key);
-        if (method) {
-            if (method->type == ValueType::FUNCTION) {
-                auto originalFn = std::static_pointer_cast<FunctionValue>(method);
-                auto thisEnv = std::make_shared<Environment>(originalFn->Closure);
-                thisEnv->DeclareVar("this", shared_from_this());
-                return std::make_shared<FunctionValue>(originalFn->Declaration, thisEnv);
-            }
-            return method;
-        }
+        return PrototypeMember(*Prototype, key, bindThis);
     }
     return RuntimeValue::Get(key);
 }
 
+const NativeMethod *NumberValue::FindMethod(const std::string &key) const {
+    static const std::unordered_map<std::string, NativeMethod> methods = {
+        {"toFixed", {ValueType::NUMBER, NumberToFixed}},
+        {"toString", {ValueType::NUMBER, NumberToString}},
+    };
+    const auto it = methods.find(key);
+    return it == methods.end() ? nullptr : &it->second;
+}
+
 ValuePtr NumberValue::InitBuiltins() {
     auto numberObj = std::make_shared<ObjectValue>();
     numberObj->Set("prototype", Prototype);
-    numberObj->Set("MAX_VALUE", std::make_shared<NumberValue>(std::numeric_limits<unsigned long long>::max()));
-    numberObj->Set("MIN_VALUE", std::make_shared<NumberValue>(std::numeric_limits<unsigned long long>::min()));
+    numberObj->Set("MAX_VALUE", NumberValue::Of(std::numeric_limits<unsigned long long>::max()));
+    numberObj->Set("MIN_VALUE", NumberValue::Of(std::numeric_limits<unsigned long long>::min()));
     return numberObj;
 }
@@ -22,35 +22,257 @@ bool ObjectValue::Equal(ValuePtr v) {
         return false;
     }
     auto obj = std::static_pointer_cast<ObjectValue>(v);
-    if (this->Properties.size() != obj->Properties.size()) return false;
-    for (const auto &[key, val]: this->Properties) {
-        if (obj->Properties.find(key) == obj->Properties.end()) return false;
-        if (!val->Equal(obj->Properties.at(key))) return false;
+    this->MaterializeAll();
+    obj->MaterializeAll();
+    if (this->Size() != obj->Size()) return false;
+    bool equal = true;
+    this->ForEach([&](const std::string &key, const ValuePtr &val) {
+        if (!equal) return;
+        const ValuePtr other = obj->Find(key);
+        equal = other && val->Equal(other);
+    });
+    return equal;
+}
+
+ValuePtr ObjectValue::Find(const std::string &key) const {
+    const auto guard = LockLazy();
+    if (dictionary) {
+        const auto it = dictionary->find(key);
+        return it == dictionary->end() ? nullptr : it->second;
+    }
+    const int slot = shape->Find(key);
+    return slot < 0 ? nullptr : slots[slot];
+}
+
+bool ObjectValue::Remove(const std::string &key) {
+    const auto guard = LockLazy();
+    if (!Find(key)) {
+        // 尚未创建的模块成员: 标记为已处理, 之后不再创建
+        if (lazy) {
+            const auto &members = *lazy->Members;
+            for (size_t i = 0; i < members.size(); ++i) {
+                if (!lazy->Done[i] && key == members[i].Name) {
+                    lazy->Finish(i);
+                    return true;
+                }
+            }
+        }
+        return false;
     }
+    ToDictionary();
+    dictionary->erase(key);
     return true;
 }
 
+std::shared_ptr<ObjectValue> ObjectValue::Clone() const {
+    auto copy = std::make_shared<ObjectValue>();
+    if (dictionary) {
+        copy->dictionary = std::make_unique<std::unordered_map<std::string, ValuePtr> >(*dictionary);
+    } else {
+        copy->shape = shape;
+        copy->slots = slots;
+    }
+    return copy;
+}
+
+std::shared_ptr<ObjectValue> ObjectValue::Lazy(const std::vector<LazyMember> &members) {
+    auto module = std::make_shared<ObjectValue>();
+    module->lazy = std::make_unique<LazyState>();
+    module->lazy->Members = &members;
+    module->lazy->Done.assign(members.size(), false);
+    module->lazy->Pending = members.size();
+    module->lazy->Complete = members.empty();
+    // 预留全部槽位, 创建成员时不重新分配
+    module->slots.reserve(members.size());
+    return module;
+}
+
+ValuePtr ObjectValue::Materialize(const std::string &key) {
+    std::lock_guard<std::recursive_mutex> guard(lazy->Lock);
+    const auto &members = *lazy->Members;
+    for (size_t i = 0; i < members.size(); ++i) {
+        if (key != members[i].Name) {
+            continue;
+        }
+        if (!lazy->Done[i]) {
+            // 先标记, Init 中读取自身时不会重复创建; 创建完成后才计入, 全部完成前读写一直加锁
+            lazy->Done[i] = true;
+            auto self = std::static_pointer_cast<ObjectValue>(shared_from_this());
+            try {
+                members[i].Init(self);
+            } catch (...) {
+                // 创建失败: 恢复为待创建, 下次访问重试
+                lazy->Done[i] = false;
+                throw;
+            }
+            lazy->Finish(i);
+        }
+        return Find(key);
+    }
+    return nullptr;
+}
+
+void ObjectValue::MaterializeAll() {
+    if (!lazy) {
+        return;
+    }
+    std::lock_guard<std::recursive_mutex> guard(lazy->Lock);
+    const auto &members = *lazy->Members;
+    for (size_t i = 0; i < members.size(); ++i) {
+        if (lazy->Done[i]) {
+            continue;
+        }
+        // 脚本已经赋值的成员保留脚本的值
+        if (Find(members[i].Name)) {
+            lazy->Finish(i);
+        } else {
+            Materialize(members[i].Name);
+        }
+    }
+}
+
+void ObjectValue::ToDictionary() {
+    if (dictionary) {
+        return;
+    }
+    auto table = std::make_unique<std::unordered_map<std::string, ValuePtr> >();
+    table->reserve(slots.size());
+    const auto &keys = shape->Keys();
+    for (size_t i = 0; i < keys.size(); ++i) {
+        table->emplace(keys[i], std::move(slots[i]));
+    }
+    dictionary = std::move(table);
+    slots.clear();
+    slots.shrink_to_fit();
+    shape = Shape::Empty();
+}
+
 // ObjectValue
 ValuePtr ObjectValue::Get(const std::string &key) {
-    if (Properties.find(key) != Properties.end()) return Properties[key];
+    if (ValuePtr own = Find(key)) return own;
+    if (lazy) {
+        if (ValuePtr member = Materialize(key)) return member;
+    }
 
     if (Prototype && this != Prototype.get()) {
-        ValuePtr method = Prototype->Get(key);
-        if (method) {
-            if (method->type == ValueType::FUNCTION) {
-                auto originalFn = std::static_pointer_cast<FunctionValue>(method);
-                auto thisEnv = std::make_shared<Environment>(originalFn->Closure);
-                thisEnv->DeclareVar("this", shared_from_this());
-                return std::make_shared<FunctionValue>(originalFn->Declaration, thisEnv);
-            }
-            return method;
-        }
+        bool bindThis = false;
+        ValuePtr value = PrototypeMember(*Prototype, key, bindThis);
+        return bindThis ? BindThis(value) : value;
+    }
+    return NullValue::Instance();
+}
+
+ValuePtr ObjectValue::GetCached(const Atom &key, PropertyCache &cache) {
+    bool bindThis = false;
+    ValuePtr value = GetMethod(key, cache, bindThis);
+    return bindThis ? BindThis(value) : value;
+}
+
+ValuePtr ObjectValue::GetMethod(const Atom &key, PropertyCache &cache, bool &bindThis) {
+    const auto guard = LockLazy();
+    bindThis = false;
+    if (dictionary) {
+        return Get(key);
+    }
+    int slot = cache.Lookup(shape->Id, shape->Size());
+    if (slot == PropertyCache::Miss) {
+        slot = shape->Find(key);
+        cache.Record(shape->Id, slot < 0 ? PropertyCache::Absent : slot);
+    }
+    if (slot >= 0) {
+        return slots[slot];
     }
-    return std::make_shared<NullValue>();
+    // 创建后 Shape 改变, 下次访问由缓存直接命中
+    if (lazy) {
+        if (ValuePtr member = Materialize(key)) return member;
+    }
+    ObjectValue *proto = Prototype.get();
+    if (!proto || this == proto) {
+        return NullValue::Instance();
+    }
+    if (proto->dictionary) {
+        return Get(key);
+    }
+    int protoSlot = cache.LookupPrototype(proto->shape->Id, proto->shape->Size());
+    if (protoSlot == PropertyCache::Miss) {
+        protoSlot = proto->shape->Find(key);
+        cache.RecordPrototype(proto->shape->Id, protoSlot < 0 ? PropertyCache::Absent : protoSlot);
+    }
+    if (protoSlot < 0) {
+        return NullValue::Instance();
+    }
+    const ValuePtr &method = proto->slots[protoSlot];
+    bindThis = method->type == ValueType::FUNCTION;
+    return method;
 }
 
 void ObjectValue::Set(const std::string &key, ValuePtr value) {
-    Properties[key] = value;
+    const auto guard = LockLazy();
+    if (dictionary) {
+        (*dictionary)[key] = std::move(value);
+        return;
+    }
+    if (const int slot = shape->Find(key); slot >= 0) {
+        slots[slot] = std::move(value);
+        return;
+    }
+    // 计算出的键 (obj[k] = v)、JSON 与原生模块写入的属性名按引用计数驻留, 由 Shape 持有, 不再使用时移出 Atom 表
+    const Atom atom = Atom::Acquire(key);
+    AddProperty(atom, std::move(value));
+    Atom::Release(atom);
+}
+
+void ObjectValue::Set(const Atom &key, ValuePtr value) {
+    const auto guard = LockLazy();
+    if (dictionary) {
+        (*dictionary)[key] = std::move(value);
+        return;
+    }
+    if (const int slot = shape->Find(key); slot >= 0) {
+        slots[slot] = std::move(value);
+        return;
+    }
+    AddProperty(key, std::move(value));
+}
+
+void ObjectValue::SetCached(const Atom &key, ValuePtr value, PropertyCache &cache) {
+    const auto guard = LockLazy();
+    if (dictionary) {
+        (*dictionary)[key] = std::move(value);
+        return;
+    }
+    int slot = cache.Lookup(shape->Id, shape->Size());
+    if (slot == PropertyCache::Miss) {
+        slot = shape->Find(key);
+        cache.Record(shape->Id, slot < 0 ? PropertyCache::Absent : slot);
+    }
+    if (slot >= 0) {
+        slots[slot] = std::move(value);
+        return;
+    }
+    AddProperty(key, std::move(value));
+}
+
+void ObjectValue::AddProperty(const Atom &key, ValuePtr value) {
+    if (slots.size() >= Shape::MaxProperties) {
+        ToDictionary();
+        dictionary->emplace(key, std::move(value));
+        return;
+    }
+    shape = shape->Add(key);
+    slots.push_back(std::move(value));
+}
+
+void ObjectValue::Trace(std::vector<GcNode *> &out) const {
+    ForEach([&out](const std::string &, const ValuePtr &value) {
+        if (GcNode *node = Collector::Node(value)) out.push_back(node);
+    });
+}
+
+void ObjectValue::Unlink() {
+    shape = Shape::Empty();
+    slots.clear();
+    dictionary.reset();
 }
 
 ValuePtr ObjectValue::InitBuiltins() {
@@ -62,14 +284,15 @@ ValuePtr ObjectValue::InitBuiltins() {
                 Logger::Error("参数错误: Object.keys(obj)");
             }
             const auto target = std::static_pointer_cast<ObjectValue>(args[0]);
+            target->MaterializeAll();
             std::vector<ValuePtr> keys;
-            keys.reserve(target->Properties.size());
-            if (target->Properties.empty()) {
+            keys.reserve(target->Size());
+            if (target->Empty()) {
                 return std::make_shared<ArrayValue>(std::move(keys));
             }
-            for (auto &[k, v]: target->Properties) {
+            target->ForEach([&keys](const std::string &k, const ValuePtr &) {
                 keys.push_back(std::make_shared<StringValue>(k));
-            }
+            });
             return std::make_shared<ArrayValue>(std::move(keys));
         });
     objObj->Set("keys", keysFn);
@@ -84,11 +307,11 @@ ValuePtr ObjectValue::InitBuiltins() {
                     const auto &arg = args[i];
                     if (arg->type == ValueType::STRING) {
                         const auto argStr = std::static_pointer_cast<StringValue>(arg);
-                        target->Properties.erase(argStr->Value);
+                        target->Remove(argStr->Value);
                     }
                 }
             }
-            return std::make_shared<NullValue>();
+            return NullValue::Instance();
         });
     objObj->Set("remove", removeKeyFn);
     return objObj;
@@ -29,83 +29,121 @@ bool StringValue::Equal(ValuePtr v) {
     return this->Value == other->Value;
 }
 
-StringValue::StringValue(std::string v) : RuntimeValue(ValueType::STRING) {
-    U32Value = StringKit::Utf8ToU32(v);
-    Value = std::move(v);
+StringValue::StringValue(std::string v) : RuntimeValue(ValueType::STRING), Value(std::move(v)) {
+    ascii = std::all_of(Value.begin(), Value.end(), [](const char c) {
+        return static_cast<unsigned char>(c) < 0x80;
+    });
 }
 
-StringValue::StringValue(char32_t v) : RuntimeValue(ValueType::STRING) {
-    U32Value = std::u32string(1, v);
-    Value = StringKit::Char32ToUtf8(v);
+StringValue::StringValue(char32_t v) : RuntimeValue(ValueType::STRING), Value(StringKit::Char32ToUtf8(v)),
+                                       ascii(v < 0x80) {
+}
+
+const std::u32string &StringValue::U32() const {
+    std::call_once(decodeOnce, [this] {
+        u32 = StringKit::Utf8ToU32(Value);
+    });
+    return u32;
+}
+
+void StringValue::Append(const std::string &piece) {
+    const bool wasEmpty = Value.empty();
+    Value.append(piece);
+    const bool pieceAscii = std::all_of(piece.begin(), piece.end(), [](const char c) {
+        return static_cast<unsigned char>(c) < 0x80;
+    });
+    ascii = ascii && pieceAscii;
+    // 已解码过的部分跟着追加; 空串无法区分是否解码过, 一并填上, 之后若再解码结果相同
+    if (!u32.empty() || wasEmpty) {
+        u32.append(StringKit::Utf8ToU32(piece));
+    }
+}
+
+std::string StringValue::Substr(const size_t start, const size_t count) const {
+    if (ascii) {
+        return Value.substr(start, count);
+    }
+    return StringKit::U32ToUtf8(U32().substr(start, count));
+}
+
+// 字符串的内置方法, 接收者由 value 传入
+namespace {
+    ValuePtr StringCharCodeAt(RuntimeValue &value, const std::vector<ValuePtr> &args) {
+        const auto *self = static_cast<StringValue *>(&value);
+        if (args.empty() || args[0]->type != ValueType::NUMBER) {
+            return NumberValue::Of(NAN);
+        }
+        const size_t index = static_cast<size_t>(std::static_pointer_cast<NumberValue>(args[0])->Value);
+        if (index >= self->Length()) {
+            return NumberValue::Of(NAN);
+        }
+        return NumberValue::Of(self->CodePointAt(index));
+    }
+
+    ValuePtr StringSubstr(RuntimeValue &value, const std::vector<ValuePtr> &args) {
+        const auto *self = static_cast<StringValue *>(&value);
+        if (args.size() != 2) Logger::Error("参数错误: substr(start, end)");
+        if (args.at(0)->type != ValueType::NUMBER || args.at(1)->type != ValueType::NUMBER) {
+            Logger::Error("参数错误: substr(Number, Number)");
+        }
+        const auto arg1 = std::static_pointer_cast<NumberValue>(args.at(0));
+        const auto arg2 = std::static_pointer_cast<NumberValue>(args.at(1));
+        auto start = static_cast<long long>(arg1->Value);
+        auto end = static_cast<long long>(arg2->Value);
+        const size_t len = self->Length();
+        if (start > len) start = len;
+        if (end > len) end = len;
+        if (start > end) {
+            Logger::Error("参数错误: substr(start, end), start 不能大于 end");
+        }
+        size_t count = end - start;
+        if (count == 0) {
+            return std::make_shared<StringValue>("");
+        }
+        return std::make_shared<StringValue>(self->Substr(start, count));
+    }
 }
 
 ValuePtr StringValue::Get(const std::string &key) {
+    bool bindThis = false;
+    ValuePtr value = Lookup(key, bindThis);
+    return bindThis ? BindThis(value) : value;
+}
+
+ValuePtr StringValue::GetMethod(const Atom &key, PropertyCache &, bool &bindThis) {
+    return Lookup(key, bindThis);
+}
+
+ValuePtr StringValue::Lookup(const std::string &key, bool &bindThis) {
+    bindThis = false;
     if (!key.empty() && std::all_of(key.begin(), key.end(), ::isdigit)) {
         const auto index = std::stoul(key);
-        if (index >= this->U32Value.size()) {
-            return std::make_shared<NullValue>();
+        if (index >= Length()) {
+            return NullValue::Instance();
         }
-        return std::make_shared<StringValue>(this->U32Value[index]);
+        return std::make_shared<StringValue>(CodePointAt(index));
     }
     if (key == "length") {
-        return std::make_shared<NumberValue>(this->U32Value.length());
+        return NumberValue::Of(Length());
     }
-    if (key == "charCodeAt") {
-        auto fn = [self = std::static_pointer_cast<StringValue>(shared_from_this())](
-            const std::vector<ValuePtr> &args) -> ValuePtr {
-            if (args.empty() || args[0]->type != ValueType::NUMBER) {
-                return std::make_shared<NumberValue>(NAN);
-            }
-            const size_t index = static_cast<size_t>(std::static_pointer_cast<NumberValue>(args[0])->Value);
-            if (index >= self->U32Value.size()) {
-                return std::make_shared<NumberValue>(NAN);
-            }
-            return std::make_shared<NumberValue>(self->U32Value[index]);
-        };
-        return std::make_shared<NativeFunctionValue>(fn);
-    }
-    if (key == "substr") {
-        auto fn = [self = std::static_pointer_cast<StringValue>(shared_from_this())]
-        (const std::vector<ValuePtr> &args) -> ValuePtr {
-            if (args.size() != 2) Logger::Error("参数错误: substr(start, end)");
-            if (args.at(0)->type != ValueType::NUMBER || args.at(1)->type != ValueType::NUMBER) {
-                Logger::Error("参数错误: substr(Number, Number)");
-            }
-            const auto arg1 = std::static_pointer_cast<NumberValue>(args.at(0));
-            const auto arg2 = std::static_pointer_cast<NumberValue>(args.at(1));
-            auto start = static_cast<long long>(arg1->Value);
-            auto end = static_cast<long long>(arg2->Value);
-            const size_t len = self->U32Value.size();
-            if (start > len) start = len;
-            if (end > len) end = len;
-            if (start > end) {
-                Logger::Error("参数错误: substr(start, end), start 不能大于 end");
-            }
-            size_t count = end - start;
-            if (count == 0) {
-                return std::make_shared<StringValue>("");
-            }
-            std::u32string subU32 = self->U32Value.substr(start, count);
-            return std::make_shared<StringValue>(StringKit::U32ToUtf8(subU32));
-        };
-        return std::make_shared<NativeFunctionValue>(fn);
+    if (const NativeMethod *method = FindMethod(key)) {
+        return BindMethod(method);
     }
     if (Prototype) {
-        ValuePtr method = Prototype->Get(key);
-        if (method) {
-            if (method->type == ValueType::FUNCTION) {
-                auto originalFn = std::static_pointer_cast<FunctionValue>(method);
-                auto thisEnv = std::make_shared<Environment>(originalFn->Closure);
-                thisEnv->DeclareVar("this", shared_from_this());
-                return std::make_shared<FunctionValue>(originalFn->Declaration, thisEnv);
-            }
-            return method;
-        }
+        return PrototypeMember(*Prototype, key, bindThis);
     }
-
     return RuntimeValue::Get(key);
 }
 
+const NativeMethod *StringValue::FindMethod(const std::string &key) const {
+    static const std::unordered_map<std::string, NativeMethod> methods = {
+        {"charCodeAt", {ValueType::STRING, StringCharCodeAt}},
+        {"substr", {ValueType::STRING, StringSubstr}},
+    };
+    const auto it = methods.find(key);
+    return it == methods.end() ? nullptr : &it->second;
+}
+
 
 ValuePtr StringValue::InitBuiltins() {
     auto stringObj = std::make_shared<ObjectValue>();
@@ -122,5 +160,47 @@ ValuePtr StringValue::InitBuiltins() {
         }
     );
     stringObj->Set("fromCharCode", fromCharCodeFn);
+    // String.builder(): 逐段追加, 最后一次性生成字符串, 避免循环拼接时反复复制
+    const auto builderFn = std::make_shared<NativeFunctionValue>(
+        [](const std::vector<ValuePtr> &) -> ValuePtr {
+            auto buffer = std::make_shared<std::string>();
+            auto builder = std::make_shared<ObjectValue>();
+            // 方法返回 builder 本身以支持链式调用, 持有弱引用避免循环引用
+            std::weak_ptr<ObjectValue> self = builder;
+            builder->Set("append", std::make_shared<NativeFunctionValue>(
+                [buffer, self](const std::vector<ValuePtr> &args) -> ValuePtr {
+                    for (const auto &arg: args) {
+                        if (arg->type == ValueType::STRING) {
+                            buffer->append(static_cast<StringValue *>(arg.get())->Value);
+                        } else {
+                            buffer->append(arg->ToString());
+                        }
+                    }
+                    if (auto owner = self.lock()) {
+                        return owner;
+                    }
+                    return NullValue::Instance();
+                }));
+            builder->Set("length", std::make_shared<NativeFunctionValue>(
+                [buffer](const std::vector<ValuePtr> &) -> ValuePtr {
+                    // 按码点计数: 跳过 UTF-8 的后续字节
+                    const auto count = std::count_if(buffer->begin(), buffer->end(), [](const char c) {
+                        return (static_cast<unsigned char>(c) & 0xC0) != 0x80;
+                    });
+                    return NumberValue::Of(static_cast<double>(count));
+                }));
+            builder->Set("clear", std::make_shared<NativeFunctionValue>(
+                [buffer](const std::vector<ValuePtr> &) -> ValuePtr {
+                    buffer->clear();
+                    return NullValue::Instance();
+                }));
+            builder->Set("toString", std::make_shared<NativeFunctionValue>(
+                [buffer](const std::vector<ValuePtr> &) -> ValuePtr {
+                    return std::make_shared<StringValue>(*buffer);
+                }));
+            return builder;
+        }
+    );
+    stringObj->Set("builder", builderFn);
     return stringObj;
 }
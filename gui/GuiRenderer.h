@@ -78,8 +78,8 @@ class GuiRenderer {
             auto children = obj->Get("children");
             if (children && children->type == ValueType::ARRAY) {
                 const auto arr = std::static_pointer_cast<ArrayValue>(children);
-                for (const auto &child: arr->Elements) {
-                    RenderWidget(ctx, child, fontCache);
+                for (size_t i = 0; i < arr->Size(); ++i) {
+                    RenderWidget(ctx, arr->At(i), fontCache);
                 }
             }
             nk_layout_space_end(ctx);
@@ -116,7 +116,7 @@ public:
         if (const auto v = obj->Get(key); v->type == ValueType::FUNCTION) {
             return v;
         }
-        return std::make_shared<NullValue>();
+        return NullValue::Instance();
     }
 
     static bool GetBool(const std::shared_ptr<ObjectValue> &obj, const std::string &key, bool def = false) {
@@ -201,8 +201,8 @@ public:
         auto children = mainForm->Get("children");
         if (children && children->type == ValueType::ARRAY) {
             const auto arr = std::static_pointer_cast<ArrayValue>(children);
-            for (const auto &child: arr->Elements) {
-                RenderWidget(ctx, child, fontCache);
+            for (size_t i = 0; i < arr->Size(); ++i) {
+                RenderWidget(ctx, arr->At(i), fontCache);
             }
         }
         nk_layout_space_end(ctx);
@@ -199,19 +199,19 @@ void initDataBind(GLFWwindow *win) {
     glfwGetWindowSize(win, &w, &h);
     glfwGetWindowPos(win, &x, &y);
     if (w != lastW) {
-        mainForm->Set("width", std::make_shared<NumberValue>(w));
+        mainForm->Set("width", NumberValue::Of(w));
         lastW = w;
     }
     if (h != lastH) {
-        mainForm->Set("height", std::make_shared<NumberValue>(h));
+        mainForm->Set("height", NumberValue::Of(h));
         lastH = h;
     }
     if (x != lastX) {
-        mainForm->Set("x", std::make_shared<NumberValue>(x));
+        mainForm->Set("x", NumberValue::Of(x));
         lastX = x;
     }
     if (y != lastY) {
-        mainForm->Set("y", std::make_shared<NumberValue>(y));
+        mainForm->Set("y", NumberValue::Of(y));
         lastY = y;
     }
 }
@@ -13,175 +13,212 @@
 
 #include "Lexer.h"
 
-#include <iostream>
+#include <algorithm>
+#include <array>
+#include <cstdint>
 
 #include "common/KeyWord.h"
 #include "common/Symbols.h"
 
-std::string Lexer::NextChar() {
-    if (EndOfFile) {
-        return "";
+namespace {
+    enum CharClass : uint8_t {
+        OTHER, SPACE, IDENT_START, DIGIT, SYMBOL, QUOTE
+    };
+
+    constexpr std::array<uint8_t, 256> BuildCharClasses() {
+        std::array<uint8_t, 256> table{};
+        for (const char c: {' ', '\t', '\n', '\v', '\f', '\r'}) {
+            table[static_cast<uint8_t>(c)] = SPACE;
+        }
+        for (int c = 'a'; c <= 'z'; ++c) {
+            table[c] = IDENT_START;
+            table[c - 'a' + 'A'] = IDENT_START;
+        }
+        table['_'] = IDENT_START;
+        table['$'] = IDENT_START;
+        for (int c = '0'; c <= '9'; ++c) {
+            table[c] = DIGIT;
+        }
+        for (const char c: Symbols::SymbolList) {
+            table[static_cast<uint8_t>(c)] = SYMBOL;
+        }
+        table['"'] = QUOTE;
+        return table;
     }
-    if (mSourceCode.size() - 1 <= RowNum && RowPos >= mRowBuffer.size()) {
-        EndOfFile = true;
-        return "";
+
+    // 按字节查表分类, 非 ASCII 字节为 OTHER (只能出现在字符串中)
+    constexpr std::array<uint8_t, 256> CharClasses = BuildCharClasses();
+
+    CharClass ClassOf(const char c) {
+        return static_cast<CharClass>(CharClasses[static_cast<uint8_t>(c)]);
+    }
+
+    bool IsIdentPart(const char c) {
+        const CharClass cls = ClassOf(c);
+        return cls == IDENT_START || cls == DIGIT;
     }
-    if (RowPos >= mRowBuffer.size()) {
-        auto nextRow = [this] {
-            RowNum++;
-            RowPos = 0;
-            mRowBuffer = mSourceCode.at(RowNum);
-        };
-        nextRow();
-        while (mRowBuffer.empty() && RowNum < mSourceCode.size()) {
-            nextRow();
+
+}
+
+void Lexer::Position(const size_t offset, int &line, int &column) const {
+    if (lineStarts.empty()) {
+        lineStarts.push_back(0);
+        for (size_t i = 0; i < source.size(); ++i) {
+            if (source[i] == '\n') {
+                lineStarts.push_back(i + 1);
+            }
         }
     }
-    const char c = mRowBuffer.at(RowPos);
-    RowPos += 1;
-    std::string result(1, c);
-    return result;
+    const auto it = std::upper_bound(lineStarts.begin(), lineStarts.end(), offset) - 1;
+    line = static_cast<int>(it - lineStarts.begin());
+    column = static_cast<int>(offset - *it);
 }
 
-Token Lexer::NextToken() {
+std::string_view Lexer::ScanString(const size_t begin) {
+    const char *data = source.data();
+    const size_t size = source.size();
+    // 常见情况: 不含 \" 且不跨行, 直接引用源码; 其余转义原样保留, 由使用方解释
+    size_t p = begin;
+    while (p < size) {
+        const char c = data[p];
+        if (c == '"') {
+            pos = p + 1;
+            return {data + begin, p - begin};
+        }
+        if (c == '\n' || c == '\r' || (c == '\\' && (p + 1 >= size || data[p + 1] == '"' || data[p + 1] == '\n' ||
+                                                     data[p + 1] == '\r'))) {
+            break;
+        }
+        p += c == '\\' ? 2 : 1;
+    }
+    // 改写: \" 变为 ", 换行与行尾的 \r 不计入字符串
+    std::string value(data + begin, p - begin);
+    bool isEscape = false;
     while (true) {
-        std::string chaz = this->NextChar();
-        if (this->IsEndOfFile()) {
-            return Token{TokenKind(TokenKind::FILE_END), "", 0, 0};
+        if (p >= size) {
+            throw std::runtime_error("字符串未闭合");
         }
-        if (chaz.empty()) {
+        const char c = data[p++];
+        if (c == '\n' || (c == '\r' && (p >= size || data[p] == '\n'))) {
             continue;
         }
-        if (std::isalpha(chaz[0]) || chaz[0] == '_' || chaz[0] == '$') {
-            Token token{TokenKind(TokenKind::IDENTITY), chaz, Lexer::RowNum, RowPos};
-            chaz = this->NextChar();
-            while (!chaz.empty() && (std::isalnum(chaz[0]) || chaz[0] == '_' || chaz[0] == '$')) {
-                token.TokenValue += chaz;
-                chaz = this->NextChar();
+        if (isEscape) {
+            if (c != '"') {
+                value += '\\';
             }
-            this->RollBack();
-            if (KeyWord::isKeyword(token.TokenValue)) {
-                token._TokenType = TokenKind(TokenKind::KEYWORD);
-            }
-            return token;
+            value += c;
+            isEscape = false;
+        } else if (c == '\\') {
+            isEscape = true;
+        } else if (c == '"') {
+            break;
+        } else {
+            value += c;
+        }
+    }
+    pos = p;
+    return decoded.emplace_back(std::move(value));
+}
+
+Token Lexer::NextToken() {
+    const char *data = source.data();
+    const size_t size = source.size();
+    while (true) {
+        if (pos >= size) {
+            EndOfFile = true;
+            return Token{TokenKind(TokenKind::FILE_END), "", size};
         }
-        if (std::isdigit(chaz[0])) {
-            Token token{TokenKind(TokenKind::INT), chaz, Lexer::RowNum, RowPos};
-            chaz = this->NextChar();
-            while (true) {
-                if (!chaz.empty() && std::isdigit(chaz[0])) {
-                    token.TokenValue += chaz;
-                    chaz = this->NextChar();
-                    continue;
+        const size_t begin = pos;
+        const char c = data[pos++];
+        switch (ClassOf(c)) {
+            case SPACE:
+                continue;
+            case IDENT_START: {
+                while (pos < size && IsIdentPart(data[pos])) {
+                    pos++;
                 }
-                if (chaz == ".") {
-                    token.TokenValue += ".";
-                    token._TokenType = TokenKind(TokenKind::FLOAT);
-                    chaz = this->NextChar();
-                    continue;
+                const std::string_view text(data + begin, pos - begin);
+                // 关键字等指向静态表, 语法树中保存的 Token 不依赖源码
+                if (const std::string_view *word = KeyWord::Find(text)) {
+                    const bool keyword = KeyWord::isKeyword(*word);
+                    return Token{TokenKind(keyword ? TokenKind::KEYWORD : TokenKind::IDENTITY), *word, begin};
                 }
-                break;
+                return Token{TokenKind(TokenKind::IDENTITY), text, begin};
             }
-            this->RollBack();
-            return token;
-        }
-        if (chaz == R"(")") {
-            Token token{TokenKind(TokenKind::STRING), "", Lexer::RowNum, RowPos};
-            chaz = this->NextChar();
-            bool isEscape = false;
-            while (true) {
-                if (chaz.empty()) {
-                    throw std::runtime_error("字符串未闭合");
-                }
-                if (isEscape) {
-                    if (chaz == R"(")") {
-                        token.TokenValue += R"(")";
-                    } else {
-                        token.TokenValue += R"(\)" + chaz;
+            case DIGIT: {
+                TokenKind kind(TokenKind::INT);
+                while (pos < size && (ClassOf(data[pos]) == DIGIT || data[pos] == '.')) {
+                    if (data[pos] == '.') {
+                        kind = TokenKind(TokenKind::FLOAT);
                     }
-                    isEscape = false;
-                } else if (chaz == "\\") {
-                    isEscape = true;
-                } else if (chaz == R"(")") {
-                    break;
-                } else {
-                    token.TokenValue += chaz;
+                    pos++;
                 }
-                chaz = this->NextChar();
+                return Token{kind, std::string_view(data + begin, pos - begin), begin};
             }
-            return token;
-        }
-        if (Symbols::isSymbols(chaz)) {
-            Token token{TokenKind(TokenKind::SYMBOL), chaz, Lexer::RowNum, RowPos};
-            if (chaz == "=" || chaz == ">" || chaz == "<" || chaz == "!") {
-                chaz = this->NextChar();
-                if (chaz == "=") {
-                    token.TokenValue += "=";
-                } else {
-                    this->RollBack();
-                }
-            } else if (chaz == "&") {
-                chaz = this->NextChar();
-                if (chaz == "&") {
-                    token.TokenValue += "&";
-                } else {
-                    this->RollBack();
-                }
-            } else if (chaz == "|") {
-                chaz = this->NextChar();
-                if (chaz == "|") {
-                    token.TokenValue += "|";
-                } else {
-                    this->RollBack();
-                }
-            } else if (chaz == "/") {
-                chaz = this->NextChar();
-                if (chaz == "/") {
-                    this->RowPos = 999999999;
-                    // return this->NextToken();
-                    continue;
-                }
-                this->RollBack();
-            } else if (chaz == "+") {
-                chaz = this->NextChar();
-                if (chaz == "+") {
-                    token.TokenValue += "+";
-                } else if (chaz == "=") {
-                    token.TokenValue += "=";
-                } else {
-                    this->RollBack();
-                }
-            } else if (chaz == "-") {
-                chaz = this->NextChar();
-                if (chaz == "-") {
-                    token.TokenValue += "-";
-                } else if (chaz == "=") {
-                    token.TokenValue += "=";
-                } else {
-                    this->RollBack();
-                }
-            } else if (chaz == "*") {
-                chaz = this->NextChar();
-                if (chaz == "=") {
-                    token.TokenValue += "=";
-                } else {
-                    this->RollBack();
+            case QUOTE: {
+                const std::string_view text = ScanString(pos);
+                return Token{TokenKind(TokenKind::STRING), text, begin};
+            }
+            case SYMBOL: {
+                const char next = pos < size ? data[pos] : '\0';
+                std::string_view text{};
+                switch (c) {
+                    case '=':
+                        text = next == '=' ? "==" : "";
+                        break;
+                    case '>':
+                        text = next == '=' ? ">=" : "";
+                        break;
+                    case '<':
+                        text = next == '=' ? "<=" : "";
+                        break;
+                    case '!':
+                        text = next == '=' ? "!=" : "";
+                        break;
+                    case '&':
+                        text = next == '&' ? "&&" : "";
+                        break;
+                    case '|':
+                        text = next == '|' ? "||" : "";
+                        break;
+                    case '+':
+                        text = next == '+' ? "++" : next == '=' ? "+=" : "";
+                        break;
+                    case '-':
+                        text = next == '-' ? "--" : next == '=' ? "-=" : "";
+                        break;
+                    case '*':
+                        text = next == '=' ? "*=" : "";
+                        break;
+                    case '%':
+                        text = next == '=' ? "%=" : "";
+                        break;
+                    case '/':
+                        // 行注释
+                        if (next == '/') {
+                            while (pos < size && data[pos] != '\n') {
+                                pos++;
+                            }
+                            continue;
+                        }
+                        break;
+                    default:
+                        break;
                 }
-            } else if (chaz == "%") {
-                chaz = this->NextChar();
-                if (chaz == "=") {
-                    token.TokenValue += "=";
+                if (text.empty()) {
+                    text = Symbols::Text(c);
                 } else {
-                    this->RollBack();
+                    pos++;
                 }
+                return Token{TokenKind(TokenKind::SYMBOL), text, begin};
+            }
+            default: {
+                int line = 0, column = 0;
+                Position(begin, line, column);
+                throw std::runtime_error(
+                    "未知字符: '" + std::string(1, c) + "',行: " + std::to_string(line + 1) + ",列: " +
+                    std::to_string(column + 1));
             }
-            return token;
-        }
-        if (std::isspace(chaz[0])) {
-            continue;
         }
-        throw std::runtime_error(
-            "未知字符: '" + chaz + "',行: " + std::to_string(RowNum) + ",列: " + std::to_string(RowPos));
     }
-    return Token{TokenKind(TokenKind::FILE_END), "", RowNum, RowPos};
 }
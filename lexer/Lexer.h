@@ -13,47 +13,40 @@
 
 #ifndef BXSCRIPT_LEXER_H
 #define BXSCRIPT_LEXER_H
-#include <sstream>
+#include <deque>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "Token.h"
 
+// 在一整块源码上按下标扫描, Token 直接引用源码切片, 不再逐字符构造字符串
 class Lexer {
 public:
 
     Lexer() = delete;
 
-    explicit Lexer(const std::string &sourceCode)  {
-        SplitSourceCode(sourceCode);
-        if (mSourceCode.empty()) {
+    explicit Lexer(std::string sourceCode) : owned(std::move(sourceCode)), source(owned) {
+        if (source.empty()) {
             throw std::runtime_error("源码为空");
         }
-
-        RowNum = 0;
-        RowPos = 0;
-        mRowBuffer = mSourceCode.at(0);
-        EndOfFile = false;
     }
 
-    void SplitSourceCode(const std::string &code) {
-        std::stringstream ss(code);
-        std::string line;
-        while (std::getline(ss, line)) {
-            if (!line.empty() && line.back() == '\r') {
-                line.pop_back();
-            }
-            mSourceCode.push_back(line);
+    // 直接扫描外部的源码 (如映射的文件), 不复制; owner 持有这块内存, 保证扫描期间有效
+    Lexer(const std::string_view sourceCode, std::shared_ptr<const void> owner)
+        : source(sourceCode), owner(std::move(owner)) {
+        if (source.empty()) {
+            throw std::runtime_error("源码为空");
         }
     }
 
-    ~Lexer() = default;
+    Lexer(const Lexer &) = delete;
 
-    std::string NextChar();
+    Lexer &operator=(const Lexer &) = delete;
 
-    void RollBack() {
-        RowPos--;
-    }
+    ~Lexer() = default;
 
     [[nodiscard]] bool IsEndOfFile() const {
         return EndOfFile;
@@ -61,12 +54,20 @@ public:
 
     Token NextToken();
 
+    // 偏移所在的行列号 (从 0 开始), 只在报错时用到, 首次调用时才建立行首索引
+    void Position(size_t offset, int &line, int &column) const;
+
 private:
-    std::vector<std::string> mSourceCode;
-    std::string mRowBuffer;
-    int RowPos = 0;
-    int RowNum = 0;
+    std::string owned;
+    std::string_view source;
+    std::shared_ptr<const void> owner;
+    size_t pos = 0;
     bool EndOfFile = false;
+    // 含 \" 或跨行的字符串需要改写, 改写结果存放在这里, 地址不随追加变化
+    std::deque<std::string> decoded{};
+    mutable std::vector<size_t> lineStarts{};
+
+    std::string_view ScanString(size_t begin);
 };
 
 #endif //BXSCRIPT_LEXER_H
@@ -14,6 +14,7 @@
 #ifndef BXSCRIPT_TOKEN_H
 #define BXSCRIPT_TOKEN_H
 
+#include <string_view>
 #include <utility>
 
 #include "common/TokenKind.h"
@@ -21,23 +22,23 @@
 
 class Token {
 public:
-    explicit Token(const TokenKind type, std::string value, const int lineNumber, const int mColsNum)
-        : _TokenType(type), TokenValue(std::move(value)), LineNum(lineNumber), ColsNum(mColsNum) {
+    explicit Token(const TokenKind type, const std::string_view value, const size_t offset)
+        : _TokenType(type), TokenValue(value), Offset(offset) {
     }
 
     explicit Token() = default;
 
     std::string ToString() const {
-        return "TOKEN: {\"字符\": " + this->TokenValue +
-               ", \"行\": " + std::to_string(this->LineNum) +
-               ", \"列\": " + std::to_string(this->ColsNum) +
+        return "TOKEN: {\"字符\": " + std::string(this->TokenValue) +
+               ", \"偏移\": " + std::to_string(this->Offset) +
                ", \"类型\": " + this->_TokenType.ToString() + "}";
     }
 
     TokenKind _TokenType = TokenKind(TokenKind::NONE);
-    std::string TokenValue;
-    int LineNum = 0;
-    int ColsNum = 0;
+    // 源码中的切片, 只在源码存活期间有效; 关键字与运算符指向静态文本, 可以长期保存
+    std::string_view TokenValue;
+    // 在源码中的字节偏移, 行列号由 Lexer::Position 按需计算
+    size_t Offset = 0;
 };
 
 #endif //BXSCRIPT_TOKEN_H
@@ -1,9 +1,9 @@
 #include <iostream>
 #include <string>
-#include <fstream>
 #include <vector>
 
 #include "parser/Parser.h"
+#include "parser/ProgramCache.h"
 #include "evaluator/Interpreter.h"
 #include "evaluator/Environment.h"
 #include "evaluator/Value.h"
@@ -49,17 +49,6 @@ void PrintError(const std::string &msg) {
     std::cerr << "\033[31m[Error] " << msg << "\033[0m" << std::endl;
 }
 
-// 读取文件内容
-std::string ReadFile(const std::string &path) {
-    std::ifstream file(path);
-    if (!file.is_open()) {
-        throw std::runtime_error("无法打开文件: " + path);
-    }
-    std::stringstream buffer;
-    buffer << file.rdbuf();
-    return buffer.str();
-}
-
 // ==========================================
 // 模式 1: 交互式 REPL
 // ==========================================
@@ -86,18 +75,16 @@ void RunRepl() {
         try {
             // 3. 解析
             Parser parser(line);
-            auto prog = std::make_shared<Program>(parser.ParseProgram());
-
-            // 4. AST 保活 (放入注册表)
-            Interpreter::ASTRegistry.push_back(prog);
+            // 本行的语法树在执行完后释放, 定义的函数各自持有所在的 Arena
+            const Program prog = parser.ParseProgram();
 
-            // 5. 执行 (使用持久化的 env)
-            ValuePtr res = Interpreter::EvaluateProgram(*prog, env);
+            // 4. 执行 (使用持久化的 env)
+            ValuePtr res = Interpreter::EvaluateProgram(prog, env);
 
-            // 6. 打印结果
+            // 5. 打印结果
             PrintResult(res);
 
-            // 7. 顺便处理一下积压的异步任务
+            // 6. 顺便处理一下积压的异步任务
             EventLoop::Dispatch(0);
         } catch (const std::exception &e) {
             PrintError(e.what());
@@ -114,18 +101,13 @@ void RunFile(const std::string &path) {
         auto env = std::make_shared<Environment>();
         Interpreter::SetupEnvironment(env);
 
-        // 2. 读取 & 解析
-        std::string source = ReadFile(path);
-        Parser parser(source);
-        auto prog = std::make_shared<Program>(parser.ParseProgram());
+        // 2. 映射 & 解析
+        const Program prog = ProgramCache::ParseFile(path);
 
-        // 3. 保活
-        Interpreter::ASTRegistry.push_back(prog);
+        // 3. 执行
+        Interpreter::EvaluateProgram(prog, env);
 
-        // 4. 执行
-        Interpreter::EvaluateProgram(*prog, env);
-
-        // 5. 进入事件循环保活 (CLI 模式核心)
+        // 4. 进入事件循环保活 (CLI 模式核心)
         // 只有当有异步任务时，这里才会阻塞，否则直接退出
         EventLoop::RunLoop();
     } catch (const std::exception &e) {
@@ -139,8 +121,20 @@ void RunFile(const std::string &path) {
 // ==========================================
 int main(const int argc, char *argv[]) {
     SetupConsole();
-    if (argc > 1) {
-        RunFile(argv[1]);
+    int argIndex = 1;
+    // --vm: 使用字节码虚拟机执行; --no-cache: 不读写 .bxc 预编译缓存
+    for (; argc > argIndex; argIndex++) {
+        const std::string option = argv[argIndex];
+        if (option == "--vm") {
+            Interpreter::UseBytecode = true;
+        } else if (option == "--no-cache") {
+            ProgramCache::Enabled = false;
+        } else {
+            break;
+        }
+    }
+    if (argc > argIndex) {
+        RunFile(argv[argIndex]);
     } else {
         RunRepl();
         return 0;
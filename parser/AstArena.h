@@ -0,0 +1,110 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    语法树节点的区域分配
+ */
+
+#ifndef BXSCRIPT_ASTARENA_H
+#define BXSCRIPT_ASTARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// 一次解析产生的全部节点从大块内存中顺序切出, 相邻节点在内存中也相邻, 随 Arena 一起析构和释放.
+// Program 与由它创建的函数值共同持有 Arena, 最后一个持有者放手时整棵树一次性回收.
+class AstArena : public std::enable_shared_from_this<AstArena> {
+public:
+    // 节点指针不负责释放, 析构统一由 Arena 完成
+    struct Release {
+        template<typename T>
+        void operator()(T *) const noexcept {
+        }
+    };
+
+    template<typename T>
+    using Ptr = std::unique_ptr<T, Release>;
+
+    AstArena() = default;
+
+    AstArena(const AstArena &) = delete;
+
+    AstArena &operator=(const AstArena &) = delete;
+
+    ~AstArena() {
+        // 逆序析构, 与逐个 delete 时子节点先于父节点释放的顺序一致
+        for (auto it = destructors.rbegin(); it != destructors.rend(); ++it) {
+            it->second(it->first);
+        }
+        for (void *block: blocks) {
+            std::free(block);
+        }
+    }
+
+    template<typename T, typename... Args>
+    Ptr<T> New(Args &&... args) {
+        T *node = new(Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            destructors.emplace_back(node, [](void *p) { static_cast<T *>(p)->~T(); });
+        }
+        return Ptr<T>(node);
+    }
+
+    // 与语法树同生命周期的外部资源, 如解析所用的映射文件, 最后一个持有者放手时才释放
+    void Retain(std::shared_ptr<const void> resource) {
+        resources.push_back(std::move(resource));
+    }
+
+    // 已分配给节点的字节数
+    [[nodiscard]] size_t BytesUsed() const { return used; }
+
+private:
+    static constexpr size_t BlockSize = 32 * 1024;
+
+    std::vector<void *> blocks{};
+    std::vector<std::pair<void *, void (*)(void *)> > destructors{};
+    char *cursor = nullptr;
+    char *limit = nullptr;
+    size_t used = 0;
+    // 成员在析构函数体之后释放, 节点析构时仍可访问
+    std::vector<std::shared_ptr<const void> > resources{};
+
+    void *Allocate(const size_t size, const size_t align) {
+        auto p = reinterpret_cast<uintptr_t>(cursor);
+        p = (p + align - 1) & ~(static_cast<uintptr_t>(align) - 1);
+        if (!cursor || p + size > reinterpret_cast<uintptr_t>(limit)) {
+            // 超过一块的大节点单独分配
+            const size_t blockSize = size + align > BlockSize ? size + align : BlockSize;
+            void *block = std::malloc(blockSize);
+            if (!block) {
+                throw std::bad_alloc();
+            }
+            blocks.push_back(block);
+            cursor = static_cast<char *>(block);
+            limit = cursor + blockSize;
+            p = reinterpret_cast<uintptr_t>(cursor);
+            p = (p + align - 1) & ~(static_cast<uintptr_t>(align) - 1);
+        }
+        cursor = reinterpret_cast<char *>(p + size);
+        used += size;
+        return reinterpret_cast<void *>(p);
+    }
+};
+
+// 语法树中的子节点指针, 由所在 Program 的 Arena 统一析构
+template<typename T>
+using NodePtr = AstArena::Ptr<T>;
+
+#endif //BXSCRIPT_ASTARENA_H
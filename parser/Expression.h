@@ -13,19 +13,126 @@
 
 #ifndef BXSCRIPT_EXPRESSION_H
 #define BXSCRIPT_EXPRESSION_H
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "AstArena.h"
+#include "common/Atom.h"
+#include "common/PropertyCache.h"
 #include "lexer/Token.h"
 
+class BytecodeChunk;
+class RuntimeValue;
+
+// 静态作用域布局, 由 Resolver 填充: 下标即运行时 Environment 的槽位
+using ScopeLayout = std::vector<Atom>;
+
+// 语法树节点类型, 由各节点构造时写入, 解释器据此 switch 分发而不必逐个 dynamic_cast
+enum class NodeKind : uint8_t {
+    // Expression
+    ARRAY_LITERAL,
+    ASSIGN,
+    BAD_EXPRESSION,
+    BINARY,
+    BOOLEAN_LITERAL,
+    BRACKET,
+    CALL,
+    CONDITIONAL,
+    IDENTIFIER,
+    DOT,
+    EMPTY_EXPRESSION,
+    PARAMETER_LIST,
+    FUNCTION_LITERAL,
+    NULL_LITERAL,
+    NUMBER_LITERAL,
+    PROPERTY,
+    OBJECT_LITERAL,
+    SEQUENCE,
+    STRING_LITERAL,
+    THIS,
+    UNARY,
+    VARIABLE,
+    // Statement
+    BAD_STATEMENT,
+    EMPTY_STATEMENT,
+    BLOCK,
+    CATCH,
+    EXPRESSION_STATEMENT,
+    FOR_IN,
+    FOR,
+    FUNCTION_STATEMENT,
+    IF,
+    LABEL,
+    RETURN,
+    BREAK,
+    CONTINUE,
+    THROW,
+    TRY,
+    VARIABLE_STATEMENT,
+    IMPORT,
+};
+
+// 运算符种类, 构造节点时由 Token 解析一次, 执行时不再比较字符串
+enum class OperatorKind : uint8_t {
+    // 单独的 = 赋值
+    NONE,
+    ADD, SUB, MUL, DIV, MOD,
+    LT, GT, LE, GE, EQ, NE,
+    AND, OR, SHL, SHR,
+    NOT, INC, DEC, DEL,
+    UNKNOWN,
+};
+
+inline OperatorKind ToOperatorKind(const std::string_view text) {
+    static const std::pair<const char *, OperatorKind> table[] = {
+        {"+", OperatorKind::ADD}, {"-", OperatorKind::SUB}, {"*", OperatorKind::MUL},
+        {"/", OperatorKind::DIV}, {"%", OperatorKind::MOD},
+        {"<", OperatorKind::LT}, {">", OperatorKind::GT}, {"<=", OperatorKind::LE},
+        {">=", OperatorKind::GE}, {"==", OperatorKind::EQ}, {"!=", OperatorKind::NE},
+        {"&&", OperatorKind::AND}, {"||", OperatorKind::OR}, {"<<", OperatorKind::SHL},
+        {">>", OperatorKind::SHR}, {"!", OperatorKind::NOT}, {"++", OperatorKind::INC},
+        {"--", OperatorKind::DEC}, {"delete", OperatorKind::DEL},
+    };
+    for (const auto &[name, kind]: table) {
+        if (text == name) {
+            return kind;
+        }
+    }
+    return OperatorKind::UNKNOWN;
+}
+
+// 用于错误信息
+inline const char *OperatorText(const OperatorKind op) {
+    static const char *names[] = {
+        "=", "+", "-", "*", "/", "%", "<", ">", "<=", ">=", "==", "!=",
+        "&&", "||", "<<", ">>", "!", "++", "--", "delete", "?",
+    };
+    return names[static_cast<int>(op)];
+}
+
 class Expression {
 public:
+    explicit Expression(const NodeKind kind) : Kind(kind) {
+    }
+
     virtual ~Expression() = default;
+
+    const NodeKind Kind;
 };
 
 class Statement {
 public:
+    explicit Statement(const NodeKind kind) : Kind(kind) {
+    }
+
     virtual ~Statement() = default;
+
+    const NodeKind Kind;
 };
 
 class Declaration {
@@ -35,45 +142,55 @@ public:
 
 class ArrayLiteral : public Expression {
 public:
-    explicit ArrayLiteral(std::vector<std::unique_ptr<Expression> > v) : Value(std::move(v)) {
+    explicit ArrayLiteral(std::vector<NodePtr<Expression> > v) : Expression(NodeKind::ARRAY_LITERAL),
+                                                                         Value(std::move(v)) {
     }
 
-    std::vector<std::unique_ptr<Expression> > Value{};
+    std::vector<NodePtr<Expression> > Value{};
 };
 
 class AssignExpression : public Expression {
 public:
-    explicit AssignExpression(Token _operator, std::unique_ptr<Expression> left,
-                              std::unique_ptr<Expression> right) : Operator(std::move(_operator)),
+    explicit AssignExpression(Token _operator, NodePtr<Expression> left,
+                              NodePtr<Expression> right) : Expression(NodeKind::ASSIGN),
+                                                                   Operator(std::move(_operator)),
                                                                    Left(std::move(left)), Right(std::move(right)) {
+        // += 之类的复合赋值记录其中的二元运算, 单独的 = 为 NONE
+        const std::string_view text = Operator.TokenValue;
+        Op = text == "=" ? OperatorKind::NONE : ToOperatorKind(text.substr(0, text.length() - 1));
     }
 
     Token Operator{};
-    std::unique_ptr<Expression> Left{};
-    std::unique_ptr<Expression> Right{};
+    OperatorKind Op = OperatorKind::NONE;
+    NodePtr<Expression> Left{};
+    NodePtr<Expression> Right{};
 };
 
 class BadExpression : public Expression {
 public:
-    explicit BadExpression() = default;
+    explicit BadExpression() : Expression(NodeKind::BAD_EXPRESSION) {
+    }
 };
 
 class BinaryExpression : public Expression {
 public:
-    explicit BinaryExpression(Token _operator, std::unique_ptr<Expression> _left, std::unique_ptr<Expression> _right,
-                              bool comparison) : Operator(std::move(_operator)), Left(std::move(_left)),
+    explicit BinaryExpression(Token _operator, NodePtr<Expression> _left, NodePtr<Expression> _right,
+                              bool comparison) : Expression(NodeKind::BINARY),
+                                                 Operator(std::move(_operator)), Left(std::move(_left)),
                                                  Right(std::move(_right)),
-                                                 Comparison(comparison) {
+                                                 Comparison(comparison), Op(ToOperatorKind(Operator.TokenValue)) {
     }
 
     Token Operator{};
-    std::unique_ptr<Expression> Left{}, Right{};
+    NodePtr<Expression> Left{}, Right{};
     bool Comparison = false;
+    OperatorKind Op;
 };
 
 class BooleanLiteral : public Expression {
 public:
-    explicit BooleanLiteral(std::string literal, const bool v) : Literal(std::move(literal)), Value(v) {
+    explicit BooleanLiteral(std::string literal, const bool v) : Expression(NodeKind::BOOLEAN_LITERAL),
+                                                                 Literal(std::move(literal)), Value(v) {
     }
 
     std::string Literal{};
@@ -82,80 +199,104 @@ public:
 
 class BracketExpression : public Expression {
 public:
-    explicit BracketExpression(std::unique_ptr<Expression> l, std::unique_ptr<Expression> m) : Left(std::move(l)),
+    explicit BracketExpression(NodePtr<Expression> l, NodePtr<Expression> m)
+        : Expression(NodeKind::BRACKET),
+          Left(std::move(l)),
         Member(std::move(m)) {
     }
 
-    std::unique_ptr<Expression> Left{}, Member{};
+    NodePtr<Expression> Left{}, Member{};
 };
 
 class CallExpression : public Expression {
 public:
-    explicit CallExpression(std::unique_ptr<Expression> c,
-                            std::vector<std::unique_ptr<Expression> > args) : Callee(std::move(c)),
+    explicit CallExpression(NodePtr<Expression> c,
+                            std::vector<NodePtr<Expression> > args) : Expression(NodeKind::CALL),
+                                                                              Callee(std::move(c)),
                                                                               ArgumentList(std::move(args)) {
     }
 
-    std::unique_ptr<Expression> Callee{};
-    std::vector<std::unique_ptr<Expression> > ArgumentList;
+    NodePtr<Expression> Callee{};
+    std::vector<NodePtr<Expression> > ArgumentList;
 };
 
 class ConditionalExpression : public Expression {
 public:
-    explicit ConditionalExpression(std::unique_ptr<Expression> test, std::unique_ptr<Expression> ok,
-                                   std::unique_ptr<Expression> _else) : Test(std::move(test)), Ok(std::move(ok)),
+    explicit ConditionalExpression(NodePtr<Expression> test, NodePtr<Expression> ok,
+                                   NodePtr<Expression> _else) : Expression(NodeKind::CONDITIONAL),
+                                                                        Test(std::move(test)), Ok(std::move(ok)),
                                                                         Else(std::move(_else)) {
     }
 
-    std::unique_ptr<Expression> Test{}, Ok{}, Else{};
+    NodePtr<Expression> Test{}, Ok{}, Else{};
 };
 
 class Identifier : public Expression {
 public:
-    explicit Identifier(std::string name) : Name{std::move(name)} {
+    explicit Identifier(const std::string &name) : Expression(NodeKind::IDENTIFIER), Name{Atom::Intern(name)} {
     };
-    std::string Name{};
+    // 同名标识符共享驻留的名字
+    Atom Name{};
+    // Resolver 结果: 向外 Depth 层环境的第 Slot 个槽位, -1 表示按名字查找 (全局)
+    int Depth = -1, Slot = -1;
 };
 
 class DotExpression : public Expression {
 public:
-    explicit DotExpression(std::unique_ptr<Expression> l, std::unique_ptr<Identifier> id) : Left(std::move(l)),
+    explicit DotExpression(NodePtr<Expression> l, NodePtr<Identifier> id) : Expression(NodeKind::DOT),
+                                                                                            Left(std::move(l)),
         Identifier(std::move(id)) {
     }
 
-    std::unique_ptr<Expression> Left{};
-    std::unique_ptr<Identifier> Identifier{};
+    NodePtr<Expression> Left{};
+    NodePtr<Identifier> Identifier{};
+    // 读取与赋值 (obj.x = v, obj.x++) 共用的内联缓存, 执行时填充
+    mutable PropertyCache Cache{};
 };
 
 class EmptyExpression : public Expression {
 public:
+    explicit EmptyExpression() : Expression(NodeKind::EMPTY_EXPRESSION) {
+    }
+
     int Begin = 0, End = 0;
 };
 
 class ParameterList : public Expression {
 public:
-    explicit ParameterList(std::vector<std::unique_ptr<Expression> > params) : Parameters(std::move(params)) {
+    explicit ParameterList(std::vector<NodePtr<Expression> > params) : Expression(NodeKind::PARAMETER_LIST),
+                                                                               Parameters(std::move(params)) {
     }
 
-    std::vector<std::unique_ptr<Expression> > Parameters;
+    std::vector<NodePtr<Expression> > Parameters;
 };
 
 class FunctionLiteral : public Expression {
 public:
-    explicit FunctionLiteral(std::unique_ptr<Identifier> _name,
-                             std::unique_ptr<ParameterList> _params,
-                             std::unique_ptr<Statement> _body)
-        : Name(std::move(_name)), Parameters(std::move(_params)), Body(std::move(_body)) {
+    explicit FunctionLiteral(NodePtr<Identifier> _name,
+                             NodePtr<ParameterList> _params,
+                             NodePtr<Statement> _body)
+        : Expression(NodeKind::FUNCTION_LITERAL), Name(std::move(_name)), Parameters(std::move(_params)),
+          Body(std::move(_body)) {
     }
 
-    std::unique_ptr<Identifier> Name{};
-    std::unique_ptr<ParameterList> Parameters{};
-    std::unique_ptr<Statement> Body{};
+    NodePtr<Identifier> Name{};
+    NodePtr<ParameterList> Parameters{};
+    NodePtr<Statement> Body{};
+    // 参数所在的函数作用域
+    ScopeLayout Scope{};
+    // 函数 (或其内部的闭包) 用到 this 时, 在函数作用域中为它预留的槽位, 否则为 -1
+    int ThisSlot = -1;
+    // 字节码模式下函数体的编译结果, 首次调用时生成
+    std::shared_ptr<BytecodeChunk> Bytecode{};
+    std::once_flag BytecodeOnce{};
+    // 节点所在的 Arena, 函数值持有它使语法树在 Program 释放后继续存活
+    AstArena *Owner = nullptr;
 };
 
 class NullLiteral : public Expression {
 public:
-    explicit NullLiteral(std::string v) : Literal(std::move(v)) {
+    explicit NullLiteral(std::string v) : Expression(NodeKind::NULL_LITERAL), Literal(std::move(v)) {
     }
 
     std::string Literal{};
@@ -163,94 +304,122 @@ public:
 
 class NumberLiteral : public Expression {
 public:
-    explicit NumberLiteral(std::string value) : Literal(std::move(value)) {
+    explicit NumberLiteral(std::string value) : Expression(NodeKind::NUMBER_LITERAL), Literal(std::move(value)),
+                                                Value(std::stod(Literal)) {
     }
 
     std::string Literal{};
+    double Value;
+    // 不可变的常量值, 由 Resolver 生成一次, 求值时直接返回
+    std::shared_ptr<RuntimeValue> Constant{};
 };
 
 class Property : public Expression {
 public:
-    explicit Property(std::string k, std::unique_ptr<Expression> v) : Key(std::move(k)), Value(std::move(v)) {
+    explicit Property(const std::string &k, NodePtr<Expression> v) : Expression(NodeKind::PROPERTY),
+                                                                             Key(Atom::Intern(k)), Value(std::move(v)) {
     }
 
-    std::string Key{};
-    std::unique_ptr<Expression> Value{};
+    Atom Key{};
+    NodePtr<Expression> Value{};
 };
 
 class ObjectLiteral : public Expression {
 public:
-    explicit ObjectLiteral(std::vector<std::unique_ptr<Property> > v) : Value(std::move(v)) {
+    explicit ObjectLiteral(std::vector<NodePtr<Property> > v) : Expression(NodeKind::OBJECT_LITERAL),
+                                                                        Value(std::move(v)) {
     }
 
-    std::vector<std::unique_ptr<Property> > Value{};
+    std::vector<NodePtr<Property> > Value{};
 };
 
 class SequenceExpression : public Expression {
 public:
-    explicit SequenceExpression(std::vector<std::unique_ptr<Expression> > _sequence) : Sequence(std::move(_sequence)) {
+    explicit SequenceExpression(std::vector<NodePtr<Expression> > _sequence) : Expression(NodeKind::SEQUENCE),
+                                                                                       Sequence(std::move(_sequence)) {
     }
 
-    std::vector<std::unique_ptr<Expression> > Sequence{};
+    std::vector<NodePtr<Expression> > Sequence{};
 };
 
 class StringLiteral : public Expression {
 public:
-    explicit StringLiteral(std::string _literal) : Literal(std::move(_literal)) {
+    explicit StringLiteral(std::string _literal) : Expression(NodeKind::STRING_LITERAL), Literal(std::move(_literal)) {
     }
 
     std::string Literal{};
+    // 不可变的常量值, 由 Resolver 生成一次, 求值时直接返回
+    std::shared_ptr<RuntimeValue> Constant{};
 };
 
 class ThisExpression : public Expression {
 public:
-    explicit ThisExpression() {
+    explicit ThisExpression() : Expression(NodeKind::THIS) {
     }
+
+    // Resolver 结果: 所在函数作用域中存放 this 的槽位, -1 表示不在函数内 (按名字查找)
+    int Depth = -1, Slot = -1;
 };
 
 class UnaryExpression : public Expression {
 public:
-    explicit UnaryExpression(Token _operator, std::unique_ptr<Expression> operand,
-                             bool postfix) : Operator(std::move(_operator)),
+    explicit UnaryExpression(Token _operator, NodePtr<Expression> operand,
+                             bool postfix) : Expression(NodeKind::UNARY), Operator(std::move(_operator)),
                                              Operand(std::move(operand)),
-                                             Postfix(postfix) {
+                                             Postfix(postfix), Op(ToOperatorKind(Operator.TokenValue)) {
+        // delete 是普通标识符, 文本引用源码, 换成静态的运算符文本
+        if (Op != OperatorKind::UNKNOWN) {
+            Operator.TokenValue = OperatorText(Op);
+        }
     }
 
     Token Operator{};
-    std::unique_ptr<Expression> Operand{};
+    NodePtr<Expression> Operand{};
     bool Postfix = false;
+    OperatorKind Op;
 };
 
 class VariableExpression : public Expression {
 public:
-    explicit VariableExpression(std::string name, std::unique_ptr<Expression> initializer) : Name(std::move(name)),
+    explicit VariableExpression(const std::string &name, NodePtr<Expression> initializer)
+        : Expression(NodeKind::VARIABLE),
+          Name(Atom::Intern(name)),
         Initializer(std::move(initializer)) {
     }
 
-    std::string Name{};
-    std::unique_ptr<Expression> Initializer{};
+    Atom Name{};
+    NodePtr<Expression> Initializer{};
+    // 声明到当前环境的槽位, -1 表示按名字声明 (全局)
+    int Slot = -1;
 };
 
 // ================== Statement ==================
 
 class BadStatement : public Statement {
 public:
+    explicit BadStatement() : Statement(NodeKind::BAD_STATEMENT) {
+    }
+
     int From = 0, To = 0;
 };
 
 class EmptyStatement : public Statement {
 public:
-    explicit EmptyStatement() {
+    explicit EmptyStatement() : Statement(NodeKind::EMPTY_STATEMENT) {
     }
 };
 
 class BlockStatement : public Statement {
 public:
-    explicit BlockStatement(std::vector<std::unique_ptr<Statement> > _list)
-        : StatementList(std::move(_list)) {
+    explicit BlockStatement(std::vector<NodePtr<Statement> > _list)
+        : Statement(NodeKind::BLOCK), StatementList(std::move(_list)) {
     }
 
-    std::vector<std::unique_ptr<Statement> > StatementList;
+    std::vector<NodePtr<Statement> > StatementList;
+    // 为空时不创建环境, 直接使用外层环境
+    ScopeLayout Scope{};
+    // 块内有函数字面量, 环境可能被闭包持有
+    bool Captured = false;
 };
 
 // class BranchStatement : public Statement {
@@ -264,162 +433,179 @@ public:
 
 class CatchStatement : public Statement {
 public:
-    explicit CatchStatement(std::unique_ptr<Identifier> param,
-                            std::unique_ptr<Statement> state) : Parameter(std::move(param)),
+    explicit CatchStatement(NodePtr<Identifier> param,
+                            NodePtr<Statement> state) : Statement(NodeKind::CATCH), Parameter(std::move(param)),
                                                                 Body(std::move(state)) {
     }
 
-    std::unique_ptr<Identifier> Parameter{};
-    std::unique_ptr<Statement> Body{};
+    NodePtr<Identifier> Parameter{};
+    NodePtr<Statement> Body{};
+    ScopeLayout Scope{};
 };
 
 class ExpressionStatement : public Statement {
 public:
-    explicit ExpressionStatement(std::unique_ptr<Expression> expression)
-        : Expression(std::move(expression)) {
+    explicit ExpressionStatement(NodePtr<Expression> expression)
+        : Statement(NodeKind::EXPRESSION_STATEMENT), Expression(std::move(expression)) {
     }
 
-    std::unique_ptr<Expression> Expression{};
+    NodePtr<Expression> Expression{};
 };
 
 class ForInStatement : public Statement {
 public:
-    explicit ForInStatement(std::unique_ptr<Expression> _into, std::unique_ptr<Expression> _source,
-                            std::unique_ptr<Statement> _body)
-        : Into(std::move(_into)), Source(std::move(_source)), Body(std::move(_body)) {
+    explicit ForInStatement(NodePtr<Expression> _into, NodePtr<Expression> _source,
+                            NodePtr<Statement> _body)
+        : Statement(NodeKind::FOR_IN), Into(std::move(_into)), Source(std::move(_source)), Body(std::move(_body)) {
     }
 
-    std::unique_ptr<Expression> Into{}, Source{};
-    std::unique_ptr<Statement> Body{};
+    NodePtr<Expression> Into{}, Source{};
+    NodePtr<Statement> Body{};
 };
 
 class ForStatement : public Statement {
 public:
-    explicit ForStatement(std::unique_ptr<Expression> _initializer,
-                          std::unique_ptr<Expression> _update,
-                          std::unique_ptr<Expression> _test,
-                          std::unique_ptr<Statement> _body) : Initializer(std::move(_initializer)),
+    explicit ForStatement(NodePtr<Expression> _initializer,
+                          NodePtr<Expression> _update,
+                          NodePtr<Expression> _test,
+                          NodePtr<Statement> _body) : Statement(NodeKind::FOR),
+                                                              Initializer(std::move(_initializer)),
                                                               Update(std::move(_update)),
                                                               Test(std::move(_test)),
                                                               Body(std::move(_body)) {
     }
 
-    std::unique_ptr<Expression> Initializer{}, Update{}, Test{};
-    std::unique_ptr<Statement> Body{};
+    NodePtr<Expression> Initializer{}, Update{}, Test{};
+    NodePtr<Statement> Body{};
+    // 初始化语句所在的 loopEnv 与每轮的 iterationEnv
+    ScopeLayout LoopScope{}, IterationScope{};
 };
 
 class FunctionStatement : public Statement {
 public:
-    explicit FunctionStatement(std::unique_ptr<FunctionLiteral> _func) : Function(std::move(_func)) {
+    explicit FunctionStatement(NodePtr<FunctionLiteral> _func) : Statement(NodeKind::FUNCTION_STATEMENT),
+                                                                         Function(std::move(_func)) {
     }
 
-    std::unique_ptr<FunctionLiteral> Function{};
+    NodePtr<FunctionLiteral> Function{};
 };
 
 class IfStatement : public Statement {
 public:
     explicit IfStatement(
-        std::unique_ptr<Expression> _condition,
-        std::unique_ptr<Statement> _ok,
-        std::unique_ptr<Statement> _else = nullptr,
-        std::unique_ptr<Statement> _elseIf = nullptr
+        NodePtr<Expression> _condition,
+        NodePtr<Statement> _ok,
+        NodePtr<Statement> _else = nullptr,
+        NodePtr<Statement> _elseIf = nullptr
     )
-        : Condition(std::move(_condition)), Ok(std::move(_ok)), Else(std::move(_else)), ElseIf(std::move(_elseIf)) {
+        : Statement(NodeKind::IF), Condition(std::move(_condition)), Ok(std::move(_ok)), Else(std::move(_else)),
+          ElseIf(std::move(_elseIf)) {
     }
 
-    std::unique_ptr<Expression> Condition{};
-    std::unique_ptr<Statement> Ok{}, Else{}, ElseIf{};
+    NodePtr<Expression> Condition{};
+    NodePtr<Statement> Ok{}, Else{}, ElseIf{};
 };
 
 class LabelStatement : public Statement {
 public:
-    std::unique_ptr<Identifier> Label{};
-    std::unique_ptr<Statement> Statement{};
+    explicit LabelStatement() : ::Statement(NodeKind::LABEL) {
+    }
+
+    NodePtr<Identifier> Label{};
+    NodePtr<Statement> Statement{};
 };
 
 class ReturnStatement : public Statement {
 public:
-    explicit ReturnStatement(std::unique_ptr<Expression> _arg) : Argument(std::move(_arg)) {
+    explicit ReturnStatement(NodePtr<Expression> _arg) : Statement(NodeKind::RETURN),
+                                                                 Argument(std::move(_arg)) {
     }
 
-    std::unique_ptr<Expression> Argument{};
+    NodePtr<Expression> Argument{};
 };
 
 class BreakStatement : public Statement {
 public:
-    explicit BreakStatement() = default;
+    explicit BreakStatement() : Statement(NodeKind::BREAK) {
+    }
 };
 
 class ContinueStatement : public Statement {
 public:
-    explicit ContinueStatement() = default;
+    explicit ContinueStatement() : Statement(NodeKind::CONTINUE) {
+    }
 };
 
 class ThrowStatement : public Statement {
 public:
-    explicit ThrowStatement(std::unique_ptr<Expression> _arg) : Argument(std::move(_arg)) {
+    explicit ThrowStatement(NodePtr<Expression> _arg) : Statement(NodeKind::THROW), Argument(std::move(_arg)) {
     }
 
-    std::unique_ptr<Expression> Argument{};
+    NodePtr<Expression> Argument{};
 };
 
 class TryStatement : public Statement {
 public:
-    explicit TryStatement(std::unique_ptr<Statement> body, std::unique_ptr<CatchStatement> _catch,
-                          std::unique_ptr<Statement> _finally) : Body(std::move(body)),
+    explicit TryStatement(NodePtr<Statement> body, NodePtr<CatchStatement> _catch,
+                          NodePtr<Statement> _finally) : Statement(NodeKind::TRY), Body(std::move(body)),
                                                                  Catch(std::move(_catch)),
                                                                  Finally(std::move(_finally)) {
     }
 
-    std::unique_ptr<Statement> Body{};
-    std::unique_ptr<CatchStatement> Catch{};
-    std::unique_ptr<Statement> Finally{};
+    NodePtr<Statement> Body{};
+    NodePtr<CatchStatement> Catch{};
+    NodePtr<Statement> Finally{};
 };
 
 class VariableStatement : public Statement {
 public:
-    explicit VariableStatement(std::vector<std::unique_ptr<Expression> > _variable) : List(std::move(_variable)) {
+    explicit VariableStatement(std::vector<NodePtr<Expression> > _variable)
+        : Statement(NodeKind::VARIABLE_STATEMENT),
+          List(std::move(_variable)) {
     }
 
-    std::vector<std::unique_ptr<Expression> > List{};
+    std::vector<NodePtr<Expression> > List{};
 };
 
 class ImportStatement : public Statement {
 public:
-    explicit ImportStatement(std::vector<std::string> _path, std::string _aliasName)
-        : Path(std::move(_path)), AliasName(std::move(_aliasName)) {
+    explicit ImportStatement(std::vector<std::string> _path, const std::string &_aliasName)
+        : Statement(NodeKind::IMPORT), Path(std::move(_path)), AliasName(Atom::Intern(_aliasName)) {
     }
 
     std::vector<std::string> Path;
-    std::string AliasName{};
+    Atom AliasName{};
 };
 
 // =================== Declaration =================== //
 
 class FunctionDeclaration : public Declaration {
 public:
-    explicit FunctionDeclaration(std::unique_ptr<FunctionLiteral> _function) : Function(std::move(_function)) {
+    explicit FunctionDeclaration(NodePtr<FunctionLiteral> _function) : Function(std::move(_function)) {
     }
 
-    std::unique_ptr<FunctionLiteral> Function{};
+    NodePtr<FunctionLiteral> Function{};
 };
 
 class VariableDeclaration : public Declaration {
 public:
-    std::vector<std::unique_ptr<VariableExpression> > List{};
+    std::vector<NodePtr<VariableExpression> > List{};
 };
 
 class Program {
 public:
     explicit Program() = default;
 
-    explicit Program(std::vector<std::unique_ptr<Statement> > _body,
-                     std::vector<std::unique_ptr<ImportStatement> > _import) : Body(std::move(_body)),
-                                                                               Imports(std::move(_import)) {
+    explicit Program(std::vector<NodePtr<Statement> > _body,
+                     std::vector<NodePtr<ImportStatement> > _import,
+                     std::shared_ptr<AstArena> _arena) : Arena(std::move(_arena)), Body(std::move(_body)),
+                                                         Imports(std::move(_import)) {
     }
 
-    std::vector<std::unique_ptr<Statement> > Body{};
-    std::vector<std::unique_ptr<ImportStatement> > Imports{};
+    // 全部节点的所有者, 比 Body 先声明因而后析构
+    std::shared_ptr<AstArena> Arena{};
+    std::vector<NodePtr<Statement> > Body{};
+    std::vector<NodePtr<ImportStatement> > Imports{};
 };
 
 #endif //BXSCRIPT_EXPRESSION_H
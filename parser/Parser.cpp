@@ -12,6 +12,7 @@
  */
 
 #include "Parser.h"
+#include "Resolver.h"
 #include "lexer/Lexer.h"
 
 Token Parser::NextToken() {
@@ -28,7 +29,7 @@ void Parser::BackToken(const Token &token) {
 }
 
 Program Parser::ParserSourceCode(const std::string &code) {
-    std::vector<std::unique_ptr<Statement> > body{};
+    std::vector<NodePtr<Statement> > body{};
     Token token = this->NextToken();
     while (token._TokenType.GetEnum() != TokenKind::FILE_END) {
         body.push_back(this->ParseStatement());
@@ -37,16 +38,18 @@ Program Parser::ParserSourceCode(const std::string &code) {
             this->BackToken(token);
         }
     }
-    std::vector<std::unique_ptr<FunctionDeclaration> > DeclarationList{};
-    std::vector<std::unique_ptr<ImportStatement> > imports{};
+    std::vector<NodePtr<FunctionDeclaration> > DeclarationList{};
+    std::vector<NodePtr<ImportStatement> > imports{};
     Program pro{};
+    pro.Arena = this->arena;
     pro.Body = std::move(body);
     pro.Imports = std::move(imports);
+    Resolver::ResolveProgram(pro);
     return pro;
 }
 
 // import win.ui as ui;
-std::unique_ptr<Statement> Parser::ParseImportStatements() {
+NodePtr<Statement> Parser::ParseImportStatements() {
     auto tk = this->NextToken(); // 此处tk = import
     tk = this->NextToken(); // 此处tk 应该为 identity
     if (tk._TokenType.GetEnum() != TokenKind::IDENTITY) {
@@ -54,7 +57,7 @@ std::unique_ptr<Statement> Parser::ParseImportStatements() {
     }
     std::string alias{};
     std::vector<std::string> body{};
-    body.push_back(tk.TokenValue);
+    body.push_back(std::string(tk.TokenValue));
     while (true) {
         tk = this->NextToken();
         if (tk.TokenValue == ".") {
@@ -62,7 +65,7 @@ std::unique_ptr<Statement> Parser::ParseImportStatements() {
             if (tk._TokenType.GetEnum() != TokenKind::IDENTITY) {
                 Error(tk, "import语句错误");
             }
-            body.push_back(tk.TokenValue);
+            body.push_back(std::string(tk.TokenValue));
             continue;
         }
         break;
@@ -80,19 +83,19 @@ std::unique_ptr<Statement> Parser::ParseImportStatements() {
     } else {
         Error(tk, "import语句错误: 必须包含别名,格式 import x.x as A;");
     }
-    auto impt = make_unique<ImportStatement>(body, alias);
+    auto impt = Make<ImportStatement>(body, alias);
     this->VM->imports.push_back(std::move(impt));
-    return make_unique<EmptyStatement>();
+    return Make<EmptyStatement>();
 }
 
-std::unique_ptr<Statement> Parser::ParseStatement() {
+NodePtr<Statement> Parser::ParseStatement() {
     const auto tk = this->NextToken();
     // 此处不BACK,因为没有消耗
     if (tk.TokenValue == ";") {
-        return make_unique<EmptyStatement>();
+        return Make<EmptyStatement>();
     }
     if (tk._TokenType.GetEnum() == TokenKind::FILE_END) {
-        return make_unique<ExpressionStatement>(make_unique<BadExpression>());
+        return Make<ExpressionStatement>(Make<BadExpression>());
     }
     this->BackToken(tk);
     if (tk.TokenValue == "{") {
@@ -131,30 +134,30 @@ std::unique_ptr<Statement> Parser::ParseStatement() {
     if (tk.TokenValue == "return") {
         return this->ParseReturnStatement();
     }
-    auto expState = make_unique<ExpressionStatement>(ParseExpression());
+    auto expState = Make<ExpressionStatement>(ParseExpression());
     this->Semicolon();
     return expState;
 }
 
-std::unique_ptr<Statement> Parser::ParseBlockStatement() {
+NodePtr<Statement> Parser::ParseBlockStatement() {
     auto tk = this->NextToken();
     if (tk.TokenValue != "{") {
         Error(tk, "此处期望{");
     }
-    std::vector<std::unique_ptr<Statement> > statementList{};
+    std::vector<NodePtr<Statement> > statementList{};
     while (true) {
         tk = this->NextToken();
         if (tk.TokenValue == "}") break;
         this->BackToken(tk);
         statementList.push_back(this->ParseStatement());
     }
-    return make_unique<BlockStatement>(std::move(statementList));
+    return Make<BlockStatement>(std::move(statementList));
 }
 
-std::unique_ptr<Statement> Parser::ParseIfStatement() {
-    std::unique_ptr<Statement> ok = nullptr;
-    std::unique_ptr<Statement> _else = nullptr;
-    std::unique_ptr<Statement> _elseif = nullptr;
+NodePtr<Statement> Parser::ParseIfStatement() {
+    NodePtr<Statement> ok = nullptr;
+    NodePtr<Statement> _else = nullptr;
+    NodePtr<Statement> _elseif = nullptr;
 
     auto tk = this->NextToken(); // if
     tk = this->NextToken();
@@ -193,10 +196,10 @@ std::unique_ptr<Statement> Parser::ParseIfStatement() {
     } else {
         this->BackToken(tk1);
     }
-    return make_unique<IfStatement>(std::move(condition), std::move(ok), std::move(_else), std::move(_elseif));
+    return Make<IfStatement>(std::move(condition), std::move(ok), std::move(_else), std::move(_elseif));
 }
 
-std::unique_ptr<Statement> Parser::ParseForOrForInStatement() {
+NodePtr<Statement> Parser::ParseForOrForInStatement() {
     this->OpenPVM()->InFor = true;
     auto tk = this->NextToken(); // for
     tk = this->NextToken(); // (
@@ -204,7 +207,7 @@ std::unique_ptr<Statement> Parser::ParseForOrForInStatement() {
         Error(tk, "for语句错误: for后应为(");
     }
     bool isForIn = false;
-    std::vector<std::unique_ptr<Expression> > leftExpressions{};
+    std::vector<NodePtr<Expression> > leftExpressions{};
     // 可能是let i = 0; for(;i<10;i++){}, 此处解析for()
     tk = this->NextToken();
     if (tk.TokenValue != ";") {
@@ -233,10 +236,7 @@ std::unique_ptr<Statement> Parser::ParseForOrForInStatement() {
     // 解析for in
     if (isForIn) {
         auto exp = std::move(leftExpressions.at(0));
-        if (!dynamic_cast<Identifier *>(exp.get())
-            && !dynamic_cast<DotExpression *>(exp.get())
-            && !dynamic_cast<BracketExpression *>(exp.get())
-            && !dynamic_cast<VariableExpression *>(exp.get())) {
+        if (!IsAssignable(exp.get()) && exp->Kind != NodeKind::VARIABLE) {
             Error(tk, "for语句错误: for-in左侧表达式必须是(标识符、属性访问表达式、变量表达式)");
         }
         auto inSource = this->ParseExpression();
@@ -247,14 +247,14 @@ std::unique_ptr<Statement> Parser::ParseForOrForInStatement() {
         // 解析器是否进入for 用来判断是否可以解析break, continue
         auto body = this->ParseStatement();
         this->ClosePVM();
-        return make_unique<ForInStatement>(std::move(exp), std::move(inSource), std::move(body));
+        return Make<ForInStatement>(std::move(exp), std::move(inSource), std::move(body));
     }
     if (tk.TokenValue != ";") {
         Error(tk, "此处期望: ;");
     }
-    auto initializer = make_unique<SequenceExpression>(std::move(leftExpressions));
-    std::unique_ptr<Expression> test{};
-    std::unique_ptr<Expression> updater{};
+    auto initializer = Make<SequenceExpression>(std::move(leftExpressions));
+    NodePtr<Expression> test{};
+    NodePtr<Expression> updater{};
     tk = this->NextToken();
     if (tk.TokenValue != ";") {
         this->BackToken(tk);
@@ -275,10 +275,10 @@ std::unique_ptr<Statement> Parser::ParseForOrForInStatement() {
     }
     auto body = this->ParseStatement();
     this->ClosePVM();
-    return make_unique<ForStatement>(std::move(initializer), std::move(updater), std::move(test), std::move(body));
+    return Make<ForStatement>(std::move(initializer), std::move(updater), std::move(test), std::move(body));
 }
 
-std::unique_ptr<Statement> Parser::ParseWhileStatement() {
+NodePtr<Statement> Parser::ParseWhileStatement() {
     this->OpenPVM()->InFor = true;
     auto tk = this->NextToken(); // while
     tk = this->NextToken();
@@ -292,11 +292,11 @@ std::unique_ptr<Statement> Parser::ParseWhileStatement() {
     }
     auto body = this->ParseStatement();
     this->ClosePVM();
-    return make_unique<ForStatement>(nullptr, nullptr, std::move(condition), std::move(body));
+    return Make<ForStatement>(nullptr, nullptr, std::move(condition), std::move(body));
 }
 
 // 通过BranchStatement的token内容判断是Break还是Continue
-std::unique_ptr<BreakStatement> Parser::ParseBreakStatement() {
+NodePtr<BreakStatement> Parser::ParseBreakStatement() {
     auto tk = this->NextToken();
     if (!this->VM->InFor) {
         Error(tk, "break应在for语句中");
@@ -312,11 +312,11 @@ std::unique_ptr<BreakStatement> Parser::ParseBreakStatement() {
             this->BackToken(tk);
         }
     }
-    return make_unique<BreakStatement>();
+    return Make<BreakStatement>();
 }
 
 // 通过BranchStatement的token内容判断是Break还是Continue
-std::unique_ptr<ContinueStatement> Parser::ParseContinueStatement() {
+NodePtr<ContinueStatement> Parser::ParseContinueStatement() {
     auto tk = this->NextToken();
     if (!this->VM->InFor) {
         Error(tk, "continue应在for语句中");
@@ -332,10 +332,10 @@ std::unique_ptr<ContinueStatement> Parser::ParseContinueStatement() {
             this->BackToken(tk);
         }
     }
-    return make_unique<ContinueStatement>();
+    return Make<ContinueStatement>();
 }
 
-std::unique_ptr<ReturnStatement> Parser::ParseReturnStatement() {
+NodePtr<ReturnStatement> Parser::ParseReturnStatement() {
     auto tk = this->NextToken();
     if (!this->VM->InFunc) {
         Error(tk, "return应在function语句中");
@@ -343,7 +343,7 @@ std::unique_ptr<ReturnStatement> Parser::ParseReturnStatement() {
     if (tk.TokenValue != "return") {
         Error(tk, "此处期望: return");
     }
-    std::unique_ptr<Expression> arg = nullptr; // 默认为空
+    NodePtr<Expression> arg = nullptr; // 默认为空
     tk = this->NextToken();
     if (tk.TokenValue == ";" || tk.TokenValue == "}") {
         if (tk.TokenValue == ";") {
@@ -361,33 +361,36 @@ std::unique_ptr<ReturnStatement> Parser::ParseReturnStatement() {
             Error(tk, "return语句应以;或}结束");
         }
     }
-    return make_unique<ReturnStatement>(std::move(arg));
+    return Make<ReturnStatement>(std::move(arg));
 }
 
-std::unique_ptr<Statement> Parser::ParseVariableStatement() {
+NodePtr<Statement> Parser::ParseVariableStatement() {
     const auto tk = this->NextToken();
     if (tk.TokenValue != "let") {
         Error(tk, "此处期望: let");
     }
     auto vars = this->ParseVariableDeclarationList();
-    auto varState = make_unique<VariableStatement>(std::move(vars));
+    auto varState = Make<VariableStatement>(std::move(vars));
     this->Semicolon();
     return std::move(varState);
 }
 
-std::unique_ptr<Statement> Parser::ParseFunctionStatement() {
-    auto func = make_unique<FunctionStatement>(this->ParseFunction(false));
+NodePtr<Statement> Parser::ParseFunctionStatement() {
+    auto func = Make<FunctionStatement>(this->ParseFunction(false));
     return func;
 }
 
-std::unique_ptr<ParameterList> Parser::ParseParameterList() {
-    auto params = std::vector<std::unique_ptr<Expression> >();
+NodePtr<ParameterList> Parser::ParseParameterList() {
+    auto params = std::vector<NodePtr<Expression> >();
     auto tk = this->NextToken();
     if (tk.TokenValue == "(") {
         tk = this->NextToken();
         while (tk.TokenValue != ")") {
             this->BackToken(tk);
             auto exp = this->ParsePrimaryExpression();
+            if (exp->Kind != NodeKind::IDENTIFIER) {
+                Error(tk, "参数必须是标识符");
+            }
             params.push_back(std::move(exp));
             tk = this->NextToken();
             if (tk.TokenValue != ")") {
@@ -400,16 +403,16 @@ std::unique_ptr<ParameterList> Parser::ParseParameterList() {
     } else {
         Error(tk, "参数列表应该以(开始");
     }
-    return make_unique<ParameterList>(std::move(params));
+    return Make<ParameterList>(std::move(params));
 }
 
-std::unique_ptr<FunctionLiteral> Parser::ParseFunction(const bool isAnonymous) {
+NodePtr<FunctionLiteral> Parser::ParseFunction(const bool isAnonymous) {
     auto tk = this->NextToken();
     if (tk.TokenValue != "function") {
         Error(tk, "此处期望: function");
     }
     tk = this->NextToken();
-    auto name = make_unique<Identifier>("");
+    auto name = Make<Identifier>("");
     if (tk._TokenType.GetEnum() == TokenKind::IDENTITY) {
         if (isAnonymous) {
             Error(tk, "声明式函数需要函数名");
@@ -421,10 +424,12 @@ std::unique_ptr<FunctionLiteral> Parser::ParseFunction(const bool isAnonymous) {
     }
     auto params = this->ParseParameterList();
     auto body = this->ParseFunctionBlock();
-    return make_unique<FunctionLiteral>(std::move(name), std::move(params), std::move(body));
+    auto func = Make<FunctionLiteral>(std::move(name), std::move(params), std::move(body));
+    func->Owner = this->arena.get();
+    return func;
 }
 
-std::unique_ptr<Statement> Parser::ParseFunctionBlock() {
+NodePtr<Statement> Parser::ParseFunctionBlock() {
     this->OpenPVM();
     this->VM->InFunc = true;
     auto body = this->ParseBlockStatement();
@@ -432,26 +437,26 @@ std::unique_ptr<Statement> Parser::ParseFunctionBlock() {
     return std::move(body);
 }
 
-std::unique_ptr<Statement> Parser::ParseThrowStatement() {
+NodePtr<Statement> Parser::ParseThrowStatement() {
     const auto tk = this->NextToken();
     if (tk.TokenValue != "throw") {
         Error(tk, "此处期望: throw");
     }
-    auto throwState = make_unique<ThrowStatement>(this->ParseExpression());
+    auto throwState = Make<ThrowStatement>(this->ParseExpression());
     this->Semicolon();
     return std::move(throwState);
 }
 
-std::unique_ptr<Statement> Parser::ParseTryStatement() {
+NodePtr<Statement> Parser::ParseTryStatement() {
     auto tk = this->NextToken();
     if (tk.TokenValue != "try") {
         Error(tk, "此处期望: try");
     }
     // 解析try
     auto tryBody = this->ParseBlockStatement();
-    std::unique_ptr<Identifier> catchParam{};
-    std::unique_ptr<Statement> catchBody{};
-    std::unique_ptr<Statement> finally{};
+    NodePtr<Identifier> catchParam{};
+    NodePtr<Statement> catchBody{};
+    NodePtr<Statement> finally{};
     tk = this->NextToken();
     if (tk.TokenValue != "catch") {
         Error(tk, "此处期望: catch");
@@ -481,15 +486,15 @@ std::unique_ptr<Statement> Parser::ParseTryStatement() {
     } else {
         this->BackToken(tk);
     }
-    auto _catch = make_unique<CatchStatement>(std::move(catchParam), std::move(catchBody));
-    return make_unique<TryStatement>(std::move(tryBody), std::move(_catch), std::move(finally));
+    auto _catch = Make<CatchStatement>(std::move(catchParam), std::move(catchBody));
+    return Make<TryStatement>(std::move(tryBody), std::move(_catch), std::move(finally));
 }
 
-std::unique_ptr<Expression> Parser::ParseExpression() {
+NodePtr<Expression> Parser::ParseExpression() {
     auto next = this->ParseAssignmentExpression();
     auto tk = this->NextToken();
     if (tk.TokenValue == ",") {
-        auto sequence = std::vector<std::unique_ptr<Expression> >{};
+        auto sequence = std::vector<NodePtr<Expression> >{};
         sequence.push_back(std::move(next));
         while (true) {
             if (tk.TokenValue != ",") {
@@ -498,27 +503,27 @@ std::unique_ptr<Expression> Parser::ParseExpression() {
             tk = this->NextToken();
             sequence.push_back(std::move(this->ParseAssignmentExpression()));
         }
-        return make_unique<SequenceExpression>(std::move(sequence));
+        return Make<SequenceExpression>(std::move(sequence));
     }
     this->BackToken(tk);
     return std::move(next);
 }
 
-std::unique_ptr<Identifier> Parser::ParseIdentifier() {
+NodePtr<Identifier> Parser::ParseIdentifier() {
     auto tk = this->NextToken();
-    return make_unique<Identifier>(tk.TokenValue);
+    return Make<Identifier>(std::string(tk.TokenValue));
 }
 
-std::unique_ptr<Expression> Parser::ParsePrimaryExpression() {
+NodePtr<Expression> Parser::ParsePrimaryExpression() {
     auto tk = this->NextToken();
     if (tk._TokenType.GetEnum() == TokenKind::IDENTITY) {
-        return make_unique<Identifier>(tk.TokenValue);
+        return Make<Identifier>(std::string(tk.TokenValue));
     }
     if (tk._TokenType.GetEnum() == TokenKind::STRING) {
-        return make_unique<StringLiteral>(tk.TokenValue);
+        return Make<StringLiteral>(std::string(tk.TokenValue));
     }
     if (tk._TokenType.GetEnum() == TokenKind::INT || tk._TokenType.GetEnum() == TokenKind::FLOAT) {
-        return make_unique<NumberLiteral>(tk.TokenValue);
+        return Make<NumberLiteral>(std::string(tk.TokenValue));
     }
     if (tk.TokenValue == "{") {
         this->BackToken(tk);
@@ -538,41 +543,41 @@ std::unique_ptr<Expression> Parser::ParsePrimaryExpression() {
     }
     if (tk._TokenType.GetEnum() == TokenKind::KEYWORD) {
         if (tk.TokenValue == "null") {
-            return make_unique<NullLiteral>("null");
+            return Make<NullLiteral>("null");
         }
         if (tk.TokenValue == "true" || tk.TokenValue == "false") {
-            return make_unique<BooleanLiteral>(tk.TokenValue, tk.TokenValue == "true");
+            return Make<BooleanLiteral>(std::string(tk.TokenValue), tk.TokenValue == "true");
         }
         if (tk.TokenValue == "this") {
-            return make_unique<ThisExpression>();
+            return Make<ThisExpression>();
         }
         if (tk.TokenValue == "function") {
             this->BackToken(tk);
             return this->ParseFunction(true);
         }
     }
-    return make_unique<BadExpression>();
+    return Make<BadExpression>();
 }
 
-std::unique_ptr<VariableExpression> Parser::ParseVariableDeclaration() {
+NodePtr<VariableExpression> Parser::ParseVariableDeclaration() {
     auto tk = this->NextToken();
     if (tk._TokenType.GetEnum() != TokenKind::IDENTITY) {
         Error(tk, "此处期望: 标识符");
     }
-    auto literal = tk.TokenValue;
-    std::unique_ptr<Expression> initializer = nullptr;
+    auto literal = std::string(tk.TokenValue);
+    NodePtr<Expression> initializer = nullptr;
     tk = this->NextToken();
     if (tk.TokenValue == "=") {
         initializer = this->ParseAssignmentExpression();
     } else {
         this->BackToken(tk);
     }
-    return make_unique<VariableExpression>(std::move(literal), std::move(initializer));
+    return Make<VariableExpression>(std::move(literal), std::move(initializer));
 }
 
 
-std::vector<std::unique_ptr<Expression> > Parser::ParseVariableDeclarationList() {
-    auto exps = std::vector<std::unique_ptr<Expression> >{};
+std::vector<NodePtr<Expression> > Parser::ParseVariableDeclarationList() {
+    auto exps = std::vector<NodePtr<Expression> >{};
     while (true) {
         auto exp = this->ParseVariableDeclaration();
         exps.push_back(std::move(exp));
@@ -586,20 +591,20 @@ std::vector<std::unique_ptr<Expression> > Parser::ParseVariableDeclarationList()
 }
 
 std::string Parser::ParseObjectPropertyKey() {
-    return this->NextToken().TokenValue;
+    return std::string(this->NextToken().TokenValue);
 }
 
-std::unique_ptr<Property> Parser::ParseObjectProperty() {
+NodePtr<Property> Parser::ParseObjectProperty() {
     auto k = this->ParseObjectPropertyKey();
     const auto tk = this->NextToken();
     if (tk.TokenValue != ":") {
         Error(tk, "此处期望: :");
     }
-    return make_unique<Property>(std::move(k), std::move(this->ParseAssignmentExpression()));
+    return Make<Property>(std::move(k), std::move(this->ParseAssignmentExpression()));
 }
 
-std::unique_ptr<Expression> Parser::ParseObjectLiteral() {
-    std::vector<std::unique_ptr<Property> > props{};
+NodePtr<Expression> Parser::ParseObjectLiteral() {
+    std::vector<NodePtr<Property> > props{};
     auto tk = this->NextToken();
     if (tk.TokenValue != "{") {
         Error(tk, "此处期望: {");
@@ -620,11 +625,11 @@ std::unique_ptr<Expression> Parser::ParseObjectLiteral() {
             }
         }
     }
-    return make_unique<ObjectLiteral>(std::move(props));
+    return Make<ObjectLiteral>(std::move(props));
 }
 
-std::unique_ptr<Expression> Parser::ParseArrayLiteral() {
-    std::vector<std::unique_ptr<Expression> > exps{};
+NodePtr<Expression> Parser::ParseArrayLiteral() {
+    std::vector<NodePtr<Expression> > exps{};
     auto tk = this->NextToken(); // [
     tk = this->NextToken();
     while (tk.TokenValue != "]") {
@@ -640,11 +645,11 @@ std::unique_ptr<Expression> Parser::ParseArrayLiteral() {
             Error(tk, "此处期望: ,或]");
         }
     }
-    return make_unique<ArrayLiteral>(std::move(exps));
+    return Make<ArrayLiteral>(std::move(exps));
 }
 
-std::vector<std::unique_ptr<Expression> > Parser::ParseArgumentList() {
-    std::vector<std::unique_ptr<Expression> > exps{};
+std::vector<NodePtr<Expression> > Parser::ParseArgumentList() {
+    std::vector<NodePtr<Expression> > exps{};
     auto tk = this->NextToken();
     if (tk.TokenValue != "(") {
         Error(tk, "此处期望: (");
@@ -665,12 +670,12 @@ std::vector<std::unique_ptr<Expression> > Parser::ParseArgumentList() {
     return exps;
 }
 
-std::unique_ptr<Expression> Parser::ParseCallExpression(std::unique_ptr<Expression> left) {
+NodePtr<Expression> Parser::ParseCallExpression(NodePtr<Expression> left) {
     auto args = this->ParseArgumentList();
-    return make_unique<CallExpression>(std::move(left), std::move(args));
+    return Make<CallExpression>(std::move(left), std::move(args));
 }
 
-std::unique_ptr<Expression> Parser::ParseDotMember(std::unique_ptr<Expression> left) {
+NodePtr<Expression> Parser::ParseDotMember(NodePtr<Expression> left) {
     auto tk = this->NextToken();
     if (tk.TokenValue != ".") {
         Error(tk, "此处期望: .");
@@ -679,10 +684,10 @@ std::unique_ptr<Expression> Parser::ParseDotMember(std::unique_ptr<Expression> l
     if (tk._TokenType.GetEnum() != TokenKind::IDENTITY) {
         Error(tk, "此处期望: 标识符");
     }
-    return make_unique<DotExpression>(std::move(left), make_unique<Identifier>(std::move(tk.TokenValue)));
+    return Make<DotExpression>(std::move(left), Make<Identifier>(std::string(tk.TokenValue)));
 }
 
-std::unique_ptr<Expression> Parser::ParseBracketMember(std::unique_ptr<Expression> left) {
+NodePtr<Expression> Parser::ParseBracketMember(NodePtr<Expression> left) {
     auto tk = this->NextToken();
     if (tk.TokenValue != "[") {
         Error(tk, "此处期望: [");
@@ -692,10 +697,10 @@ std::unique_ptr<Expression> Parser::ParseBracketMember(std::unique_ptr<Expressio
     if (tk.TokenValue != "]") {
         Error(tk, "此处期望: ]");
     }
-    return make_unique<BracketExpression>(std::move(left), std::move(m));
+    return Make<BracketExpression>(std::move(left), std::move(m));
 }
 
-std::unique_ptr<Expression> Parser::ParseLeftHandSideExpressionAllowCall() {
+NodePtr<Expression> Parser::ParseLeftHandSideExpressionAllowCall() {
     auto left = this->ParsePrimaryExpression();
     while (true) {
         auto tk = this->NextToken();
@@ -713,45 +718,41 @@ std::unique_ptr<Expression> Parser::ParseLeftHandSideExpressionAllowCall() {
     return std::move(left);
 }
 
-std::unique_ptr<Expression> Parser::ParsePostfixExpression() {
+NodePtr<Expression> Parser::ParsePostfixExpression() {
     auto operand = this->ParseLeftHandSideExpressionAllowCall();
     const auto tk = this->NextToken();
     if (tk.TokenValue == "++" || tk.TokenValue == "--") {
-        if (!dynamic_cast<Identifier *>(operand.get()) &&
-            !dynamic_cast<DotExpression *>(operand.get()) &&
-            !dynamic_cast<BracketExpression *>(operand.get())) {
+        if (!IsAssignable(operand.get())) {
             Error(tk, "不支持的表达式");
         }
-        return make_unique<UnaryExpression>(tk, std::move(operand), true);
+        return Make<UnaryExpression>(tk, std::move(operand), true);
     }
     this->BackToken(tk);
     return std::move(operand);
 }
 
-std::unique_ptr<Expression> Parser::ParseUnaryExpression() {
+NodePtr<Expression> Parser::ParseUnaryExpression() {
     auto tk = this->NextToken();
     if (tk.TokenValue == "!" || tk.TokenValue == "+" || tk.TokenValue == "-" || tk.TokenValue == "delete") {
-        return make_unique<UnaryExpression>(tk, std::move(this->ParseUnaryExpression()), false);
+        return Make<UnaryExpression>(tk, std::move(this->ParseUnaryExpression()), false);
     }
     if (tk.TokenValue == "++" || tk.TokenValue == "--") {
         auto operand = this->ParseUnaryExpression();
-        if (!dynamic_cast<Identifier *>(operand.get()) &&
-            !dynamic_cast<DotExpression *>(operand.get()) &&
-            !dynamic_cast<BracketExpression *>(operand.get())) {
+        if (!IsAssignable(operand.get())) {
             Error(tk, "不支持的表达式");
         }
-        return make_unique<UnaryExpression>(tk, std::move(operand), true);
+        return Make<UnaryExpression>(tk, std::move(operand), true);
     }
     this->BackToken(tk);
     return std::move(this->ParsePostfixExpression());
 }
 
-std::unique_ptr<Expression> Parser::ParseMultiplicativeExpression() {
+NodePtr<Expression> Parser::ParseMultiplicativeExpression() {
     auto left = this->ParseUnaryExpression();
     auto tk = this->NextToken();
     if (tk.TokenValue == "*" || tk.TokenValue == "/" || tk.TokenValue == "%") {
         while (true) {
-            left = make_unique<BinaryExpression>(tk, std::move(left), std::move(this->ParseUnaryExpression()), false);
+            left = Make<BinaryExpression>(tk, std::move(left), std::move(this->ParseUnaryExpression()), false);
             tk = this->NextToken();
             if (tk.TokenValue != "*" && tk.TokenValue != "/" && tk.TokenValue != "%") {
                 this->BackToken(tk);
@@ -764,12 +765,12 @@ std::unique_ptr<Expression> Parser::ParseMultiplicativeExpression() {
     return std::move(left);
 }
 
-std::unique_ptr<Expression> Parser::ParseAdditiveExpression() {
+NodePtr<Expression> Parser::ParseAdditiveExpression() {
     auto left = this->ParseMultiplicativeExpression();
     auto tk = this->NextToken();
     if (tk.TokenValue == "+" || tk.TokenValue == "-") {
         while (true) {
-            left = make_unique<BinaryExpression>(tk, std::move(left), std::move(this->ParseMultiplicativeExpression()),
+            left = Make<BinaryExpression>(tk, std::move(left), std::move(this->ParseMultiplicativeExpression()),
                                                  false);
             tk = this->NextToken();
             if (tk.TokenValue != "+" && tk.TokenValue != "-") {
@@ -783,12 +784,12 @@ std::unique_ptr<Expression> Parser::ParseAdditiveExpression() {
     return std::move(left);
 }
 
-std::unique_ptr<Expression> Parser::ParseShiftExpression() {
+NodePtr<Expression> Parser::ParseShiftExpression() {
     auto left = this->ParseAdditiveExpression();
     auto tk = this->NextToken();
     if (tk.TokenValue == "<<" || tk.TokenValue == ">>") {
         while (true) {
-            left = make_unique<BinaryExpression>(tk, std::move(left), std::move(this->ParseAdditiveExpression()),
+            left = Make<BinaryExpression>(tk, std::move(left), std::move(this->ParseAdditiveExpression()),
                                                  false);
             tk = this->NextToken();
             if (tk.TokenValue != "<<" && tk.TokenValue != ">>") {
@@ -802,22 +803,22 @@ std::unique_ptr<Expression> Parser::ParseShiftExpression() {
     return std::move(left);
 }
 
-std::unique_ptr<Expression> Parser::ParseRelationalExpression() {
+NodePtr<Expression> Parser::ParseRelationalExpression() {
     auto left = this->ParseShiftExpression();
     auto tk = this->NextToken();
     if (tk.TokenValue == "<" || tk.TokenValue == "<=" || tk.TokenValue == ">" || tk.TokenValue == ">=") {
-        return make_unique<BinaryExpression>(tk, std::move(left), std::move(this->ParseRelationalExpression()), true);
+        return Make<BinaryExpression>(tk, std::move(left), std::move(this->ParseRelationalExpression()), true);
     }
     this->BackToken(tk);
     return std::move(left);
 }
 
-std::unique_ptr<Expression> Parser::ParseEqualityExpression() {
+NodePtr<Expression> Parser::ParseEqualityExpression() {
     auto left = this->ParseRelationalExpression();
     auto tk = this->NextToken();
     if (tk.TokenValue == "==" || tk.TokenValue == "!=") {
         while (true) {
-            left = make_unique<BinaryExpression>(tk, std::move(left), std::move(this->ParseRelationalExpression()),
+            left = Make<BinaryExpression>(tk, std::move(left), std::move(this->ParseRelationalExpression()),
                                                  true);
             tk = this->NextToken();
             if (tk.TokenValue != "!=" && tk.TokenValue != "==") {
@@ -831,12 +832,12 @@ std::unique_ptr<Expression> Parser::ParseEqualityExpression() {
     return std::move(left);
 }
 
-std::unique_ptr<Expression> Parser::ParseLogicalAndExpression() {
+NodePtr<Expression> Parser::ParseLogicalAndExpression() {
     auto left = this->ParseEqualityExpression();
     auto tk = this->NextToken();
     if (tk.TokenValue == "&&") {
         while (true) {
-            left = make_unique<BinaryExpression>(tk, std::move(left), std::move(this->ParseEqualityExpression()),
+            left = Make<BinaryExpression>(tk, std::move(left), std::move(this->ParseEqualityExpression()),
                                                  false);
             tk = this->NextToken();
             if (tk.TokenValue != "&&") {
@@ -850,12 +851,12 @@ std::unique_ptr<Expression> Parser::ParseLogicalAndExpression() {
     return std::move(left);
 }
 
-std::unique_ptr<Expression> Parser::ParseLogicalOrExpression() {
+NodePtr<Expression> Parser::ParseLogicalOrExpression() {
     auto left = this->ParseLogicalAndExpression();
     auto tk = this->NextToken();
     if (tk.TokenValue == "||") {
         while (true) {
-            left = make_unique<BinaryExpression>(tk, std::move(left), std::move(this->ParseLogicalAndExpression()),
+            left = Make<BinaryExpression>(tk, std::move(left), std::move(this->ParseLogicalAndExpression()),
                                                  false);
             tk = this->NextToken();
             if (tk.TokenValue != "||") {
@@ -869,7 +870,7 @@ std::unique_ptr<Expression> Parser::ParseLogicalOrExpression() {
     return std::move(left);
 }
 
-std::unique_ptr<Expression> Parser::ParseConditionExpression() {
+NodePtr<Expression> Parser::ParseConditionExpression() {
     auto left = this->ParseLogicalOrExpression();
     auto tk = this->NextToken();
     if (tk.TokenValue == "?") {
@@ -878,14 +879,14 @@ std::unique_ptr<Expression> Parser::ParseConditionExpression() {
         if (tk.TokenValue == ":") {
             Error(tk, "此处期望: :");
         }
-        return make_unique<ConditionalExpression>(std::move(left), std::move(ok),
+        return Make<ConditionalExpression>(std::move(left), std::move(ok),
                                                   std::move(this->ParseAssignmentExpression()));
     }
     this->BackToken(tk);
     return std::move(left);
 }
 
-std::unique_ptr<Expression> Parser::ParseAssignmentExpression() {
+NodePtr<Expression> Parser::ParseAssignmentExpression() {
     auto left = this->ParseConditionExpression();
     std::string oper{};
     auto tk = this->NextToken();
@@ -905,18 +906,16 @@ std::unique_ptr<Expression> Parser::ParseAssignmentExpression() {
         this->BackToken(tk);
     }
     if (!oper.empty()) {
-        if (!dynamic_cast<Identifier *>(left.get()) &&
-            !dynamic_cast<DotExpression *>(left.get()) &&
-            !dynamic_cast<BracketExpression *>(left.get())) {
+        if (!IsAssignable(left.get())) {
             Error(tk, "不支持的表达式");
         }
-        return make_unique<AssignExpression>(tk, std::move(left), std::move(this->ParseAssignmentExpression()));
+        return Make<AssignExpression>(tk, std::move(left), std::move(this->ParseAssignmentExpression()));
     }
     return left;
 }
 
 Program Parser::ParseProgram() {
-    std::vector<std::unique_ptr<Statement> > body;
+    std::vector<NodePtr<Statement> > body;
     while (true) {
         auto tk = this->NextToken();
         if (tk._TokenType.GetEnum() == TokenKind::FILE_END) {
@@ -924,16 +923,20 @@ Program Parser::ParseProgram() {
         }
         this->BackToken(tk);
         auto stmt = this->ParseStatement();
-        if (auto exprStmt = dynamic_cast<ExpressionStatement *>(stmt.get())) {
-            if (dynamic_cast<BadExpression *>(exprStmt->Expression.get())) {
+        if (stmt->Kind == NodeKind::EXPRESSION_STATEMENT) {
+            const auto *inner = static_cast<ExpressionStatement *>(stmt.get())->Expression.get();
+            if (inner && inner->Kind == NodeKind::BAD_EXPRESSION) {
                 tk = this->NextToken();
                 continue;
             }
         }
         body.push_back(std::move(stmt));
     }
-    return Program{
+    Program program{
         std::move(body),
-        std::move(this->VM->imports)
+        std::move(this->VM->imports),
+        this->arena
     };
+    Resolver::ResolveProgram(program);
+    return program;
 }
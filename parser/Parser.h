@@ -23,17 +23,6 @@
 #include "lexer/Lexer.h"
 #include "lexer/Token.h"
 
-#if __cplusplus < 201402L
-// C++11
-template<typename T, typename... Args>
-inline std::unique_ptr<T> make_unique(Args &&... args) {
-    return std::unique_ptr<T>(new T(std::forward<Args>(args)...));
-}
-#else
-// C++14+
-using std::make_unique;
-#endif
-
 class Parser {
 public:
     ~Parser() {
@@ -44,7 +33,15 @@ public:
         }
     }
 
-    explicit Parser(const std::string &sourceCode) : lexer(sourceCode) {
+    explicit Parser(const std::string &sourceCode) : lexer(sourceCode), arena(std::make_shared<AstArena>()) {
+        this->VM = new ParserVM();
+        this->VM->OuterVM = nullptr;
+    }
+
+    // 在 owner 持有的内存 (如映射的文件) 上直接解析, Arena 一并持有 owner, 语法树存活期间源码始终有效
+    Parser(const std::string_view sourceCode, std::shared_ptr<const void> owner)
+        : lexer(sourceCode, owner), arena(std::make_shared<AstArena>()) {
+        arena->Retain(std::move(owner));
         this->VM = new ParserVM();
         this->VM->OuterVM = nullptr;
     }
@@ -71,16 +68,18 @@ public:
         return this->VM;
     }
 
-    static void Error(const Token &token, const std::string &message) {
+    void Error(const Token &token, const std::string &message) const {
+        int line = 0, column = 0;
+        lexer.Position(token.Offset, line, column);
         std::ostringstream oss;
         oss << "\033[1;31m[语法错误]\033[0m " << message << "\n"
-                << "  位于第 " << token.LineNum + 1 << " 行，第 " << token.ColsNum + 1 << " 列";
+                << "  位于第 " << line + 1 << " 行，第 " << column + 1 << " 列";
         if (!token.TokenValue.empty()) {
             oss << "，出错的符号为：‘" << token.TokenValue << "’";
         }
         oss << "\n";
         if (!token.TokenValue.empty()) {
-            int spaceCount = token.ColsNum > 0 ? token.ColsNum : 0;
+            const int spaceCount = column;
             oss << "  " << token.TokenValue << "\n"
                     << "  " << std::string(spaceCount, ' ') << "↑\n";
         }
@@ -88,102 +87,109 @@ public:
         throw std::runtime_error(message);
     }
 
-    std::unique_ptr<Statement> ParseImportStatements();
+    NodePtr<Statement> ParseImportStatements();
 
-    std::unique_ptr<Statement> ParseBlockStatement();
+    NodePtr<Statement> ParseBlockStatement();
 
     // std::vector<Statement> ParseStatements();
 
-    std::unique_ptr<Statement> ParseStatement();
+    NodePtr<Statement> ParseStatement();
 
-    std::unique_ptr<Statement> ParseIfStatement();
+    NodePtr<Statement> ParseIfStatement();
 
-    // std::unique_ptr<Statement> ParseForStatement();
+    // NodePtr<Statement> ParseForStatement();
     //
-    // std::unique_ptr<Statement> ParseForInStatement();
+    // NodePtr<Statement> ParseForInStatement();
 
-    // std::unique_ptr<Statement> ParseWhileStatement();
+    // NodePtr<Statement> ParseWhileStatement();
 
-    std::unique_ptr<Statement> ParseForOrForInStatement();
+    NodePtr<Statement> ParseForOrForInStatement();
 
-    std::unique_ptr<Statement> ParseWhileStatement();
+    NodePtr<Statement> ParseWhileStatement();
 
     Program ParseProgram();
 
-    std::unique_ptr<BreakStatement> ParseBreakStatement();
+    NodePtr<BreakStatement> ParseBreakStatement();
 
-    std::unique_ptr<ContinueStatement> ParseContinueStatement();
+    NodePtr<ContinueStatement> ParseContinueStatement();
 
-    std::unique_ptr<ReturnStatement> ParseReturnStatement();
+    NodePtr<ReturnStatement> ParseReturnStatement();
 
-    std::unique_ptr<Statement> ParseThrowStatement();
+    NodePtr<Statement> ParseThrowStatement();
 
-    std::unique_ptr<Statement> ParseTryStatement();
+    NodePtr<Statement> ParseTryStatement();
 
-    std::unique_ptr<Statement> ParseVariableStatement();
+    NodePtr<Statement> ParseVariableStatement();
 
-    std::unique_ptr<Statement> ParseFunctionStatement();
+    NodePtr<Statement> ParseFunctionStatement();
 
-    std::unique_ptr<FunctionLiteral> ParseFunction(bool isAnonymous);
+    NodePtr<FunctionLiteral> ParseFunction(bool isAnonymous);
 
-    std::unique_ptr<ParameterList> ParseParameterList();
+    NodePtr<ParameterList> ParseParameterList();
 
-    std::unique_ptr<Statement> ParseFunctionBlock();
+    NodePtr<Statement> ParseFunctionBlock();
 
     // function的body尝试用ParseBlockStatement
     // FunctionLiteral ParseFunctionLiteral();
 
     // 以下为表达式解析
 
-    std::unique_ptr<Expression> ParseExpression();
+    NodePtr<Expression> ParseExpression();
 
-    std::unique_ptr<Identifier> ParseIdentifier();
+    NodePtr<Identifier> ParseIdentifier();
 
-    std::unique_ptr<Expression> ParsePrimaryExpression();
+    NodePtr<Expression> ParsePrimaryExpression();
 
-    std::unique_ptr<VariableExpression> ParseVariableDeclaration();
+    NodePtr<VariableExpression> ParseVariableDeclaration();
 
-    std::vector<std::unique_ptr<Expression> > ParseVariableDeclarationList();
+    std::vector<NodePtr<Expression> > ParseVariableDeclarationList();
 
     std::string ParseObjectPropertyKey();
 
-    std::unique_ptr<Property> ParseObjectProperty();
+    NodePtr<Property> ParseObjectProperty();
 
-    std::unique_ptr<Expression> ParseObjectLiteral();
+    NodePtr<Expression> ParseObjectLiteral();
 
-    std::unique_ptr<Expression> ParseArrayLiteral();
+    NodePtr<Expression> ParseArrayLiteral();
 
-    std::vector<std::unique_ptr<Expression> > ParseArgumentList();
+    std::vector<NodePtr<Expression> > ParseArgumentList();
 
-    std::unique_ptr<Expression> ParseCallExpression(std::unique_ptr<Expression> left);
+    NodePtr<Expression> ParseCallExpression(NodePtr<Expression> left);
 
-    std::unique_ptr<Expression> ParseDotMember(std::unique_ptr<Expression> left);
+    NodePtr<Expression> ParseDotMember(NodePtr<Expression> left);
 
-    std::unique_ptr<Expression> ParseBracketMember(std::unique_ptr<Expression> left);
+    NodePtr<Expression> ParseBracketMember(NodePtr<Expression> left);
 
-    std::unique_ptr<Expression> ParseLeftHandSideExpressionAllowCall();
+    NodePtr<Expression> ParseLeftHandSideExpressionAllowCall();
 
-    std::unique_ptr<Expression> ParsePostfixExpression();
+    NodePtr<Expression> ParsePostfixExpression();
 
-    std::unique_ptr<Expression> ParseUnaryExpression();
+    NodePtr<Expression> ParseUnaryExpression();
 
-    std::unique_ptr<Expression> ParseMultiplicativeExpression();
+    NodePtr<Expression> ParseMultiplicativeExpression();
 
-    std::unique_ptr<Expression> ParseAdditiveExpression();
+    NodePtr<Expression> ParseAdditiveExpression();
 
-    std::unique_ptr<Expression> ParseShiftExpression();
+    NodePtr<Expression> ParseShiftExpression();
 
-    std::unique_ptr<Expression> ParseRelationalExpression();
+    NodePtr<Expression> ParseRelationalExpression();
 
-    std::unique_ptr<Expression> ParseEqualityExpression();
+    NodePtr<Expression> ParseEqualityExpression();
 
-    std::unique_ptr<Expression> ParseLogicalAndExpression();
+    NodePtr<Expression> ParseLogicalAndExpression();
 
-    std::unique_ptr<Expression> ParseLogicalOrExpression();
+    NodePtr<Expression> ParseLogicalOrExpression();
 
-    std::unique_ptr<Expression> ParseConditionExpression();
+    NodePtr<Expression> ParseConditionExpression();
 
-    std::unique_ptr<Expression> ParseAssignmentExpression();
+    NodePtr<Expression> ParseAssignmentExpression();
+
+    // 可作为赋值/自增目标的表达式: 标识符、点号访问、括号访问
+    static bool IsAssignable(const Expression *expr) {
+        return expr->Kind == NodeKind::IDENTIFIER
+               || expr->Kind == NodeKind::DOT
+               || expr->Kind == NodeKind::BRACKET;
+    }
 
     void Semicolon() {
         const auto tk = this->NextToken();
@@ -196,6 +202,13 @@ public:
 private:
     std::deque<Token> TokenQueue{};
     Lexer lexer;
+    // 本次解析的节点都分配在这里, 解析完成后交给 Program
+    std::shared_ptr<AstArena> arena;
+
+    template<typename T, typename... Args>
+    NodePtr<T> Make(Args &&... args) {
+        return arena->New<T>(std::forward<Args>(args)...);
+    }
 };
 
 
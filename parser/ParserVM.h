@@ -22,7 +22,7 @@ class ParserVM {
 public:
     ParserVM *OuterVM;
     bool InFunc = false, InFor = false;
-    std::vector<std::unique_ptr<ImportStatement>> imports{};
+    std::vector<NodePtr<ImportStatement> > imports{};
 };
 
 #endif //BXSCRIPT_PARSERVM_H
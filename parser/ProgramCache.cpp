@@ -0,0 +1,655 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    预编译缓存的读写
+ */
+
+#include "ProgramCache.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include "Parser.h"
+#include "Resolver.h"
+#include "common/KeyWord.h"
+#include "common/MappedFile.h"
+#include "common/Symbols.h"
+
+bool ProgramCache::Enabled = true;
+
+namespace {
+    constexpr char Magic[4] = {'B', 'X', 'C', '\0'};
+    // 空指针子节点
+    constexpr uint8_t NullNode = 0xFF;
+    // 读取时允许的最大嵌套层数, 超出按损坏处理, 构造出的深层嵌套不会让递归读取栈溢出
+    constexpr int MaxDepth = 1024;
+
+    // 按本机字节序写入, 缓存只在生成它的机器上使用
+    class Writer {
+    public:
+        std::string Out{};
+
+        template<typename T>
+        void Put(const T value) {
+            Out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+        }
+
+        void PutString(const std::string_view s) {
+            Put(static_cast<uint32_t>(s.size()));
+            Out.append(s.data(), s.size());
+        }
+
+        template<typename T>
+        void PutList(const std::vector<NodePtr<T> > &list) {
+            Put(static_cast<uint32_t>(list.size()));
+            for (const auto &node: list) {
+                PutNode(node.get());
+            }
+        }
+
+        void PutNode(const Expression *expr) {
+            if (!expr) {
+                Put(NullNode);
+                return;
+            }
+            Put(static_cast<uint8_t>(expr->Kind));
+            switch (expr->Kind) {
+                case NodeKind::ARRAY_LITERAL:
+                    PutList(static_cast<const ArrayLiteral *>(expr)->Value);
+                    break;
+                case NodeKind::ASSIGN: {
+                    const auto *assign = static_cast<const AssignExpression *>(expr);
+                    PutString(assign->Operator.TokenValue);
+                    PutNode(assign->Left.get());
+                    PutNode(assign->Right.get());
+                    break;
+                }
+                case NodeKind::BINARY: {
+                    const auto *bin = static_cast<const BinaryExpression *>(expr);
+                    PutString(bin->Operator.TokenValue);
+                    PutNode(bin->Left.get());
+                    PutNode(bin->Right.get());
+                    Put(static_cast<uint8_t>(bin->Comparison));
+                    break;
+                }
+                case NodeKind::BOOLEAN_LITERAL: {
+                    const auto *_bool = static_cast<const BooleanLiteral *>(expr);
+                    PutString(_bool->Literal);
+                    Put(static_cast<uint8_t>(_bool->Value));
+                    break;
+                }
+                case NodeKind::BRACKET: {
+                    const auto *bracket = static_cast<const BracketExpression *>(expr);
+                    PutNode(bracket->Left.get());
+                    PutNode(bracket->Member.get());
+                    break;
+                }
+                case NodeKind::CALL: {
+                    const auto *call = static_cast<const CallExpression *>(expr);
+                    PutNode(call->Callee.get());
+                    PutList(call->ArgumentList);
+                    break;
+                }
+                case NodeKind::CONDITIONAL: {
+                    const auto *cond = static_cast<const ConditionalExpression *>(expr);
+                    PutNode(cond->Test.get());
+                    PutNode(cond->Ok.get());
+                    PutNode(cond->Else.get());
+                    break;
+                }
+                case NodeKind::IDENTIFIER:
+                    PutString(static_cast<const Identifier *>(expr)->Name.Str());
+                    break;
+                case NodeKind::DOT: {
+                    const auto *dot = static_cast<const DotExpression *>(expr);
+                    PutNode(dot->Left.get());
+                    PutNode(dot->Identifier.get());
+                    break;
+                }
+                case NodeKind::EMPTY_EXPRESSION: {
+                    const auto *empty = static_cast<const EmptyExpression *>(expr);
+                    Put(static_cast<int32_t>(empty->Begin));
+                    Put(static_cast<int32_t>(empty->End));
+                    break;
+                }
+                case NodeKind::PARAMETER_LIST:
+                    PutList(static_cast<const ParameterList *>(expr)->Parameters);
+                    break;
+                case NodeKind::FUNCTION_LITERAL: {
+                    const auto *func = static_cast<const FunctionLiteral *>(expr);
+                    PutNode(func->Name.get());
+                    PutNode(func->Parameters.get());
+                    PutNode(func->Body.get());
+                    break;
+                }
+                case NodeKind::NULL_LITERAL:
+                    PutString(static_cast<const NullLiteral *>(expr)->Literal);
+                    break;
+                case NodeKind::NUMBER_LITERAL:
+                    PutString(static_cast<const NumberLiteral *>(expr)->Literal);
+                    break;
+                case NodeKind::PROPERTY: {
+                    const auto *prop = static_cast<const Property *>(expr);
+                    PutString(prop->Key.Str());
+                    PutNode(prop->Value.get());
+                    break;
+                }
+                case NodeKind::OBJECT_LITERAL:
+                    PutList(static_cast<const ObjectLiteral *>(expr)->Value);
+                    break;
+                case NodeKind::SEQUENCE:
+                    PutList(static_cast<const SequenceExpression *>(expr)->Sequence);
+                    break;
+                case NodeKind::STRING_LITERAL:
+                    PutString(static_cast<const StringLiteral *>(expr)->Literal);
+                    break;
+                case NodeKind::UNARY: {
+                    const auto *unary = static_cast<const UnaryExpression *>(expr);
+                    PutString(unary->Operator.TokenValue);
+                    PutNode(unary->Operand.get());
+                    Put(static_cast<uint8_t>(unary->Postfix));
+                    break;
+                }
+                case NodeKind::VARIABLE: {
+                    const auto *var = static_cast<const VariableExpression *>(expr);
+                    PutString(var->Name.Str());
+                    PutNode(var->Initializer.get());
+                    break;
+                }
+                case NodeKind::BAD_EXPRESSION:
+                case NodeKind::THIS:
+                    break;
+                default:
+                    throw std::runtime_error("无法缓存的表达式");
+            }
+        }
+
+        void PutNode(const Statement *stmt) {
+            if (!stmt) {
+                Put(NullNode);
+                return;
+            }
+            Put(static_cast<uint8_t>(stmt->Kind));
+            switch (stmt->Kind) {
+                case NodeKind::BAD_STATEMENT: {
+                    const auto *bad = static_cast<const BadStatement *>(stmt);
+                    Put(static_cast<int32_t>(bad->From));
+                    Put(static_cast<int32_t>(bad->To));
+                    break;
+                }
+                case NodeKind::BLOCK:
+                    PutList(static_cast<const BlockStatement *>(stmt)->StatementList);
+                    break;
+                case NodeKind::CATCH: {
+                    const auto *_catch = static_cast<const CatchStatement *>(stmt);
+                    PutNode(_catch->Parameter.get());
+                    PutNode(_catch->Body.get());
+                    break;
+                }
+                case NodeKind::EXPRESSION_STATEMENT:
+                    PutNode(static_cast<const ExpressionStatement *>(stmt)->Expression.get());
+                    break;
+                case NodeKind::FOR_IN: {
+                    const auto *forIn = static_cast<const ForInStatement *>(stmt);
+                    PutNode(forIn->Into.get());
+                    PutNode(forIn->Source.get());
+                    PutNode(forIn->Body.get());
+                    break;
+                }
+                case NodeKind::FOR: {
+                    const auto *forStmt = static_cast<const ForStatement *>(stmt);
+                    PutNode(forStmt->Initializer.get());
+                    PutNode(forStmt->Update.get());
+                    PutNode(forStmt->Test.get());
+                    PutNode(forStmt->Body.get());
+                    break;
+                }
+                case NodeKind::FUNCTION_STATEMENT:
+                    PutNode(static_cast<const FunctionStatement *>(stmt)->Function.get());
+                    break;
+                case NodeKind::IF: {
+                    const auto *ifStmt = static_cast<const IfStatement *>(stmt);
+                    PutNode(ifStmt->Condition.get());
+                    PutNode(ifStmt->Ok.get());
+                    PutNode(ifStmt->Else.get());
+                    PutNode(ifStmt->ElseIf.get());
+                    break;
+                }
+                case NodeKind::LABEL: {
+                    const auto *label = static_cast<const LabelStatement *>(stmt);
+                    PutNode(label->Label.get());
+                    PutNode(label->Statement.get());
+                    break;
+                }
+                case NodeKind::RETURN:
+                    PutNode(static_cast<const ReturnStatement *>(stmt)->Argument.get());
+                    break;
+                case NodeKind::THROW:
+                    PutNode(static_cast<const ThrowStatement *>(stmt)->Argument.get());
+                    break;
+                case NodeKind::TRY: {
+                    const auto *tryStmt = static_cast<const TryStatement *>(stmt);
+                    PutNode(tryStmt->Body.get());
+                    PutNode(tryStmt->Catch.get());
+                    PutNode(tryStmt->Finally.get());
+                    break;
+                }
+                case NodeKind::VARIABLE_STATEMENT:
+                    PutList(static_cast<const VariableStatement *>(stmt)->List);
+                    break;
+                case NodeKind::IMPORT: {
+                    const auto *import = static_cast<const ImportStatement *>(stmt);
+                    Put(static_cast<uint32_t>(import->Path.size()));
+                    for (const auto &part: import->Path) {
+                        PutString(part);
+                    }
+                    PutString(import->AliasName.Str());
+                    break;
+                }
+                case NodeKind::EMPTY_STATEMENT:
+                case NodeKind::BREAK:
+                case NodeKind::CONTINUE:
+                    break;
+                default:
+                    throw std::runtime_error("无法缓存的语句");
+            }
+        }
+    };
+
+    // 越界或遇到不认识的节点时抛出, 由 Deserialize 转为缓存失效
+    class Reader {
+    public:
+        Reader(const std::string_view data, AstArena &arena) : p(data.data()), end(data.data() + data.size()),
+                                                                arena(arena) {
+        }
+
+        template<typename T>
+        T Get() {
+            if (static_cast<size_t>(end - p) < sizeof(T)) {
+                throw std::runtime_error("缓存已损坏");
+            }
+            T value;
+            std::memcpy(&value, p, sizeof(T));
+            p += sizeof(T);
+            return value;
+        }
+
+        std::string GetString() {
+            const auto size = Get<uint32_t>();
+            if (static_cast<size_t>(end - p) < size) {
+                throw std::runtime_error("缓存已损坏");
+            }
+            std::string s(p, size);
+            p += size;
+            return s;
+        }
+
+        [[nodiscard]] bool AtEnd() const { return p == end; }
+
+        // 尚未读取的部分
+        [[nodiscard]] std::string_view Rest() const { return {p, static_cast<size_t>(end - p)}; }
+
+        template<typename T>
+        std::vector<NodePtr<T> > GetList() {
+            const auto size = Get<uint32_t>();
+            std::vector<NodePtr<T> > list;
+            list.reserve(std::min<size_t>(size, end - p));
+            for (uint32_t i = 0; i < size; ++i) {
+                list.push_back(GetAs<T>());
+            }
+            return list;
+        }
+
+        // 读取一个子节点并确认其类型
+        template<typename T>
+        NodePtr<T> GetAs() {
+            if (++depth > MaxDepth) {
+                throw std::runtime_error("缓存已损坏");
+            }
+            NodePtr<T> node = GetNode<T>();
+            --depth;
+            return node;
+        }
+
+    private:
+        const char *p;
+        const char *end;
+        AstArena &arena;
+        int depth = 0;
+
+        template<typename T>
+        NodePtr<T> GetNode() {
+            const auto kind = Get<uint8_t>();
+            if (kind == NullNode) {
+                return nullptr;
+            }
+            if constexpr (std::is_base_of_v<Expression, T>) {
+                NodePtr<Expression> node = GetExpression(static_cast<NodeKind>(kind));
+                if constexpr (!std::is_same_v<T, Expression>) {
+                    if (!IsKind<T>(node->Kind)) {
+                        throw std::runtime_error("缓存已损坏");
+                    }
+                }
+                return NodePtr<T>(static_cast<T *>(node.release()));
+            } else {
+                NodePtr<Statement> node = GetStatement(static_cast<NodeKind>(kind));
+                if constexpr (!std::is_same_v<T, Statement>) {
+                    if (!IsKind<T>(node->Kind)) {
+                        throw std::runtime_error("缓存已损坏");
+                    }
+                }
+                return NodePtr<T>(static_cast<T *>(node.release()));
+            }
+        }
+
+        template<typename T>
+        static bool IsKind(const NodeKind kind) {
+            if constexpr (std::is_same_v<T, Identifier>) return kind == NodeKind::IDENTIFIER;
+            else if constexpr (std::is_same_v<T, ParameterList>) return kind == NodeKind::PARAMETER_LIST;
+            else if constexpr (std::is_same_v<T, FunctionLiteral>) return kind == NodeKind::FUNCTION_LITERAL;
+            else if constexpr (std::is_same_v<T, Property>) return kind == NodeKind::PROPERTY;
+            else if constexpr (std::is_same_v<T, CatchStatement>) return kind == NodeKind::CATCH;
+            else if constexpr (std::is_same_v<T, ImportStatement>) return kind == NodeKind::IMPORT;
+            else return false;
+        }
+
+        // 运算符 Token 要指向静态文本, 缓存中的字符串读完即释放
+        Token GetOperator() {
+            const std::string text = GetString();
+            std::string_view spelling = Symbols::Find(text);
+            if (spelling.empty()) {
+                const std::string_view *word = KeyWord::Find(text);
+                if (!word) {
+                    throw std::runtime_error("缓存已损坏");
+                }
+                spelling = *word;
+            }
+            return Token{TokenKind(TokenKind::SYMBOL), spelling, 0};
+        }
+
+        NodePtr<Expression> GetExpression(const NodeKind kind) {
+            switch (kind) {
+                case NodeKind::ARRAY_LITERAL:
+                    return arena.New<ArrayLiteral>(GetList<Expression>());
+                case NodeKind::ASSIGN: {
+                    Token op = GetOperator();
+                    auto left = GetAs<Expression>();
+                    auto right = GetAs<Expression>();
+                    return arena.New<AssignExpression>(std::move(op), std::move(left), std::move(right));
+                }
+                case NodeKind::BAD_EXPRESSION:
+                    return arena.New<BadExpression>();
+                case NodeKind::BINARY: {
+                    Token op = GetOperator();
+                    auto left = GetAs<Expression>();
+                    auto right = GetAs<Expression>();
+                    const bool comparison = Get<uint8_t>() != 0;
+                    return arena.New<BinaryExpression>(std::move(op), std::move(left), std::move(right), comparison);
+                }
+                case NodeKind::BOOLEAN_LITERAL: {
+                    std::string literal = GetString();
+                    const bool value = Get<uint8_t>() != 0;
+                    return arena.New<BooleanLiteral>(std::move(literal), value);
+                }
+                case NodeKind::BRACKET: {
+                    auto left = GetAs<Expression>();
+                    auto member = GetAs<Expression>();
+                    return arena.New<BracketExpression>(std::move(left), std::move(member));
+                }
+                case NodeKind::CALL: {
+                    auto callee = GetAs<Expression>();
+                    return arena.New<CallExpression>(std::move(callee), GetList<Expression>());
+                }
+                case NodeKind::CONDITIONAL: {
+                    auto test = GetAs<Expression>();
+                    auto ok = GetAs<Expression>();
+                    auto _else = GetAs<Expression>();
+                    return arena.New<ConditionalExpression>(std::move(test), std::move(ok), std::move(_else));
+                }
+                case NodeKind::IDENTIFIER:
+                    return arena.New<Identifier>(GetString());
+                case NodeKind::DOT: {
+                    auto left = GetAs<Expression>();
+                    return arena.New<DotExpression>(std::move(left), GetAs<Identifier>());
+                }
+                case NodeKind::EMPTY_EXPRESSION: {
+                    auto empty = arena.New<EmptyExpression>();
+                    empty->Begin = Get<int32_t>();
+                    empty->End = Get<int32_t>();
+                    return empty;
+                }
+                case NodeKind::PARAMETER_LIST:
+                    return arena.New<ParameterList>(GetList<Expression>());
+                case NodeKind::FUNCTION_LITERAL: {
+                    auto name = GetAs<Identifier>();
+                    auto params = GetAs<ParameterList>();
+                    auto body = GetAs<Statement>();
+                    auto func = arena.New<FunctionLiteral>(std::move(name), std::move(params), std::move(body));
+                    func->Owner = &arena;
+                    return func;
+                }
+                case NodeKind::NULL_LITERAL:
+                    return arena.New<NullLiteral>(GetString());
+                case NodeKind::NUMBER_LITERAL:
+                    return arena.New<NumberLiteral>(GetString());
+                case NodeKind::PROPERTY: {
+                    const std::string key = GetString();
+                    return arena.New<Property>(key, GetAs<Expression>());
+                }
+                case NodeKind::OBJECT_LITERAL:
+                    return arena.New<ObjectLiteral>(GetList<Property>());
+                case NodeKind::SEQUENCE:
+                    return arena.New<SequenceExpression>(GetList<Expression>());
+                case NodeKind::STRING_LITERAL:
+                    return arena.New<StringLiteral>(GetString());
+                case NodeKind::THIS:
+                    return arena.New<ThisExpression>();
+                case NodeKind::UNARY: {
+                    Token op = GetOperator();
+                    auto operand = GetAs<Expression>();
+                    const bool postfix = Get<uint8_t>() != 0;
+                    return arena.New<UnaryExpression>(std::move(op), std::move(operand), postfix);
+                }
+                case NodeKind::VARIABLE: {
+                    const std::string name = GetString();
+                    return arena.New<VariableExpression>(name, GetAs<Expression>());
+                }
+                default:
+                    throw std::runtime_error("缓存已损坏");
+            }
+        }
+
+        NodePtr<Statement> GetStatement(const NodeKind kind) {
+            switch (kind) {
+                case NodeKind::BAD_STATEMENT: {
+                    auto bad = arena.New<BadStatement>();
+                    bad->From = Get<int32_t>();
+                    bad->To = Get<int32_t>();
+                    return bad;
+                }
+                case NodeKind::EMPTY_STATEMENT:
+                    return arena.New<EmptyStatement>();
+                case NodeKind::BLOCK:
+                    return arena.New<BlockStatement>(GetList<Statement>());
+                case NodeKind::CATCH: {
+                    auto param = GetAs<Identifier>();
+                    return arena.New<CatchStatement>(std::move(param), GetAs<Statement>());
+                }
+                case NodeKind::EXPRESSION_STATEMENT:
+                    return arena.New<ExpressionStatement>(GetAs<Expression>());
+                case NodeKind::FOR_IN: {
+                    auto into = GetAs<Expression>();
+                    auto source = GetAs<Expression>();
+                    return arena.New<ForInStatement>(std::move(into), std::move(source), GetAs<Statement>());
+                }
+                case NodeKind::FOR: {
+                    auto initializer = GetAs<Expression>();
+                    auto update = GetAs<Expression>();
+                    auto test = GetAs<Expression>();
+                    return arena.New<ForStatement>(std::move(initializer), std::move(update), std::move(test),
+                                                   GetAs<Statement>());
+                }
+                case NodeKind::FUNCTION_STATEMENT:
+                    return arena.New<FunctionStatement>(GetAs<FunctionLiteral>());
+                case NodeKind::IF: {
+                    auto condition = GetAs<Expression>();
+                    auto ok = GetAs<Statement>();
+                    auto _else = GetAs<Statement>();
+                    return arena.New<IfStatement>(std::move(condition), std::move(ok), std::move(_else),
+                                                  GetAs<Statement>());
+                }
+                case NodeKind::LABEL: {
+                    auto label = arena.New<LabelStatement>();
+                    label->Label = GetAs<Identifier>();
+                    label->Statement = GetAs<Statement>();
+                    return label;
+                }
+                case NodeKind::RETURN:
+                    return arena.New<ReturnStatement>(GetAs<Expression>());
+                case NodeKind::BREAK:
+                    return arena.New<BreakStatement>();
+                case NodeKind::CONTINUE:
+                    return arena.New<ContinueStatement>();
+                case NodeKind::THROW:
+                    return arena.New<ThrowStatement>(GetAs<Expression>());
+                case NodeKind::TRY: {
+                    auto body = GetAs<Statement>();
+                    auto _catch = GetAs<CatchStatement>();
+                    return arena.New<TryStatement>(std::move(body), std::move(_catch), GetAs<Statement>());
+                }
+                case NodeKind::VARIABLE_STATEMENT:
+                    return arena.New<VariableStatement>(GetList<Expression>());
+                case NodeKind::IMPORT: {
+                    const auto size = Get<uint32_t>();
+                    std::vector<std::string> path;
+                    for (uint32_t i = 0; i < size; ++i) {
+                        path.push_back(GetString());
+                    }
+                    const std::string alias = GetString();
+                    return arena.New<ImportStatement>(std::move(path), alias);
+                }
+                default:
+                    throw std::runtime_error("缓存已损坏");
+            }
+        }
+    };
+}
+
+uint64_t ProgramCache::Hash(const std::string_view data) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c: data) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::string ProgramCache::CachePath(const std::string &path) {
+    return std::filesystem::path(path).replace_extension(".bxc").string();
+}
+
+std::string ProgramCache::Serialize(const Program &program, const std::string_view source) {
+    Writer tree;
+    tree.PutList(program.Body);
+    tree.PutList(program.Imports);
+    Writer writer;
+    writer.Out.append(Magic, sizeof(Magic));
+    writer.Put(FormatVersion);
+    writer.Put(Hash(source));
+    writer.Put(static_cast<uint64_t>(source.size()));
+    writer.Put(Hash(tree.Out));
+    writer.Out.append(tree.Out);
+    return std::move(writer.Out);
+}
+
+bool ProgramCache::Deserialize(const std::string_view data, const std::string_view source, Program &out) {
+    if (data.size() < sizeof(Magic) || std::memcmp(data.data(), Magic, sizeof(Magic)) != 0) {
+        return false;
+    }
+    auto arena = std::make_shared<AstArena>();
+    Reader reader(data.substr(sizeof(Magic)), *arena);
+    try {
+        if (reader.Get<uint32_t>() != FormatVersion
+            || reader.Get<uint64_t>() != Hash(source)
+            || reader.Get<uint64_t>() != source.size()) {
+            return false;
+        }
+        // 先校验整段语法树的哈希, 被截断或改写的文件不进入逐节点的读取
+        if (reader.Get<uint64_t>() != Hash(reader.Rest())) {
+            return false;
+        }
+        auto body = reader.GetList<Statement>();
+        auto imports = reader.GetList<ImportStatement>();
+        if (!reader.AtEnd()) {
+            return false;
+        }
+        Program program{std::move(body), std::move(imports), std::move(arena)};
+        Resolver::ResolveProgram(program);
+        out = std::move(program);
+    } catch (const std::exception &) {
+        return false;
+    }
+    return true;
+}
+
+void ProgramCache::Write(const std::string &path, const std::string &data) {
+    // 先写临时文件再改名, 并发运行的进程不会读到写了一半的缓存
+    const std::string temp = path + "." + std::to_string(
+                                 std::chrono::steady_clock::now().time_since_epoch().count()) + ".tmp";
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return;
+        }
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            file.close();
+            std::error_code ec;
+            std::filesystem::remove(temp, ec);
+            return;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+    }
+}
+
+Program ProgramCache::ParseFile(const std::string &path) {
+    // 词法分析直接扫描映射的字节, 映射随语法树的 Arena 一起释放
+    auto file = std::make_shared<MappedFile>();
+    if (!file->Open(path)) {
+        throw std::runtime_error("无法打开文件: " + path);
+    }
+    const std::string_view source = file->View();
+    const std::string cachePath = CachePath(path);
+    if (Enabled) {
+        MappedFile cache;
+        Program program;
+        if (cache.Open(cachePath) && Deserialize(cache.View(), source, program)) {
+            return program;
+        }
+    }
+    Parser parser(source, std::move(file));
+    Program program = parser.ParseProgram();
+    if (Enabled) {
+        // 目录不可写等情况下放弃缓存, 不影响运行
+        try {
+            Write(cachePath, Serialize(program, source));
+        } catch (const std::exception &) {
+        }
+    }
+    return program;
+}
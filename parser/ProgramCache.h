@@ -0,0 +1,52 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    预编译缓存 (.bxc): 保存解析好的语法树, 再次运行时跳过词法与语法分析
+ */
+
+#ifndef BXSCRIPT_PROGRAMCACHE_H
+#define BXSCRIPT_PROGRAMCACHE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "Expression.h"
+
+// 缓存文件与源码同目录同名 (a.bx -> a.bxc), 内容依次为:
+// 魔数 "BXC\0"、格式版本、源码哈希与长度、语法树部分的哈希、按前序展开的语法树.
+// 只保存语法结构, 加载后重新运行 Resolver, 槽位与常量不进入缓存.
+// 版本或哈希不符、内容损坏、嵌套过深时视为没有缓存, 重新解析并覆盖.
+class ProgramCache {
+public:
+    // 语法树结构变化时递增, 旧缓存自动失效
+    static constexpr uint32_t FormatVersion = 2;
+
+    // 为 false 时不读写缓存 (--no-cache)
+    static bool Enabled;
+
+    // 映射并解析源码文件, 优先使用新鲜的缓存, 否则解析后写入缓存; 文件无法打开时抛出异常
+    static Program ParseFile(const std::string &path);
+
+    static std::string CachePath(const std::string &path);
+
+    static std::string Serialize(const Program &program, std::string_view source);
+
+    // 缓存与 source 不匹配或已损坏时返回 false, out 保持不变
+    static bool Deserialize(std::string_view data, std::string_view source, Program &out);
+
+    // FNV-1a, 用于源码与缓存内容的校验
+    static uint64_t Hash(std::string_view data);
+
+private:
+    static void Write(const std::string &path, const std::string &data);
+};
+
+#endif //BXSCRIPT_PROGRAMCACHE_H
@@ -0,0 +1,285 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    静态作用域解析, 遍历顺序与 Interpreter::Execute/Evaluate 保持一致
+ */
+
+#include "Resolver.h"
+
+#include <algorithm>
+
+#include "evaluator/Value.h"
+
+void Resolver::ResolveProgram(Program &program) {
+    Resolver resolver;
+    for (const auto &stmt: program.Body) {
+        resolver.ResolveStatement(stmt.get());
+    }
+    while (!resolver.pending.empty()) {
+        const auto [func, closure] = resolver.pending.front();
+        resolver.pending.pop_front();
+        resolver.ResolveFunction(func, closure);
+    }
+    // 作用域是否为空到这里才确定, 被省略的作用域不计入深度
+    for (const auto &ref: resolver.references) {
+        int depth = 0;
+        for (const Scope *scope = ref.From; scope != ref.Target; scope = scope->Parent) {
+            if (!scope->Elided()) {
+                ++depth;
+            }
+        }
+        *ref.Depth = depth;
+    }
+}
+
+void Resolver::BeginScope(ScopeLayout &layout, const bool elidable, bool *captured) {
+    layout.clear();
+    scopes.push_back(Scope{&layout, current, elidable, captured, nullptr});
+    current = &scopes.back();
+}
+
+void Resolver::EndScope() {
+    current = current->Parent;
+}
+
+// 同一作用域内重名的声明共用槽位, 运行时由 DeclareSlot 报重复定义
+int Resolver::Declare(const Atom &name) const {
+    if (current == nullptr) {
+        return -1;
+    }
+    auto &names = *current->Layout;
+    const auto it = std::find(names.begin(), names.end(), name);
+    if (it != names.end()) {
+        return static_cast<int>(it - names.begin());
+    }
+    names.push_back(name);
+    return static_cast<int>(names.size() - 1);
+}
+
+void Resolver::Resolve(Identifier *id) {
+    for (const Scope *scope = current; scope; scope = scope->Parent) {
+        const auto &names = *scope->Layout;
+        const auto it = std::find(names.begin(), names.end(), id->Name);
+        if (it != names.end()) {
+            id->Slot = static_cast<int>(it - names.begin());
+            references.push_back(Reference{&id->Depth, current, scope});
+            return;
+        }
+    }
+    id->Depth = -1;
+    id->Slot = -1;
+}
+
+// 未绑定 this 的闭包沿作用域链向外查找, 因此外层的函数同样预留 this 槽位
+void Resolver::ResolveThis(ThisExpression *self) {
+    const Scope *target = nullptr;
+    for (const Scope *scope = current; scope; scope = scope->Parent) {
+        FunctionLiteral *func = scope->Function;
+        if (func == nullptr) {
+            continue;
+        }
+        if (func->ThisSlot < 0) {
+            static const Atom thisName = Atom::Intern("this");
+            scope->Layout->push_back(thisName);
+            func->ThisSlot = static_cast<int>(scope->Layout->size() - 1);
+        }
+        if (target == nullptr) {
+            target = scope;
+        }
+    }
+    if (target == nullptr) {
+        self->Depth = -1;
+        self->Slot = -1;
+        return;
+    }
+    self->Slot = target->Function->ThisSlot;
+    references.push_back(Reference{&self->Depth, current, target});
+}
+
+// 函数体延迟解析, 外层的代码块都可能被闭包持有
+void Resolver::Defer(FunctionLiteral *func) {
+    for (const Scope *scope = current; scope; scope = scope->Parent) {
+        if (scope->Captured) {
+            *scope->Captured = true;
+        }
+    }
+    pending.emplace_back(func, current);
+}
+
+void Resolver::ResolveFunction(FunctionLiteral *func, Scope *closure) {
+    current = closure;
+    BeginScope(func->Scope);
+    current->Function = func;
+    func->ThisSlot = -1;
+    for (const auto &param: func->Parameters->Parameters) {
+        const auto paramId = static_cast<Identifier *>(param.get());
+        paramId->Depth = 0;
+        paramId->Slot = Declare(paramId->Name);
+    }
+    ResolveStatement(func->Body.get());
+    EndScope();
+}
+
+void Resolver::ResolveStatement(Statement *stmt) {
+    switch (stmt->Kind) {
+        case NodeKind::VARIABLE_STATEMENT:
+            for (const auto &decl: static_cast<VariableStatement *>(stmt)->List) {
+                if (decl->Kind == NodeKind::VARIABLE) {
+                    ResolveExpression(decl.get());
+                }
+            }
+            break;
+        case NodeKind::IF: {
+            // ElseIf 不会被执行, 与 Execute 一致不做解析
+            const auto *ifStmt = static_cast<IfStatement *>(stmt);
+            ResolveExpression(ifStmt->Condition.get());
+            ResolveStatement(ifStmt->Ok.get());
+            if (ifStmt->Else) {
+                ResolveStatement(ifStmt->Else.get());
+            }
+            break;
+        }
+        case NodeKind::BLOCK: {
+            const auto block = static_cast<BlockStatement *>(stmt);
+            block->Captured = false;
+            BeginScope(block->Scope, true, &block->Captured);
+            for (const auto &s: block->StatementList) {
+                ResolveStatement(s.get());
+            }
+            EndScope();
+            break;
+        }
+        case NodeKind::EXPRESSION_STATEMENT:
+            ResolveExpression(static_cast<ExpressionStatement *>(stmt)->Expression.get());
+            break;
+        case NodeKind::FOR: {
+            const auto forStmt = static_cast<ForStatement *>(stmt);
+            BeginScope(forStmt->LoopScope, true);
+            ResolveExpression(forStmt->Initializer.get());
+            BeginScope(forStmt->IterationScope, true);
+            ResolveExpression(forStmt->Test.get());
+            ResolveStatement(forStmt->Body.get());
+            ResolveExpression(forStmt->Update.get());
+            EndScope();
+            EndScope();
+            break;
+        }
+        case NodeKind::THROW:
+            ResolveExpression(static_cast<ThrowStatement *>(stmt)->Argument.get());
+            break;
+        case NodeKind::TRY: {
+            const auto *tryStmt = static_cast<TryStatement *>(stmt);
+            ResolveStatement(tryStmt->Body.get());
+            if (tryStmt->Catch) {
+                BeginScope(tryStmt->Catch->Scope);
+                tryStmt->Catch->Parameter->Depth = 0;
+                tryStmt->Catch->Parameter->Slot = Declare(tryStmt->Catch->Parameter->Name);
+                ResolveStatement(tryStmt->Catch->Body.get());
+                EndScope();
+            }
+            if (tryStmt->Finally) {
+                ResolveStatement(tryStmt->Finally.get());
+            }
+            break;
+        }
+        case NodeKind::FUNCTION_STATEMENT:
+            // 顶层函数由 EvaluateProgram 提升为全局变量, 函数体同样延迟解析
+            Defer(static_cast<FunctionStatement *>(stmt)->Function.get());
+            break;
+        case NodeKind::RETURN:
+            ResolveExpression(static_cast<ReturnStatement *>(stmt)->Argument.get());
+            break;
+        default:
+            break;
+    }
+}
+
+void Resolver::ResolveExpression(Expression *expr) {
+    if (expr == nullptr) {
+        return;
+    }
+    switch (expr->Kind) {
+        case NodeKind::SEQUENCE:
+            for (const auto &subExpr: static_cast<SequenceExpression *>(expr)->Sequence) {
+                ResolveExpression(subExpr.get());
+            }
+            break;
+        case NodeKind::VARIABLE: {
+            // 先求初始值再声明, let a = a 引用的是外层的 a
+            const auto varExpr = static_cast<VariableExpression *>(expr);
+            ResolveExpression(varExpr->Initializer.get());
+            varExpr->Slot = Declare(varExpr->Name);
+            break;
+        }
+        case NodeKind::IDENTIFIER:
+            Resolve(static_cast<Identifier *>(expr));
+            break;
+        case NodeKind::THIS:
+            ResolveThis(static_cast<ThisExpression *>(expr));
+            break;
+        case NodeKind::NUMBER_LITERAL: {
+            const auto num = static_cast<NumberLiteral *>(expr);
+            num->Constant = NumberValue::Of(num->Value);
+            break;
+        }
+        case NodeKind::STRING_LITERAL: {
+            const auto str = static_cast<StringLiteral *>(expr);
+            str->Constant = std::make_shared<StringValue>(str->Literal);
+            break;
+        }
+        case NodeKind::OBJECT_LITERAL:
+            for (const auto &prop: static_cast<ObjectLiteral *>(expr)->Value) {
+                ResolveExpression(prop->Value.get());
+            }
+            break;
+        case NodeKind::ARRAY_LITERAL:
+            for (const auto &elemExpr: static_cast<ArrayLiteral *>(expr)->Value) {
+                ResolveExpression(elemExpr.get());
+            }
+            break;
+        case NodeKind::BINARY: {
+            const auto *bin = static_cast<BinaryExpression *>(expr);
+            ResolveExpression(bin->Left.get());
+            ResolveExpression(bin->Right.get());
+            break;
+        }
+        case NodeKind::UNARY:
+            ResolveExpression(static_cast<UnaryExpression *>(expr)->Operand.get());
+            break;
+        case NodeKind::ASSIGN: {
+            const auto *assign = static_cast<AssignExpression *>(expr);
+            ResolveExpression(assign->Right.get());
+            ResolveExpression(assign->Left.get());
+            break;
+        }
+        case NodeKind::DOT:
+            ResolveExpression(static_cast<DotExpression *>(expr)->Left.get());
+            break;
+        case NodeKind::BRACKET: {
+            const auto *bracket = static_cast<BracketExpression *>(expr);
+            ResolveExpression(bracket->Left.get());
+            ResolveExpression(bracket->Member.get());
+            break;
+        }
+        case NodeKind::CALL: {
+            const auto *call = static_cast<CallExpression *>(expr);
+            ResolveExpression(call->Callee.get());
+            for (const auto &argExpr: call->ArgumentList) {
+                ResolveExpression(argExpr.get());
+            }
+            break;
+        }
+        case NodeKind::FUNCTION_LITERAL:
+            Defer(static_cast<FunctionLiteral *>(expr));
+            break;
+        default:
+            break;
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    静态作用域解析: 把局部变量的访问解析为 (depth, slot)
+ */
+
+#ifndef BXSCRIPT_RESOLVER_H
+#define BXSCRIPT_RESOLVER_H
+
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "Expression.h"
+
+// 作用域的划分与 Interpreter 创建 Environment 的位置一一对应:
+// 代码块、for 的 loopEnv/iterationEnv、catch、函数调用各占一层.
+// 程序顶层 (全局、REPL、模块) 不解析, 仍按名字存取.
+// 代码块和 for 的作用域没有声明时不创建环境, 深度计算时跳过这些作用域.
+// this 解析为所在函数作用域的一个槽位, 由方法调用直接填入.
+// 同时为数字/字符串字面量生成常量值, 运行时不再重复转换.
+class Resolver {
+public:
+    static void ResolveProgram(Program &program);
+
+private:
+    struct Scope {
+        ScopeLayout *Layout;
+        Scope *Parent;
+        // 代码块/for 作用域没有声明时运行时不创建环境
+        bool Elidable;
+        bool *Captured;
+        // 函数作用域对应的函数, 其余作用域为 nullptr
+        FunctionLiteral *Function;
+
+        [[nodiscard]] bool Elided() const { return Elidable && Layout->empty(); }
+    };
+
+    // 引用所在作用域与变量所在作用域, 全部解析完后再计算深度
+    struct Reference {
+        int *Depth;
+        const Scope *From;
+        const Scope *Target;
+    };
+
+    // 地址需保持稳定, 延迟解析的函数会引用外层作用域
+    std::deque<Scope> scopes{};
+    // 函数体在外层作用域全部声明完之后再解析, 这样闭包可以引用之后才声明的变量
+    std::deque<std::pair<FunctionLiteral *, Scope *> > pending{};
+    std::vector<Reference> references{};
+    Scope *current = nullptr;
+
+    void ResolveStatement(Statement *stmt);
+
+    void ResolveExpression(Expression *expr);
+
+    void ResolveFunction(FunctionLiteral *func, Scope *closure);
+
+    void BeginScope(ScopeLayout &layout, bool elidable = false, bool *captured = nullptr);
+
+    void EndScope();
+
+    int Declare(const Atom &name) const;
+
+    void Resolve(Identifier *id);
+
+    void ResolveThis(ThisExpression *self);
+
+    void Defer(FunctionLiteral *func);
+};
+
+#endif //BXSCRIPT_RESOLVER_H
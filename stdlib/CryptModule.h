@@ -188,7 +188,7 @@ class CryptModule {
     static void InitCRC32(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args) -> ValuePtr {
-                if (args.empty()) return std::make_shared<NumberValue>(0);
+                if (args.empty()) return NumberValue::Of(0);
                 std::string str = args[0]->ToString();
                 uint32_t res = crc32_bitwise(str);
                 std::stringstream ss;
@@ -200,14 +200,11 @@ class CryptModule {
 
 public:
     static ValuePtr CreateCryptModule() {
-        auto cryptObj = std::make_shared<ObjectValue>();
-        InitBase64Encode(cryptObj);
-        InitBase64Decode(cryptObj);
-        initMd5(cryptObj);
-        initSha256(cryptObj);
-        initHmac(cryptObj);
-        InitCRC32(cryptObj);
-        return cryptObj;
+        static const std::vector<ObjectValue::LazyMember> members = {
+            {"encode", InitBase64Encode}, {"decode", InitBase64Decode}, {"md5", initMd5},
+            {"sha256", initSha256}, {"hmac", initHmac}, {"crc32", InitCRC32},
+        };
+        return ObjectValue::Lazy(members);
     }
 };
 
@@ -33,13 +33,13 @@ class DateModule {
     }
 
     static void FillDateObject(std::shared_ptr<ObjectValue> o, double timestamp, const tm *ptm) {
-        o->Set("timestamp", std::make_shared<NumberValue>(timestamp));
-        o->Set("year", std::make_shared<NumberValue>(static_cast<double>(ptm->tm_year + 1900)));
-        o->Set("month", std::make_shared<NumberValue>(static_cast<double>(ptm->tm_mon + 1)));
-        o->Set("day", std::make_shared<NumberValue>(static_cast<double>(ptm->tm_mday)));
-        o->Set("hour", std::make_shared<NumberValue>(static_cast<double>(ptm->tm_hour)));
-        o->Set("minute", std::make_shared<NumberValue>(static_cast<double>(ptm->tm_min)));
-        o->Set("second", std::make_shared<NumberValue>(static_cast<double>(ptm->tm_sec)));
+        o->Set("timestamp", NumberValue::Of(timestamp));
+        o->Set("year", NumberValue::Of(static_cast<double>(ptm->tm_year + 1900)));
+        o->Set("month", NumberValue::Of(static_cast<double>(ptm->tm_mon + 1)));
+        o->Set("day", NumberValue::Of(static_cast<double>(ptm->tm_mday)));
+        o->Set("hour", NumberValue::Of(static_cast<double>(ptm->tm_hour)));
+        o->Set("minute", NumberValue::Of(static_cast<double>(ptm->tm_min)));
+        o->Set("second", NumberValue::Of(static_cast<double>(ptm->tm_sec)));
     }
 
     static void SkipSeparators(std::istream &is) {
@@ -112,7 +112,7 @@ class DateModule {
         std::weak_ptr weak_o = o;
         const auto formatFn = std::make_shared<NativeFunctionValue>(
             [weak_o](const std::vector<ValuePtr> &args) -> ValuePtr {
-                if (args.empty()) return std::make_shared<NullValue>();
+                if (args.empty()) return NullValue::Instance();
                 const auto self = weak_o.lock();
                 std::string fmt = "yyyy-MM-dd HH:mm:ss";
                 if (args[0]->type != ValueType::STRING) {
@@ -123,7 +123,7 @@ class DateModule {
                 const auto timestamp = self->Get("timestamp");
                 // 理论上只有可能为NULL或者NUMBER
                 if (timestamp->type == ValueType::NULL_TYPE) {
-                    return std::make_shared<NullValue>();
+                    return NullValue::Instance();
                 }
                 if (timestamp->type != ValueType::NUMBER) {
                     Logger::Error("参数错误: 内部timestamp类型错误");
@@ -148,10 +148,10 @@ class DateModule {
 
 public:
     static ValuePtr CreateDateModule() {
-        auto dateObj = std::make_shared<ObjectValue>();
-        initNow(dateObj);
-        initFrom(dateObj);
-        return dateObj;
+        static const std::vector<ObjectValue::LazyMember> members = {
+            {"now", initNow}, {"from", initFrom},
+        };
+        return ObjectValue::Lazy(members);
     }
 };
 
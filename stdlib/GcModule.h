@@ -0,0 +1,56 @@
+/**
+ * @project  BxScript (JS-like Scripting Language)
+ * @author   BurNingLi
+ * @date     2025-12-15
+ * @license  MIT License
+ *
+ * @warning  USAGE DISCLAIMER / 免责声明
+ * BxScript 仅供技术研究与合法开发。严禁用于灰产、黑客攻击等任何非法用途。
+ * 开发者 BurNingLi 不承担因违规使用产生的任何法律责任。
+ *
+ * @brief    内存回收标准库
+ */
+
+#ifndef BXSCRIPT_GCMODULE_H
+#define BXSCRIPT_GCMODULE_H
+
+#include "evaluator/Collector.h"
+#include "evaluator/Value.h"
+
+class GcModule {
+    static void initCollect(std::shared_ptr<ObjectValue> &o) {
+        const auto fn = std::make_shared<NativeFunctionValue>(
+            [](const std::vector<ValuePtr> &args) -> ValuePtr {
+                return std::make_shared<NumberValue>(static_cast<double>(Collector::Collect()));
+            });
+        o->Set("collect", fn);
+    }
+
+    static void initStats(std::shared_ptr<ObjectValue> &o) {
+        const auto fn = std::make_shared<NativeFunctionValue>(
+            [](const std::vector<ValuePtr> &args) -> ValuePtr {
+                const auto [environments, objects, arrays, functions, collections, freed, lastFreed] =
+                        Collector::GetStats();
+                auto stats = std::make_shared<ObjectValue>();
+                stats->Set("environments", std::make_shared<NumberValue>(static_cast<double>(environments)));
+                stats->Set("objects", std::make_shared<NumberValue>(static_cast<double>(objects)));
+                stats->Set("arrays", std::make_shared<NumberValue>(static_cast<double>(arrays)));
+                stats->Set("functions", std::make_shared<NumberValue>(static_cast<double>(functions)));
+                stats->Set("collections", std::make_shared<NumberValue>(static_cast<double>(collections)));
+                stats->Set("freed", std::make_shared<NumberValue>(static_cast<double>(freed)));
+                stats->Set("lastFreed", std::make_shared<NumberValue>(static_cast<double>(lastFreed)));
+                return stats;
+            });
+        o->Set("stats", fn);
+    }
+
+public:
+    static ValuePtr CreateGcModule() {
+        static const std::vector<ObjectValue::LazyMember> members = {
+            {"collect", initCollect}, {"stats", initStats},
+        };
+        return ObjectValue::Lazy(members);
+    }
+};
+
+#endif //BXSCRIPT_GCMODULE_H
@@ -18,7 +18,7 @@
 
 class GuiModule {
     static ValuePtr CreateWidget(const std::shared_ptr<ObjectValue> &winObj, const std::string &type, const std::vector<ValuePtr> &args) {
-        if (args.empty()) return std::make_shared<NullValue>();
+        if (args.empty()) return NullValue::Instance();
         auto widget = std::make_shared<ObjectValue>();
         widget->Set("_type", std::make_shared<StringValue>(type));
         const std::string id = args[0]->ToString();
@@ -36,10 +36,10 @@ class GuiModule {
 
     static ValuePtr ArgsColorToObject(const std::vector<ValuePtr> &args) {
         auto fc = std::make_shared<ObjectValue>();
-        fc->Set("R", std::make_shared<NumberValue>(45));
-        fc->Set("G", std::make_shared<NumberValue>(45));
-        fc->Set("B", std::make_shared<NumberValue>(48));
-        fc->Set("A", std::make_shared<NumberValue>(255));
+        fc->Set("R", NumberValue::Of(45));
+        fc->Set("G", NumberValue::Of(45));
+        fc->Set("B", NumberValue::Of(48));
+        fc->Set("A", NumberValue::Of(255));
         if (!args.empty()) {
             if (args[0]->type == ValueType::OBJECT) {
                 const auto obj = std::static_pointer_cast<ObjectValue>(args[0]);
@@ -55,10 +55,10 @@ class GuiModule {
             } else if (args[0]->type == ValueType::STRING) {
                 const auto str = std::static_pointer_cast<StringValue>(args[0])->Value;
                 const auto [r, g, b, a] = ColorKit::HexToRgba(str.c_str());
-                fc->Set("R", std::make_shared<NumberValue>(r));
-                fc->Set("G", std::make_shared<NumberValue>(g));
-                fc->Set("B", std::make_shared<NumberValue>(b));
-                fc->Set("A", std::make_shared<NumberValue>(a));
+                fc->Set("R", NumberValue::Of(r));
+                fc->Set("G", NumberValue::Of(g));
+                fc->Set("B", NumberValue::Of(b));
+                fc->Set("A", NumberValue::Of(a));
             }
         }
         return std::move(fc);
@@ -69,7 +69,7 @@ class GuiModule {
         auto const srcFn = std::make_shared<NativeFunctionValue>(
             [weak_w](const std::vector<ValuePtr> &args) -> ValuePtr {
                 auto self = weak_w.lock();
-                if (!self || args.empty()) return std::make_shared<NullValue>();
+                if (!self || args.empty()) return NullValue::Instance();
                 self->Set("src", std::make_shared<StringValue>(args[0]->ToString()));
                 return self;
             }
@@ -83,8 +83,8 @@ class GuiModule {
         auto const centerFn = std::make_shared<NativeFunctionValue>(
             [weak_w](const std::vector<ValuePtr> &) -> ValuePtr {
                 auto self = weak_w.lock();
-                if (!self) return std::make_shared<NullValue>();
-                self->Set("center", std::make_shared<BoolValue>(true));
+                if (!self) return NullValue::Instance();
+                self->Set("center", BoolValue::Of(true));
                 return self;
             }
         );
@@ -94,7 +94,7 @@ class GuiModule {
         auto const fn = std::make_shared<NativeFunctionValue>(
             [weak_w](const std::vector<ValuePtr> &addArgs) -> ValuePtr {
                 auto self = weak_w.lock();
-                if (!self) return std::make_shared<NullValue>();
+                if (!self) return NullValue::Instance();
                 const auto childrenVal = self->Get("children");
                 std::shared_ptr<ArrayValue> children;
                 if (!childrenVal || childrenVal->type == ValueType::NULL_TYPE) {
@@ -106,9 +106,10 @@ class GuiModule {
                 if (!addArgs.empty()) {
                     if (addArgs[0]->type == ValueType::ARRAY) {
                         const auto arr = std::static_pointer_cast<ArrayValue>(addArgs[0]);
-                        children->Elements.insert(children->Elements.end(), arr->Elements.begin(), arr->Elements.end());
+                        const auto added = arr->Slice(0, arr->Size());
+                        children->Boxed().insert(children->Boxed().end(), added.begin(), added.end());
                     } else if (addArgs[0]->type == ValueType::OBJECT) {
-                        children->Elements.push_back(addArgs[0]);
+                        children->Push(addArgs[0]);
                     }
                 }
                 return self;
@@ -119,18 +120,18 @@ class GuiModule {
 
     static void InjectLayoutMethods(const std::shared_ptr<ObjectValue> &widget) {
         // 托底，保证属性健全, 不考虑内存，如果下方覆盖了，则计数归0
-        widget->Set("x", std::make_shared<NumberValue>(0));
-        widget->Set("y", std::make_shared<NumberValue>(0));
-        widget->Set("fontSize", std::make_shared<NumberValue>(16));
-        widget->Set("visible", std::make_shared<BoolValue>(true));
-        widget->Set("disable", std::make_shared<BoolValue>(false));
+        widget->Set("x", NumberValue::Of(0));
+        widget->Set("y", NumberValue::Of(0));
+        widget->Set("fontSize", NumberValue::Of(16));
+        widget->Set("visible", BoolValue::Of(true));
+        widget->Set("disable", BoolValue::Of(false));
         widget->Set("align", std::make_shared<StringValue>("left"));
         std::weak_ptr weak_w = widget;
         // pos(x, y)
         const auto posFn = std::make_shared<NativeFunctionValue>(
             [weak_w](const std::vector<ValuePtr> &args) -> ValuePtr {
                 auto self = weak_w.lock();
-                if (!self) return std::make_shared<NullValue>();
+                if (!self) return NullValue::Instance();
                 if (args.empty()) return self;
                 if (args[0]->type == ValueType::OBJECT) {
                     auto const x = args[0]->Get("x");
@@ -154,7 +155,7 @@ class GuiModule {
         auto const sizeFn = std::make_shared<NativeFunctionValue>(
             [weak_w](const std::vector<ValuePtr> &args) -> ValuePtr {
                 auto self = weak_w.lock();
-                if (!self) return std::make_shared<NullValue>();
+                if (!self) return NullValue::Instance();
                 if (args[0]->type == ValueType::OBJECT) {
                     if (args[0]->Get("width") && args[0]->Get("width")->type == ValueType::NUMBER) {
                         self->Set("width", args[0]->Get("width"));
@@ -174,7 +175,7 @@ class GuiModule {
         auto const fontSizeFn = std::make_shared<NativeFunctionValue>(
             [weak_w](const std::vector<ValuePtr> &args) -> ValuePtr {
                 auto self = weak_w.lock();
-                if (!self) return std::make_shared<NullValue>();
+                if (!self) return NullValue::Instance();
                 if (!args.empty() && args[0]->type == ValueType::NUMBER) {
                     self->Set("fontSize", std::move(std::static_pointer_cast<NumberValue>(args[0])));
                 }
@@ -186,7 +187,7 @@ class GuiModule {
         auto const fontColorFn = std::make_shared<NativeFunctionValue>(
             [weak_w](const std::vector<ValuePtr> &args) -> ValuePtr {
                 auto self = weak_w.lock();
-                if (!self) return std::make_shared<NullValue>();
+                if (!self) return NullValue::Instance();
                 // ArgsColorToObject 有缺省托底
                 self->Set("fontColor", ArgsColorToObject(args));
                 return self;
@@ -197,7 +198,7 @@ class GuiModule {
         auto const textFn = std::make_shared<NativeFunctionValue>(
             [weak_w](const std::vector<ValuePtr> &args) -> ValuePtr {
                 auto self = weak_w.lock();
-                if (!self) return std::make_shared<NullValue>();
+                if (!self) return NullValue::Instance();
                 std::string str{};
                 if (!args.empty()) {
                     str = args[0]->ToString();
@@ -211,7 +212,7 @@ class GuiModule {
         auto const clickFn = std::make_shared<NativeFunctionValue>(
             [weak_w](const std::vector<ValuePtr> &args) -> ValuePtr {
                 auto self = weak_w.lock();
-                if (!self) return std::make_shared<NullValue>();
+                if (!self) return NullValue::Instance();
                 if (!args.empty() && args[0]->type == ValueType::FUNCTION) {
                     self->Set("onClick", args[0]);
                 }
@@ -223,7 +224,7 @@ class GuiModule {
         auto const bgColorFn = std::make_shared<NativeFunctionValue>(
             [weak_w](const std::vector<ValuePtr> &args) -> ValuePtr {
                 auto self = weak_w.lock();
-                if (!self) return std::make_shared<NullValue>();
+                if (!self) return NullValue::Instance();
                 self->Set("backgroundColor", ArgsColorToObject(args));
                 return self;
             });
@@ -233,7 +234,7 @@ class GuiModule {
         auto const borderFn = std::make_shared<NativeFunctionValue>(
             [weak_w](const std::vector<ValuePtr> &args) -> ValuePtr {
                 auto self = weak_w.lock();
-                if (!self) return std::make_shared<NullValue>();
+                if (!self) return NullValue::Instance();
                 if (!args.empty()) {
                     if (args[0]->type == ValueType::NUMBER) {
                         self->Set("borderWidth", args[0]);
@@ -258,8 +259,8 @@ class GuiModule {
         auto const hideFn = std::make_shared<NativeFunctionValue>(
             [weak_w](const std::vector<ValuePtr> &) -> ValuePtr {
                 auto const self = weak_w.lock();
-                if (!self) return std::make_shared<NullValue>();
-                self->Set("visible", std::make_shared<BoolValue>(false));
+                if (!self) return NullValue::Instance();
+                self->Set("visible", BoolValue::Of(false));
                 return self;
             });
         widget->Set("hide", hideFn);
@@ -268,8 +269,8 @@ class GuiModule {
         auto const showFn = std::make_shared<NativeFunctionValue>(
             [weak_w](const std::vector<ValuePtr> &) -> ValuePtr {
                 auto const self = weak_w.lock();
-                if (!self) return std::make_shared<NullValue>();
-                self->Set("visible", std::make_shared<BoolValue>(true));
+                if (!self) return NullValue::Instance();
+                self->Set("visible", BoolValue::Of(true));
                 return self;
             });
         widget->Set("show", showFn);
@@ -278,12 +279,12 @@ class GuiModule {
         auto const disableFn = std::make_shared<NativeFunctionValue>(
             [weak_w](const std::vector<ValuePtr> &args) -> ValuePtr {
                 auto self = weak_w.lock();
-                if (!self) return std::make_shared<NullValue>();
-                auto const disable = std::make_shared<BoolValue>(true);
+                if (!self) return NullValue::Instance();
+                bool disable = true;
                 if (!args.empty() && args[0]->type == ValueType::BOOL) {
-                    disable->Value = std::static_pointer_cast<BoolValue>(args[0])->Value;
+                    disable = std::static_pointer_cast<BoolValue>(args[0])->Value;
                 }
-                self->Set("disable", disable);
+                self->Set("disable", BoolValue::Of(disable));
                 return self;
             });
         widget->Set("disable", disableFn);
@@ -292,7 +293,7 @@ class GuiModule {
         auto const alignFn = std::make_shared<NativeFunctionValue>(
             [weak_w](const std::vector<ValuePtr> &args) -> ValuePtr {
                 auto self = weak_w.lock();
-                if (!self) return std::make_shared<NullValue>();
+                if (!self) return NullValue::Instance();
                 if (!args.empty() && args[0]->type == ValueType::STRING) {
                     auto const alignStr = args[0]->ToString();
                     if (alignStr == "left" || alignStr == "right" || alignStr == "center") {
@@ -307,7 +308,7 @@ class GuiModule {
         auto const changeFn = std::make_shared<NativeFunctionValue>(
             [weak_w](const std::vector<ValuePtr> &args) -> ValuePtr {
                 auto self = weak_w.lock();
-                if (!self) return std::make_shared<NullValue>();
+                if (!self) return NullValue::Instance();
                 if (!args.empty() && args[0]->type == ValueType::FUNCTION) {
                     self->Set("change", args[0]);
                 }
@@ -319,7 +320,7 @@ class GuiModule {
         auto const hoverFn = std::make_shared<NativeFunctionValue>(
             [weak_w](const std::vector<ValuePtr> &args) -> ValuePtr {
                 auto self = weak_w.lock();
-                if (!self) return std::make_shared<NullValue>();
+                if (!self) return NullValue::Instance();
                 if (!args.empty() && args[0]->type == ValueType::FUNCTION) {
                     self->Set("hover", args[0]);
                 }
@@ -331,7 +332,7 @@ class GuiModule {
         auto const paddingFn = std::make_shared<NativeFunctionValue>(
             [weak_w](const std::vector<ValuePtr> &args) -> ValuePtr {
                 auto self = weak_w.lock();
-                if (!self) return std::make_shared<NullValue>();
+                if (!self) return NullValue::Instance();
                 if (!args.empty()) {
                     if (args.size() == 2) {
                         self->Set("padding-top", args[0]);
@@ -373,33 +374,33 @@ class GuiModule {
         o->Set("form", fn);
     }
 
-    static void InitControls(std::shared_ptr<ObjectValue> &o) {
-        auto makeFactory = [o](const std::string &type) {
-            std::weak_ptr<ObjectValue> weak_o = o;
-            return std::make_shared<NativeFunctionValue>(
-                [weak_o, type](const std::vector<ValuePtr> &args) -> ValuePtr {
-                    const auto self = weak_o.lock();
-                    return CreateWidget(self, type, args);
-                }
-            );
-        };
-        o->Set("button", makeFactory("button"));
-        o->Set("label", makeFactory("label"));
-        o->Set("input", makeFactory("input"));
-        o->Set("password", makeFactory("password"));
-        o->Set("group", makeFactory("group"));
-        o->Set("checkbox", makeFactory("checkbox"));
-        o->Set("slider", makeFactory("slider"));
-        o->Set("progress", makeFactory("progress"));
-        o->Set("image", makeFactory("image"));
+    // 控件工厂, 成员名即控件类型
+    static void InitControl(std::shared_ptr<ObjectValue> &o, const std::string &type) {
+        std::weak_ptr<ObjectValue> weak_o = o;
+        o->Set(type, std::make_shared<NativeFunctionValue>(
+            [weak_o, type](const std::vector<ValuePtr> &args) -> ValuePtr {
+                const auto self = weak_o.lock();
+                return CreateWidget(self, type, args);
+            }
+        ));
     }
 
 public:
     static ValuePtr CreateGuiModule() {
-        auto win = std::make_shared<ObjectValue>();
+        static const std::vector<ObjectValue::LazyMember> members = {
+            {"form", InitForm},
+            {"button", [](std::shared_ptr<ObjectValue> &o) { InitControl(o, "button"); }},
+            {"label", [](std::shared_ptr<ObjectValue> &o) { InitControl(o, "label"); }},
+            {"input", [](std::shared_ptr<ObjectValue> &o) { InitControl(o, "input"); }},
+            {"password", [](std::shared_ptr<ObjectValue> &o) { InitControl(o, "password"); }},
+            {"group", [](std::shared_ptr<ObjectValue> &o) { InitControl(o, "group"); }},
+            {"checkbox", [](std::shared_ptr<ObjectValue> &o) { InitControl(o, "checkbox"); }},
+            {"slider", [](std::shared_ptr<ObjectValue> &o) { InitControl(o, "slider"); }},
+            {"progress", [](std::shared_ptr<ObjectValue> &o) { InitControl(o, "progress"); }},
+            {"image", [](std::shared_ptr<ObjectValue> &o) { InitControl(o, "image"); }},
+        };
+        auto win = ObjectValue::Lazy(members);
         win->Set("refs", std::make_shared<ObjectValue>());
-        InitForm(win);
-        InitControls(win);
         return win;
     }
 
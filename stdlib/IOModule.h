@@ -32,7 +32,7 @@ class IOModule {
                     output += v->ToString();
                 }
                 std::cout << output << std::endl;
-                return std::make_shared<NullValue>();
+                return NullValue::Instance();
             });
         o->Set("println", fn);
     }
@@ -48,7 +48,7 @@ class IOModule {
                     output += v->ToString();
                 }
                 std::cout << output;
-                return std::make_shared<NullValue>();
+                return NullValue::Instance();
             });
         o->Set("print", fn);
     }
@@ -70,9 +70,9 @@ class IOModule {
         auto const fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
                 if (args.empty()) {
-                    return std::make_shared<BoolValue>(false);
+                    return BoolValue::Of(false);
                 }
-                return std::make_shared<BoolValue>(fs::exists(args[0]->ToString()));
+                return BoolValue::Of(fs::exists(args[0]->ToString()));
             });
         o->Set("exist", fn);
     }
@@ -81,9 +81,9 @@ class IOModule {
         auto const fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
                 if (args.empty()) {
-                    return std::make_shared<BoolValue>(false);
+                    return BoolValue::Of(false);
                 }
-                return std::make_shared<BoolValue>(fs::is_regular_file(args[0]->ToString()));
+                return BoolValue::Of(fs::is_regular_file(args[0]->ToString()));
             });
         o->Set("isFile", fn);
     }
@@ -92,9 +92,9 @@ class IOModule {
         auto const fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
                 if (args.empty()) {
-                    return std::make_shared<BoolValue>(false);
+                    return BoolValue::Of(false);
                 }
-                return std::make_shared<BoolValue>(fs::is_directory(args[0]->ToString()));
+                return BoolValue::Of(fs::is_directory(args[0]->ToString()));
             });
         o->Set("isDir", fn);
     }
@@ -103,9 +103,9 @@ class IOModule {
         auto const fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
                 if (args.empty()) {
-                    return std::make_shared<BoolValue>(false);
+                    return BoolValue::Of(false);
                 }
-                return std::make_shared<BoolValue>(fs::create_directories(args[0]->ToString()));
+                return BoolValue::Of(fs::create_directories(args[0]->ToString()));
             });
         o->Set("mkdir", fn);
     }
@@ -114,9 +114,9 @@ class IOModule {
         auto const fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
                 if (args.empty()) {
-                    return std::make_shared<BoolValue>(false);
+                    return BoolValue::Of(false);
                 }
-                return std::make_shared<BoolValue>(fs::remove_all(args[0]->ToString()));
+                return BoolValue::Of(fs::remove_all(args[0]->ToString()));
             });
         o->Set("remove", fn);
     }
@@ -125,13 +125,13 @@ class IOModule {
         auto const fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
                 if (args.size() != 2) {
-                    return std::make_shared<BoolValue>(false);
+                    return BoolValue::Of(false);
                 }
                 if (args[0]->type != ValueType::STRING || args[1]->type != ValueType::STRING) {
-                    return std::make_shared<BoolValue>(false);
+                    return BoolValue::Of(false);
                 }
                 fs::copy(args[0]->ToString(), args[1]->ToString());
-                return std::make_shared<BoolValue>(true);
+                return BoolValue::Of(true);
             });
         o->Set("copy", fn);
     }
@@ -140,13 +140,13 @@ class IOModule {
         auto const fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
                 if (args.empty()) {
-                    return std::make_shared<BoolValue>(false);
+                    return BoolValue::Of(false);
                 }
                 if (args[0]->type != ValueType::STRING || args[1]->type != ValueType::STRING) {
-                    return std::make_shared<BoolValue>(false);
+                    return BoolValue::Of(false);
                 }
                 fs::rename(args[0]->ToString(), args[1]->ToString());
-                return std::make_shared<BoolValue>(true);
+                return BoolValue::Of(true);
             });
         o->Set("rename", fn);
     }
@@ -165,17 +165,17 @@ class IOModule {
                     auto o = std::make_shared<ObjectValue>();
                     if (f.is_directory()) {
                         o->Set("type", std::make_shared<StringValue>("dir"));
-                        o->Set("size", std::make_shared<NumberValue>(0));
+                        o->Set("size", NumberValue::Of(0));
                     } else {
                         o->Set("type", std::make_shared<StringValue>("file"));
                         double size = 0;
                         if (f.is_regular_file()) {
                             size = static_cast<double>(f.file_size());
                         }
-                        o->Set("size", std::make_shared<NumberValue>(size));
+                        o->Set("size", NumberValue::Of(size));
                     }
                     o->Set("lastModified", std::make_shared<StringValue>(TimeKit::GetFileLastTime(f)));
-                    arrs->Elements.push_back(o);
+                    arrs->Push(o);
                 }
                 return std::move(arrs);
             });
@@ -203,11 +203,11 @@ class IOModule {
                 auto o = std::make_shared<ObjectValue>();
                 auto f = fs::path(args[0]->ToString());
                 if (exists(f)) {
-                    o->Set("size", std::make_shared<NumberValue>(file_size(f)));
+                    o->Set("size", NumberValue::Of(file_size(f)));
                     o->Set("name", std::make_shared<StringValue>(f.filename().string()));
-                    o->Set("size", std::make_shared<NumberValue>(0));
+                    o->Set("size", NumberValue::Of(0));
                     if (fs::is_regular_file(f)) {
-                        o->Set("size", std::make_shared<NumberValue>(static_cast<double>(fs::file_size(f))));
+                        o->Set("size", NumberValue::Of(static_cast<double>(fs::file_size(f))));
                     }
                 }
                 return o;
@@ -218,10 +218,10 @@ class IOModule {
     static void InitRead(std::shared_ptr<ObjectValue> &o) {
         auto const fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty()) return std::make_shared<NullValue>();
+                if (args.empty()) return NullValue::Instance();
                 const std::string path = args[0]->ToString();
                 std::ifstream file(path, std::ios::binary | std::ios::ate);
-                if (!file.is_open()) return std::make_shared<NullValue>();
+                if (!file.is_open()) return NullValue::Instance();
                 const std::streamsize size = file.tellg();
                 file.seekg(0, std::ios::beg);
                 std::vector<unsigned char> buffer(size);
@@ -232,7 +232,7 @@ class IOModule {
                     }
                     return std::make_shared<BufferValue>(std::move(buffer));
                 }
-                return std::make_shared<NullValue>();
+                return NullValue::Instance();
             });
         o->Set("read", fn);
     }
@@ -240,11 +240,11 @@ class IOModule {
     static void InitWrite(std::shared_ptr<ObjectValue> &o) {
         auto const fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.size() < 2) return std::make_shared<BoolValue>(false);
+                if (args.size() < 2) return BoolValue::Of(false);
                 const std::string path = args[0]->ToString();
                 const auto& data = args[1];
                 std::ofstream file(path, std::ios::binary);
-                if (!file.is_open()) return std::make_shared<BoolValue>(false);
+                if (!file.is_open()) return BoolValue::Of(false);
                 if (data->type == ValueType::STRING) {
                     const std::string str = std::static_pointer_cast<StringValue>(data)->Value;
                     file.write(str.c_str(), str.size());
@@ -252,30 +252,21 @@ class IOModule {
                     const auto buf = std::static_pointer_cast<BufferValue>(data);
                     file.write((char *) buf->Buffer.data(), buf->Buffer.size());
                 }
-                return std::make_shared<BoolValue>(true);
+                return BoolValue::Of(true);
             });
         o->Set("write", fn);
     }
 
 public:
     static ValuePtr CreateIOModule() {
-        auto module = std::make_shared<ObjectValue>();
-        InitPrintln(module);
-        InitPrint(module);
-        InitInput(module);
-        InitExist(module);
-        InitIsFile(module);
-        InitIsDir(module);
-        InitMkdir(module);
-        InitRemove(module);
-        InitCopyFile(module);
-        InitRename(module);
-        InitList(module);
-        InitAbs(module);
-        InitAttr(module);
-        InitRead(module);
-        InitWrite(module);
-        return module;
+        static const std::vector<ObjectValue::LazyMember> members = {
+            {"println", InitPrintln}, {"print", InitPrint}, {"input", InitInput},
+            {"exist", InitExist}, {"isFile", InitIsFile}, {"isDir", InitIsDir},
+            {"mkdir", InitMkdir}, {"remove", InitRemove}, {"copy", InitCopyFile},
+            {"rename", InitRename}, {"list", InitList}, {"abs", InitAbs},
+            {"attr", InitAttr}, {"read", InitRead}, {"write", InitWrite},
+        };
+        return ObjectValue::Lazy(members);
     }
 };
 
@@ -35,7 +35,7 @@ class JsonModule {
                     ss << "JSON 解析失败 (byte " << e.byte << "): " << e.what();
                     Logger::Error(ss.str());
                 }
-                return std::make_shared<NullValue>();
+                return NullValue::Instance();
             });
         o->Set("parse", fn);
     }
@@ -53,10 +53,10 @@ class JsonModule {
 
 public:
     static ValuePtr CreateJsonModule() {
-        auto jsonObj = std::make_shared<ObjectValue>();
-        initParse(jsonObj);
-        initStringify(jsonObj);
-        return jsonObj;
+        static const std::vector<ObjectValue::LazyMember> members = {
+            {"parse", initParse}, {"stringify", initStringify},
+        };
+        return ObjectValue::Lazy(members);
     }
 };
 #endif //BXSCRIPT_JSONMODULE_H
@@ -28,15 +28,15 @@ class MathModule {
     }
 
     static void InitPI(std::shared_ptr<ObjectValue> &o) {
-        o->Set("PI", std::make_shared<NumberValue>(3.141592653589793));
+        o->Set("PI", NumberValue::Of(3.141592653589793));
     }
 
     static void InitRound(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::round(v->Value));
+                return NumberValue::Of(std::round(v->Value));
             });
         o->Set("round", fn);
     }
@@ -44,9 +44,9 @@ class MathModule {
     static void InitLog(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::log(v->Value));
+                return NumberValue::Of(std::log(v->Value));
             });
         o->Set("log", fn);
     }
@@ -54,9 +54,9 @@ class MathModule {
     static void InitLog10(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::log10(v->Value));
+                return NumberValue::Of(std::log10(v->Value));
             });
         o->Set("log10", fn);
     }
@@ -64,9 +64,9 @@ class MathModule {
     static void InitLog1p(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::log1p(v->Value));
+                return NumberValue::Of(std::log1p(v->Value));
             });
         o->Set("log1p", fn);
     }
@@ -74,9 +74,9 @@ class MathModule {
     static void InitLog2(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::log2(v->Value));
+                return NumberValue::Of(std::log2(v->Value));
             });
         o->Set("log2", fn);
     }
@@ -85,11 +85,11 @@ class MathModule {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
                 if (args.size() != 2 || args[0]->type != ValueType::NUMBER || args[1]->type != ValueType::NUMBER) {
-                    return std::make_shared<NullValue>();
+                    return NullValue::Instance();
                 }
                 auto v1 = std::static_pointer_cast<NumberValue>(args[0]);
                 auto v2 = std::static_pointer_cast<NumberValue>(args[1]);
-                return std::make_shared<NumberValue>(std::pow(v1->Value, v2->Value));
+                return NumberValue::Of(std::pow(v1->Value, v2->Value));
             });
         o->Set("pow", fn);
     }
@@ -97,9 +97,9 @@ class MathModule {
     static void InitSqrt(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::sqrt(v->Value));
+                return NumberValue::Of(std::sqrt(v->Value));
             });
         o->Set("sqrt", fn);
     }
@@ -107,9 +107,9 @@ class MathModule {
     static void InitAbs(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::abs(v->Value));
+                return NumberValue::Of(std::abs(v->Value));
             });
         o->Set("abs", fn);
     }
@@ -117,9 +117,9 @@ class MathModule {
     static void InitCeil(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::ceil(v->Value));
+                return NumberValue::Of(std::ceil(v->Value));
             });
         o->Set("ceil", fn);
     }
@@ -127,9 +127,9 @@ class MathModule {
     static void InitFloor(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::floor(v->Value));
+                return NumberValue::Of(std::floor(v->Value));
             });
         o->Set("floor", fn);
     }
@@ -137,9 +137,9 @@ class MathModule {
     static void InitCbrt(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::cbrt(v->Value));
+                return NumberValue::Of(std::cbrt(v->Value));
             });
         o->Set("cbrt", fn);
     }
@@ -147,9 +147,9 @@ class MathModule {
     static void InitSin(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::sin(v->Value));
+                return NumberValue::Of(std::sin(v->Value));
             });
         o->Set("sin", fn);
     }
@@ -157,9 +157,9 @@ class MathModule {
     static void InitSinh(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::sinh(v->Value));
+                return NumberValue::Of(std::sinh(v->Value));
             });
         o->Set("sinh", fn);
     }
@@ -167,9 +167,9 @@ class MathModule {
     static void InitASin(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::asin(v->Value));
+                return NumberValue::Of(std::asin(v->Value));
             });
         o->Set("asin", fn);
     }
@@ -177,9 +177,9 @@ class MathModule {
     static void InitASinh(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::asinh(v->Value));
+                return NumberValue::Of(std::asinh(v->Value));
             });
         o->Set("asinh", fn);
     }
@@ -187,9 +187,9 @@ class MathModule {
     static void InitCos(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::cos(v->Value));
+                return NumberValue::Of(std::cos(v->Value));
             });
         o->Set("cos", fn);
     }
@@ -197,9 +197,9 @@ class MathModule {
     static void InitCosh(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::cosh(v->Value));
+                return NumberValue::Of(std::cosh(v->Value));
             });
         o->Set("cosh", fn);
     }
@@ -207,9 +207,9 @@ class MathModule {
     static void InitACos(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::acos(v->Value));
+                return NumberValue::Of(std::acos(v->Value));
             });
         o->Set("acos", fn);
     }
@@ -217,9 +217,9 @@ class MathModule {
     static void InitACosh(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::acosh(v->Value));
+                return NumberValue::Of(std::acosh(v->Value));
             });
         o->Set("acosh", fn);
     }
@@ -227,9 +227,9 @@ class MathModule {
     static void InitTan(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::tan(v->Value));
+                return NumberValue::Of(std::tan(v->Value));
             });
         o->Set("tan", fn);
     }
@@ -237,9 +237,9 @@ class MathModule {
     static void InitTanh(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::tanh(v->Value));
+                return NumberValue::Of(std::tanh(v->Value));
             });
         o->Set("tanh", fn);
     }
@@ -247,9 +247,9 @@ class MathModule {
     static void InitATan(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::atan(v->Value));
+                return NumberValue::Of(std::atan(v->Value));
             });
         o->Set("atan", fn);
     }
@@ -257,9 +257,9 @@ class MathModule {
     static void InitATanh(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::atanh(v->Value));
+                return NumberValue::Of(std::atanh(v->Value));
             });
         o->Set("atanh", fn);
     }
@@ -267,9 +267,9 @@ class MathModule {
     static void InitExp(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::exp(v->Value));
+                return NumberValue::Of(std::exp(v->Value));
             });
         o->Set("exp", fn);
     }
@@ -277,9 +277,9 @@ class MathModule {
     static void InitExpm1(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::expm1(v->Value));
+                return NumberValue::Of(std::expm1(v->Value));
             });
         o->Set("expm1", fn);
     }
@@ -287,9 +287,9 @@ class MathModule {
     static void InitTrunc(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
-                if (args.empty() || args[0]->type != ValueType::NUMBER) return std::make_shared<NullValue>();
+                if (args.empty() || args[0]->type != ValueType::NUMBER) return NullValue::Instance();
                 auto v = std::static_pointer_cast<NumberValue>(args[0]);
-                return std::make_shared<NumberValue>(std::trunc(v->Value));
+                return NumberValue::Of(std::trunc(v->Value));
             });
         o->Set("trunc", fn);
     }
@@ -298,7 +298,7 @@ class MathModule {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
                 if (args.empty()) {
-                    return std::make_shared<NullValue>();
+                    return NullValue::Instance();
                 }
                 double maxValue = -std::numeric_limits<double>::infinity();;
                 for (auto &v: args) {
@@ -309,7 +309,7 @@ class MathModule {
                         }
                     }
                 }
-                return std::make_shared<NumberValue>(maxValue);
+                return NumberValue::Of(maxValue);
             });
         o->Set("max", fn);
     }
@@ -318,7 +318,7 @@ class MathModule {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args)-> ValuePtr {
                 if (args.empty()) {
-                    return std::make_shared<NullValue>();
+                    return NullValue::Instance();
                 }
                 double minValue = std::numeric_limits<double>::infinity();
                 for (auto &v: args) {
@@ -329,7 +329,7 @@ class MathModule {
                         }
                     }
                 }
-                return std::make_shared<NumberValue>(minValue);
+                return NumberValue::Of(minValue);
             });
         o->Set("min", fn);
     }
@@ -343,47 +343,26 @@ class MathModule {
                     long max = static_cast<long>(std::static_pointer_cast<NumberValue>(args[1])->Value);
                     if (min > max) std::swap(min, max);
                     std::uniform_int_distribution<> dis(min, max);
-                    return std::make_shared<NumberValue>(dis(gen));
+                    return NumberValue::Of(dis(gen));
                 }
                 std::uniform_real_distribution<> dis(0.0, 1.0);
-                return std::make_shared<NumberValue>(dis(gen));
+                return NumberValue::Of(dis(gen));
             });
         o->Set("random", fn);
     }
 
 public:
-    static ValuePtr CreateNetModule() {
-        auto module = std::make_shared<ObjectValue>();
+    static ValuePtr CreateMathModule() {
+        static const std::vector<ObjectValue::LazyMember> members = {
+            {"round", InitRound}, {"log", InitLog}, {"log10", InitLog10}, {"log1p", InitLog1p}, {"log2", InitLog2},
+            {"pow", InitPow}, {"sqrt", InitSqrt}, {"abs", InitAbs}, {"ceil", InitCeil}, {"floor", InitFloor},
+            {"cbrt", InitCbrt}, {"sin", InitSin}, {"sinh", InitSinh}, {"asin", InitASin}, {"asinh", InitASinh},
+            {"cos", InitCos}, {"cosh", InitCosh}, {"acos", InitACos}, {"acosh", InitACosh}, {"tan", InitTan},
+            {"tanh", InitTanh}, {"atan", InitATan}, {"atanh", InitATanh}, {"exp", InitExp}, {"expm1", InitExpm1},
+            {"trunc", InitTrunc}, {"max", InitMax}, {"min", InitMin}, {"random", InitRandom},
+        };
+        auto module = ObjectValue::Lazy(members);
         InitPI(module);
-        InitRound(module);
-        InitLog(module);
-        InitLog10(module);
-        InitLog1p(module);
-        InitLog2(module);
-        InitPow(module);
-        InitSqrt(module);
-        InitAbs(module);
-        InitCeil(module);
-        InitFloor(module);
-        InitCbrt(module);
-        InitSin(module);
-        InitSinh(module);
-        InitASin(module);
-        InitASinh(module);
-        InitCos(module);
-        InitCosh(module);
-        InitACos(module);
-        InitACosh(module);
-        InitTan(module);
-        InitTanh(module);
-        InitATan(module);
-        InitATanh(module);
-        InitExp(module);
-        InitExpm1(module);
-        InitTrunc(module);
-        InitMax(module);
-        InitMin(module);
-        InitRandom(module);
         return module;
     }
 };
@@ -85,7 +85,7 @@ class NetModule {
         if (!hInt) {
             result->Set(
                 "error", std::make_shared<StringValue>("网络打开错误: " + std::to_string(GetLastError())));
-            result->Set("status", std::make_shared<NumberValue>(-1));
+            result->Set("status", NumberValue::Of(-1));
             return std::move(result);
         }
         const INTERNET_PORT port = isHttps ? INTERNET_DEFAULT_HTTPS_PORT : INTERNET_DEFAULT_HTTP_PORT;
@@ -93,7 +93,7 @@ class NetModule {
         if (!hc) {
             InternetCloseHandle(hInt);
             result->Set("error", std::make_shared<StringValue>("网络连接错误: " + std::to_string(GetLastError())));
-            result->Set("status", std::make_shared<NumberValue>(-1));
+            result->Set("status", NumberValue::Of(-1));
             return std::move(result);
         }
         DWORD dwFlags = INTERNET_FLAG_RELOAD | INTERNET_FLAG_NO_CACHE_WRITE;
@@ -106,7 +106,7 @@ class NetModule {
             InternetCloseHandle(hc);
             InternetCloseHandle(hInt);
             result->Set("error", std::make_shared<StringValue>("网络请求错误: " + std::to_string(GetLastError())));
-            result->Set("status", std::make_shared<NumberValue>(-1));
+            result->Set("status", NumberValue::Of(-1));
         }
         std::string headerStr{};
         if (!headers.empty()) {
@@ -121,13 +121,13 @@ class NetModule {
         );
         if (!bs) {
             result->Set("error", std::make_shared<StringValue>("网络请求错误: " + std::to_string(GetLastError())));
-            result->Set("status", std::make_shared<NumberValue>(-1));
+            result->Set("status", NumberValue::Of(-1));
             return std::move(result);
         }
         DWORD statusCode = 0;
         DWORD length = sizeof(DWORD);
         HttpQueryInfoA(hr, HTTP_QUERY_STATUS_CODE | HTTP_QUERY_FLAG_NUMBER, &statusCode, &length, nullptr);
-        result->Set("status", std::make_shared<NumberValue>(statusCode));
+        result->Set("status", NumberValue::Of(statusCode));
         // 返回类型
         char contentTypeBuf[256];
         DWORD ctLen = sizeof(contentTypeBuf);
@@ -162,7 +162,7 @@ class NetModule {
         InternetCloseHandle(hc);
         InternetCloseHandle(hInt);
         result->Set("type", std::make_shared<StringValue>(contentType));
-        result->Set("error", std::make_shared<NullValue>());
+        result->Set("error", NullValue::Instance());
         return std::move(result);
 #else
         // 其他平台稍后更新
@@ -202,7 +202,7 @@ class NetModule {
     static std::pair<std::string, std::string> BuildMultipartBody(const std::shared_ptr<ObjectValue> &obj) {
         std::string boundary = GenerateBoundary();
         std::string body;
-        for (const auto &[key, val]: obj->Properties) {
+        obj->ForEach([&](const std::string &key, const ValuePtr &val) {
             body += "--" + boundary + "\r\n";
             if (val->type == ValueType::BUFFER) {
                 body += "Content-Disposition: form-data; name=\"" + key + "\"; filename=\"" + key + "\"\r\n";
@@ -214,7 +214,7 @@ class NetModule {
                 body += val->ToString();
             }
             body += "\r\n";
-        }
+        });
         body += "--" + boundary + "--\r\n";
         return {body, boundary};
     }
@@ -242,7 +242,7 @@ class NetModule {
                 bool userProvidedContentType = false;
                 if (args.size() > headerIdx && args[headerIdx]->type == ValueType::OBJECT) {
                     auto const oHeaders = std::static_pointer_cast<ObjectValue>(args[headerIdx]);
-                    for (const auto &[key, val]: oHeaders->Properties) {
+                    oHeaders->ForEach([&](const std::string &key, const ValuePtr &val) {
                         std::string v = val->ToString();
                         headers.emplace_back(key, v);
                         auto tk = StringKit::ToUpperCase(key);
@@ -250,7 +250,7 @@ class NetModule {
                             contentType = v;
                             userProvidedContentType = true;
                         }
-                    }
+                    });
                     callbackIdx++;
                 }
                 if (hasBody && args.size() > dataIdx) {
@@ -266,11 +266,11 @@ class NetModule {
                             postData = JsonKit::ValueToJson(bodyVal).dump();
                         } else if (contentType.find("application/x-www-form-urlencoded") != std::string::npos) {
                             bool first = true;
-                            for (auto &[k, v]: obj->Properties) {
+                            obj->ForEach([&](const std::string &k, const ValuePtr &v) {
                                 if (!first) postData += "&";
                                 postData += UrlEncode(k) + "=" + UrlEncode(v->ToString());
                                 first = false;
-                            }
+                            });
                         } else if (contentType.find("multipart/form-data") != std::string::npos) {
                             auto [body, boundary] = BuildMultipartBody(obj);
                             postData = body;
@@ -289,15 +289,19 @@ class NetModule {
                     callback = args[callbackIdx];
                 }
                 EventLoop::AddActiveTask();
-                std::thread t([parts, headers, postData, callback, method]() {
+                std::thread t([parts, headers, postData, callback, method]() mutable {
+                    // 持有的值要在退出回收保护前释放, 避免与回收同时析构
+                    Collector::Mutator mutator;
                     auto result = SendHttpRequest(parts.host, parts.path, method, postData, parts.scheme == "https", headers);
                     if (callback != nullptr) {
-                        EventLoop::Enqueue(callback, {std::move(result)});
+                        EventLoop::Enqueue(std::move(callback), {std::move(result)});
                     }
+                    callback = nullptr;
+                    result = nullptr;
                     EventLoop::RemoveActiveTask();
                 });
                 t.detach();
-                return std::make_shared<NullValue>();
+                return NullValue::Instance();
             }
         );
         o->Set(jsName, fn);
@@ -305,13 +309,14 @@ class NetModule {
 
 public:
     static ValuePtr CreateNetModule() {
-        auto module = std::make_shared<ObjectValue>();
-        RegisterRequest(module, "get", "GET", false);
-        RegisterRequest(module, "delete", "DELETE", false);
-        RegisterRequest(module, "post", "POST", true);
-        RegisterRequest(module, "put", "PUT", true);
-        RegisterRequest(module, "patch", "PATCH", true);
-        return module;
+        static const std::vector<ObjectValue::LazyMember> members = {
+            {"get", [](std::shared_ptr<ObjectValue> &o) { RegisterRequest(o, "get", "GET", false); }},
+            {"delete", [](std::shared_ptr<ObjectValue> &o) { RegisterRequest(o, "delete", "DELETE", false); }},
+            {"post", [](std::shared_ptr<ObjectValue> &o) { RegisterRequest(o, "post", "POST", true); }},
+            {"put", [](std::shared_ptr<ObjectValue> &o) { RegisterRequest(o, "put", "PUT", true); }},
+            {"patch", [](std::shared_ptr<ObjectValue> &o) { RegisterRequest(o, "patch", "PATCH", true); }},
+        };
+        return ObjectValue::Lazy(members);
     }
 };
 
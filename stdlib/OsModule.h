@@ -44,9 +44,9 @@ class OsModule {
     static void InitGetEnv(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args) -> ValuePtr {
-                if (args.empty()) return std::make_shared<NullValue>();
+                if (args.empty()) return NullValue::Instance();
                 const char *val = std::getenv(args[0]->ToString().c_str());
-                if (val == nullptr) return std::make_shared<NullValue>();
+                if (val == nullptr) return NullValue::Instance();
                 return std::make_shared<StringValue>(val);
             }
         );
@@ -55,9 +55,10 @@ class OsModule {
 
 public:
     static ValuePtr CreateOSModule() {
-        auto os = std::make_shared<ObjectValue>();
-        InitExec(os);
-        InitGetEnv(os);
+        static const std::vector<ObjectValue::LazyMember> members = {
+            {"exec", InitExec}, {"getEnv", InitGetEnv},
+        };
+        auto os = ObjectValue::Lazy(members);
 #ifdef _WIN32
         os->Set("platform", std::make_shared<StringValue>("windows"));
 #else
@@ -23,16 +23,16 @@ class RegexModule {
     static void InitMatch(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args) -> ValuePtr {
-                if (args.size() < 2) return std::make_shared<BoolValue>(false);
+                if (args.size() < 2) return BoolValue::Of(false);
                 const std::string text = args[0]->ToString();
                 const std::string pattern = args[1]->ToString();
                 try {
                     const std::regex re(pattern);
-                    return std::make_shared<BoolValue>(std::regex_search(text, re));
+                    return BoolValue::Of(std::regex_search(text, re));
                 } catch (const std::regex_error &e) {
                     Logger::Error("正则表达式错误: " + std::string(e.what()));
                 }
-                return std::make_shared<BoolValue>(false);
+                return BoolValue::Of(false);
             }
         );
         o->Set("match", fn);
@@ -42,7 +42,7 @@ class RegexModule {
         auto const fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args) -> ValuePtr {
                 // 格式Regex.replace(source, pattern, target)
-                if (args.size() < 3) return std::make_shared<BoolValue>(false);
+                if (args.size() < 3) return BoolValue::Of(false);
                 const auto source = args[0]->ToString();
                 const auto pattern = args[1]->ToString();
                 const auto target = args[2]->ToString();
@@ -60,10 +60,10 @@ class RegexModule {
 
 public:
     static ValuePtr CreateRegexModule() {
-        auto module = std::make_shared<ObjectValue>();
-        InitMatch(module);
-        InitReplace(module);
-        return module;
+        static const std::vector<ObjectValue::LazyMember> members = {
+            {"match", InitMatch}, {"replace", InitReplace},
+        };
+        return ObjectValue::Lazy(members);
     }
 };
 
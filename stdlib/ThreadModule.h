@@ -27,14 +27,14 @@ using namespace std::chrono;
 inline ValuePtr onMessageCallback = nullptr;
 
 class ThreadModule {
-    static void initSleep(const std::shared_ptr<ObjectValue> &o) {
+    static void initSleep(std::shared_ptr<ObjectValue> &o) {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args) -> ValuePtr {
                 if (!args.empty() && args[0]->type == ValueType::NUMBER) {
                     const long ms = static_cast<long>(std::static_pointer_cast<NumberValue>(args[0])->Value);
                     std::this_thread::sleep_for(milliseconds(ms));
                 }
-                return std::make_shared<NullValue>();
+                return NullValue::Instance();
             }
         );
         o->Set("sleep", fn);
@@ -49,8 +49,12 @@ class ThreadModule {
                 auto threadFn = args[0];
                 auto threadArgs = std::vector(args.begin() + 1, args.end());
                 EventLoop::AddActiveTask();
-                std::thread t([threadFn,threadArgs] {
+                std::thread t([threadFn,threadArgs]() mutable {
+                    // 持有的值要在退出回收保护前释放, 避免与回收同时析构
+                    Collector::Mutator mutator;
                     Interpreter::CallFunction(threadFn, threadArgs);
+                    threadFn = nullptr;
+                    threadArgs.clear();
                     EventLoop::RemoveActiveTask();
                 });
                 t.detach();
@@ -67,7 +71,7 @@ class ThreadModule {
                 if (!args.empty() && args[0]->type == ValueType::FUNCTION) {
                     onMessageCallback = args[0];
                 }
-                return std::make_shared<NullValue>();
+                return NullValue::Instance();
             });
         o->Set("onMessage", fn);
     }
@@ -76,22 +80,21 @@ class ThreadModule {
         const auto fn = std::make_shared<NativeFunctionValue>(
             [](const std::vector<ValuePtr> &args) -> ValuePtr {
                 if (args.empty()) {
-                    return std::make_shared<NullValue>();
+                    return NullValue::Instance();
                 }
                 EventLoop::Enqueue(onMessageCallback, args);
-                return std::make_shared<NullValue>();
+                return NullValue::Instance();
             });
         o->Set("postMessage", fn);
     }
 
 public:
     static ValuePtr CreateThreadModule() {
-        auto threadObj = std::make_shared<ObjectValue>();
-        initSleep(threadObj);
-        initInvoke(threadObj);
-        initOnMessage(threadObj);
-        initPostMessage(threadObj);
-        return threadObj;
+        static const std::vector<ObjectValue::LazyMember> members = {
+            {"sleep", initSleep}, {"invoke", initInvoke},
+            {"onMessage", initOnMessage}, {"postMessage", initPostMessage},
+        };
+        return ObjectValue::Lazy(members);
     }
 };
 
@@ -6,6 +6,7 @@
 #include <thread>
 
 #include "../parser/Parser.h"
+#include "../parser/ProgramCache.h"
 #include "../evaluator/Interpreter.h"
 #include "../evaluator/Value.h"
 #include "../evaluator/Environment.h"
@@ -46,7 +47,6 @@ protected:
         globalEnv = std::make_shared<Environment>();
         Interpreter::ModuleCache.clear();
         Interpreter::ModuleAST.clear();
-        Interpreter::ASTRegistry.clear();
     }
 
     ValuePtr Eval(const std::string &code) {
@@ -105,6 +105,57 @@ TEST_F(InterpreterTest, StringConcatenation) {
     ASSERT_IS_STRING(Eval("\"Number: \" + 1;"), "Number: 1"); // 测试隐式转换
 }
 
+TEST_F(InterpreterTest, UnboxedIntermediates) {
+    // 中间结果不装箱, 逻辑运算仍返回操作数本身
+    ASSERT_IS_NUMBER(Eval("-(2 + 3) * 2 % 7;"), -3.0);
+    ASSERT_IS_BOOL(Eval("!(1 < 2) || 3 >= 3;"), true);
+    ASSERT_IS_NUMBER(Eval("0 || 1 + 1;"), 2.0);
+    ASSERT_IS_STRING(Eval("1 < 2 && \"ok\";"), "ok");
+    ASSERT_IS_STRING(Eval("(1 + 2) + \"x\";"), "3x");
+    EXPECT_THROW(Eval("1 / (2 - 2);"), std::runtime_error);
+}
+
+TEST_F(InterpreterTest, UnboxedLocals) {
+    // 局部变量槽位直接存放数字与布尔, 读写、自增与复合赋值都不装箱
+    auto sum = Eval(R"(
+           function f(n) {
+               let s = 0.5;
+               let ok = false;
+               for (let i = 0; i < n; i++) { s += i; ok = !ok; }
+               let j = 10;
+               --j;
+               let r = j++;
+               if (ok) { s = s + 100; }
+               return s + r + j;
+           }
+           f(5);
+    )");
+    ASSERT_IS_NUMBER(sum, 10.5 + 9 + 10 + 100);
+    auto captured = Eval("function g() { let c = 1; let inc = function() { c = c + 1; return c; }; inc(); return inc() * c; } g();");
+    ASSERT_IS_NUMBER(captured, 9.0);
+
+    const std::vector<Atom> layout{Atom::Intern("n"), Atom::Intern("b")};
+    const auto scope = std::make_shared<Environment>(nullptr, &layout);
+    scope->DeclareSlot(0, TaggedValue::FromNumber(3));
+    scope->DeclareSlot(1, TaggedValue::FromBool(true));
+    EXPECT_EQ(scope->slots[0].Boxed(), nullptr);
+    EXPECT_EQ(scope->slots[1].Boxed(), nullptr);
+    scope->AssignSlot(0, 0, layout[0], TaggedValue::FromNumber(4));
+    EXPECT_EQ(scope->LookupSlotTagged(0, 0, layout[0]).AsNumber(), 4.0);
+    ASSERT_IS_BOOL(scope->LookupSlot(0, 1, layout[1]), true);
+    EXPECT_THROW(scope->DeclareSlot(0, TaggedValue::FromNumber(5)), std::runtime_error);
+}
+
+TEST_F(InterpreterTest, SharedImmutableValues) {
+    // null / true / false 与小整数共享同一实例
+    EXPECT_EQ(NullValue::Instance(), Eval("null;"));
+    EXPECT_EQ(BoolValue::Of(true), Eval("1 < 2;"));
+    EXPECT_EQ(NumberValue::Of(42), Eval("40 + 2;"));
+    EXPECT_NE(NumberValue::Of(1.5), NumberValue::Of(1.5));
+    EXPECT_NE(NumberValue::Of(2048), NumberValue::Of(2048));
+    ASSERT_IS_STRING(Eval("\"\" + (0 * -1);"), "-0");
+}
+
 // ==========================================
 // 变量与赋值
 // ==========================================
@@ -199,6 +250,30 @@ TEST_F(InterpreterTest, ContinueStatement) {
     ASSERT_IS_NUMBER(Eval(code), 8.0);
 }
 
+TEST_F(InterpreterTest, NestedBlockControlFlow) {
+    // return / break 穿过多层代码块
+    std::string code = R"(
+        function pick(n) {
+            if (n > 0) {
+                {
+                    return n * 2;
+                }
+            }
+            return -1;
+        }
+        let sum = 0;
+        for (let i = 0; i < 10; i++) {
+            {
+                if (i == 4) { break; }
+            }
+            sum = sum + pick(i);
+        }
+        sum;
+    )";
+    // -1 + 2 + 4 + 6 = 11
+    ASSERT_IS_NUMBER(Eval(code), 11.0);
+}
+
 // ==========================================
 // 对象与数组
 // ==========================================
@@ -292,6 +367,48 @@ TEST_F(InterpreterTest, Closure) {
     ASSERT_IS_NUMBER(Eval(code), 15.0);
 }
 
+TEST_F(InterpreterTest, ClosureScopeResolution) {
+    // 闭包可以看到之后才声明的变量, 声明之前则继续向外层查找
+    std::string code = R"(
+        let z = 1;
+        function test() {
+            let f = function() { return z; };
+            let before = f();
+            let z = 10;
+            {
+                let z = 100;
+            }
+            return before + f();
+        }
+        test();
+    )";
+    ASSERT_IS_NUMBER(Eval(code), 11.0);
+}
+
+TEST_F(InterpreterTest, LoopBodyEnvironment) {
+    // 被闭包捕获的循环体每轮独立, 未被捕获的循环体复用环境但每轮重新声明
+    std::string code = R"(
+        function test() {
+            let fs = [];
+            for (let i = 0; i < 3; i++) {
+                let k = i * 10;
+                fs.push(function() { return k; });
+            }
+            let r = 0;
+            for (let i = 0; i < 2; i++) {
+                r = r + z;
+                let z = 100;
+                r = r + z;
+            }
+            return fs[0]() + fs[1]() + fs[2]() + r;
+        }
+        let z = 1;
+        test();
+    )";
+    // 0 + 10 + 20 + (1 + 100) * 2 = 232
+    ASSERT_IS_NUMBER(Eval(code), 232.0);
+}
+
 TEST_F(InterpreterTest, TryCatch) {
     std::string code = R"(
         let res = 0;
@@ -306,6 +423,104 @@ TEST_F(InterpreterTest, TryCatch) {
     ASSERT_IS_NUMBER(Eval(code), 100);
 }
 
+// ==========================================
+// 字节码虚拟机
+// ==========================================
+
+class BytecodeTest : public InterpreterTest {
+protected:
+    void SetUp() override {
+        Interpreter::UseBytecode = true;
+    }
+
+    void TearDown() override {
+        Interpreter::UseBytecode = false;
+    }
+};
+
+TEST_F(BytecodeTest, LoopAndControlFlow) {
+    std::string code = R"(
+        let sum = 0;
+        for (let i = 0; i < 100; i++) {
+            if (i % 3 == 0) { continue; }
+            if (i > 50) { break; }
+            sum += i;
+        }
+        let n = 0;
+        while (n < 10) { n++; }
+        sum + n;
+    )";
+    ASSERT_IS_NUMBER(Eval(code), 877.0);
+}
+
+TEST_F(BytecodeTest, FunctionAndClosure) {
+    std::string code = R"(
+        function fib(n) {
+            if (n <= 1) { return n; }
+            return fib(n - 1) + fib(n - 2);
+        }
+        function counter() {
+            let c = 0;
+            return function() { c++; return c; };
+        }
+        let next = counter();
+        next();
+        next();
+        fib(10) + next();
+    )";
+    ASSERT_IS_NUMBER(Eval(code), 58.0);
+}
+
+TEST_F(BytecodeTest, ObjectArrayAndTry) {
+    std::string code = R"(
+        let o = {a: 1, list: [1, 2, 3]};
+        o.a += 5;
+        o.list[1]++;
+        let res = 0;
+        try {
+            throw {code: 42};
+        } catch (e) {
+            res = e.code;
+        }
+        o.a + o.list[1] + res;
+    )";
+    ASSERT_IS_NUMBER(Eval(code), 51.0);
+}
+
+TEST_F(BytecodeTest, StringAppendInPlace) {
+    // 寄存器不额外持有变量的字符串, 循环拼接原地追加; 共享或求值中被重新赋值的字符串仍然复制
+    auto res = Eval(R"(
+        function build(n) {
+            let s = "";
+            for (let i = 0; i < n; i++) { s = s + "x"; }
+            return s;
+        }
+        let g = "中";
+        for (let i = 0; i < 3; i++) { g += i; }
+        let t = g;
+        t += "|";
+        let h = "a";
+        let keep = "";
+        function rebind() { keep = h; h = "z"; return "b"; }
+        h = h + rebind();
+        build(1000).length + "," + g + "," + t + "," + h + keep;
+    )");
+    ASSERT_IS_STRING(res, "1000,中012,中012|,aba");
+    // 原地追加按倍数扩容, 每次都新建字符串时容量与长度相同
+    auto built = Eval(R"(
+        function build(n) {
+            let s = "";
+            for (let i = 0; i < n; i++) { s = s + "x"; }
+            return s;
+        }
+        build(1000);
+    )");
+    ASSERT_EQ(built->type, ValueType::STRING);
+    const std::string &text = static_cast<StringValue *>(built.get())->Value;
+    EXPECT_EQ(text.size(), 1000u);
+    EXPECT_GT(text.capacity(), text.size());
+}
+
 TEST_F(InterpreterTest, ToFixed) {
     std::string code = R"(
         let a = 3.141592653589793;
@@ -379,6 +594,109 @@ TEST_F(InterpreterTest, ImportSystemO) {
     fs::remove_all("lib");
 }
 
+// 导入图: 菱形依赖只执行一次, 循环导入报错
+TEST_F(InterpreterTest, ImportGraph) {
+    fs::create_directories("graph_sandbox");
+    std::ofstream("graph_sandbox/base.bx") << "let count = 0; function next() { count++; return count; }";
+    std::ofstream("graph_sandbox/left.bx") << "import graph_sandbox.base as b; let value = b.next();";
+    std::ofstream("graph_sandbox/right.bx") << "import graph_sandbox.base as b; let value = b.next();";
+    for (int i = 0; i < 20; i++) {
+        std::ofstream("graph_sandbox/leaf" + std::to_string(i) + ".bx") << "let id = " << i << ";";
+    }
+    std::string code = R"(
+        import graph_sandbox.left as l;
+        import graph_sandbox.right as r;
+    )";
+    for (int i = 0; i < 20; i++) {
+        code += "import graph_sandbox.leaf" + std::to_string(i) + " as leaf" + std::to_string(i) + ";\n";
+    }
+    code += "l.value * 100 + r.value * 10 + leaf19.id;";
+    ASSERT_IS_NUMBER(Eval(code), 139.0);
+
+    std::ofstream("graph_sandbox/a.bx") << "import graph_sandbox.b as b; let x = 1;";
+    std::ofstream("graph_sandbox/b.bx") << "import graph_sandbox.a as a; let y = 2;";
+    EXPECT_THROW(Eval("import graph_sandbox.a as a; a.x;"), std::runtime_error);
+    fs::remove_all("graph_sandbox");
+}
+
+// 预编译缓存: 第二次导入读取 .bxc, 源码修改后缓存失效
+TEST_F(InterpreterTest, ProgramCache) {
+    fs::create_directories("bxc_sandbox");
+    std::ofstream("bxc_sandbox/util.bx") << R"(
+        function sum(list) {
+            let total = 0;
+            for (let i = 0; i < list.length; i++) { total += list[i]; }
+            return total;
+        }
+        let obj = { name: "bx", tags: [1, 2, 3] };
+        function describe() {
+            let s = "";
+            for (let i = 0; i < obj.tags.length; i++) {
+                if (i % 2 == 0) { s = s + "e"; } else { s = s + "o"; }
+            }
+            try { throw -sum(obj.tags); } catch (e) { s = s + e; }
+            return obj.name + ":" + s;
+        }
+    )";
+    const std::string code = R"(
+        import bxc_sandbox.util as u;
+        u.describe();
+    )";
+    auto res = Eval(code);
+    ASSERT_IS_STRING(res, "bx:eoe-6");
+    ASSERT_TRUE(fs::exists("bxc_sandbox/util.bxc"));
+    res = Eval(code);
+    ASSERT_IS_STRING(res, "bx:eoe-6");
+
+    std::ofstream("bxc_sandbox/util.bx") << R"(function describe() { return "changed"; })";
+    res = Eval(code);
+    ASSERT_IS_STRING(res, "changed");
+    fs::remove_all("bxc_sandbox");
+}
+
+// 损坏的缓存: 内容校验不通过或嵌套过深时重新解析, 并写回正确的缓存
+TEST_F(InterpreterTest, ProgramCacheCorrupt) {
+    auto readAll = [](const std::string &path) {
+        std::ifstream in(path, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), {});
+    };
+    fs::create_directories("bxc_corrupt");
+    std::ofstream("bxc_corrupt/m.bx") << "function f() { return -(1 + 2) * 3; }";
+    const std::string code = "import bxc_corrupt.m as m; m.f();";
+    auto res = Eval(code);
+    ASSERT_IS_NUMBER(res, -9.0);
+    const std::string good = readAll("bxc_corrupt/m.bxc");
+    ASSERT_FALSE(good.empty());
+    // 改写语法树中的一个字节, 文件长度与源码都不变
+    std::string bad = good;
+    bad[bad.size() - 3] ^= 0x5A;
+    std::ofstream("bxc_corrupt/m.bxc", std::ios::binary | std::ios::trunc) << bad;
+    res = Eval(code);
+    ASSERT_IS_NUMBER(res, -9.0);
+    EXPECT_EQ(readAll("bxc_corrupt/m.bxc"), good);
+    fs::remove_all("bxc_corrupt");
+
+    // 哈希正确但嵌套极深的内容按损坏处理, 不会递归到栈溢出
+    const std::string source = "x;";
+    std::string tree;
+    auto put32 = [&tree](const uint32_t v) { tree.append(reinterpret_cast<const char *>(&v), sizeof(v)); };
+    put32(1);
+    tree.push_back(static_cast<char>(NodeKind::EXPRESSION_STATEMENT));
+    for (int i = 0; i < 1000000; ++i) {
+        tree.push_back(static_cast<char>(NodeKind::UNARY));
+        put32(1);
+        tree.push_back('-');
+    }
+    Parser parser(source);
+    // 魔数、版本、源码哈希与长度之后是语法树的哈希
+    std::string data = ProgramCache::Serialize(parser.ParseProgram(), source).substr(0, 24);
+    const uint64_t treeHash = ProgramCache::Hash(tree);
+    data.append(reinterpret_cast<const char *>(&treeHash), sizeof(treeHash));
+    data += tree;
+    Program program;
+    EXPECT_FALSE(ProgramCache::Deserialize(data, source, program));
+}
+
 TEST_F(InterpreterTest, CompoundAssignment) {
     ASSERT_IS_NUMBER(Eval("let a = 1; a += 2; a;"), 3.0);
     ASSERT_IS_NUMBER(Eval("let a = 5; a -= 2; a;"), 3.0);
@@ -409,6 +727,201 @@ TEST_F(InterpreterTest, ProtoTest) {
     ASSERT_IS_STRING(res, "abc");
 }
 
+TEST_F(InterpreterTest, PrototypeMethodThis) {
+    // 方法调用直接传入 this; 未绑定的闭包取外层方法的 this; 作为值取出的方法仍然绑定
+    auto res = Eval(R"(
+           String.prototype.shout = function(times) {
+               let out = this;
+               for (let i = 0; i < times; i++) {
+                   out = out + "x";
+               }
+               return out;
+           };
+           Array.prototype.total = function() {
+               let sum = 0;
+               for (let i = 0; i < this.length; i++) {
+                   sum += this[i];
+               }
+               return sum;
+           };
+           Array.prototype.firstVia = function() {
+               let get = function() { return this[0]; };
+               return get();
+           };
+           let bound = [7, 8].firstVia;
+           "hi".shout(2) + [1, 2, 3].total() + [5].firstVia() + bound();
+    )");
+    ASSERT_IS_STRING(res, "hixx657");
+}
+
+TEST_F(InterpreterTest, StringCodePointAccess) {
+    // ASCII 字符串按字节访问, 非 ASCII 字符串按码点访问
+    auto res = Eval(R"(
+           let a = "abc" + "def";
+           let b = "中文ab";
+           a.length + "," + a[4] + a.substr(1, 3) + "," + b.length + "," + b[1] + b.substr(2, 4) + "," + b.charCodeAt(0);
+    )");
+    ASSERT_IS_STRING(res, "6,ebc,4,文ab,20013");
+    EXPECT_TRUE(std::make_shared<StringValue>("abc")->IsAscii());
+    EXPECT_FALSE(std::make_shared<StringValue>("中")->IsAscii());
+    EXPECT_EQ(std::make_shared<StringValue>("中文")->Length(), 2u);
+}
+
+TEST_F(InterpreterTest, StringAppendAndBuilder) {
+    // 原地追加不能影响共享同一字符串的其他变量
+    auto res = Eval(R"(
+           let s = "中";
+           for (let i = 0; i < 3; i++) {
+               s += i;
+               s = s + "|";
+           }
+           let t = s;
+           t += "x";
+           let b = String.builder();
+           b.append("a").append(1, "é");
+           s + "," + t + "," + s.length + s[2] + "," + b.length() + b.toString();
+    )");
+    ASSERT_IS_STRING(res, "中0|1|2|,中0|1|2|x,7|,3a1é");
+    // 求右侧时变量被重新赋值, 旧字符串被其他变量持有, 不能原地追加
+    auto rebound = Eval(R"(
+           let h = "a";
+           let keep = "";
+           function rebind() { keep = h; h = "z"; return "b"; }
+           h = h + rebind();
+           h + keep;
+    )");
+    ASSERT_IS_STRING(rebound, "aba");
+}
+
+TEST_F(InterpreterTest, PackedNumberArray) {
+    // 全是数字的数组紧凑存放, 写入其他类型后转为通用存储
+    auto res = Eval(R"(
+           let a = [3, 1, 2];
+           a.push(4);
+           let b = a.slice(1, 3);
+           a[1] += 9;
+           let c = a.concat([7], 8);
+           let r = c.join("|") + "," + b + "," + a.indexOf(4) + a.pop() + ",";
+           a.push("x");
+           a[5] = 1;
+           r + a.join("|") + "," + a.lastIndexOf(10);
+    )");
+    ASSERT_IS_STRING(res, "3|10|2|4|7|8,[1, 2],34,3|10|2|x|null|1,1");
+    auto packed = Eval("let p = [1.5, 2]; p.push(3); p;");
+    ASSERT_EQ(packed->type, ValueType::ARRAY);
+    EXPECT_TRUE(std::static_pointer_cast<ArrayValue>(packed)->IsPacked());
+    auto mixed = Eval("let m = [1, 2]; m.push(null); m;");
+    ASSERT_EQ(mixed->type, ValueType::ARRAY);
+    EXPECT_FALSE(std::static_pointer_cast<ArrayValue>(mixed)->IsPacked());
+    // 仍是紧凑存储时越过末尾写入, 中间补 null
+    auto gap = Eval("let g = [1, 2, 3]; g[5] = 9; let e = []; e[1] = 9; g.join(\"|\") + \",\" + e.join(\"|\");");
+    ASSERT_IS_STRING(gap, "1|2|3|null|null|9,null|9");
+}
+
+TEST_F(InterpreterTest, CycleCollector) {
+    // 互相引用的对象与闭包在外部不可达后由 GC.collect 释放, 仍可达的环保留
+    auto res = Eval(R"(
+           import std.GC as gc;
+           function make() {
+               let o = {};
+               o.self = o;
+               let f = function() { return o; };
+               o.f = f;
+               return 1;
+           }
+           for (let i = 0; i < 100; i++) {
+               make();
+           }
+           let keep = {};
+           keep.me = keep;
+           keep.v = 7;
+           let freed = gc.collect();
+           (freed >= 300) + "," + keep.me.v + "," + (gc.stats().collections >= 1);
+    )");
+    ASSERT_IS_STRING(res, "true,7,true");
+}
+
+TEST_F(InterpreterTest, LazyStdModule) {
+    // 标准库成员在首次访问时创建, 枚举时补齐全部成员
+    auto res = Eval(R"(
+           import std.Math as M;
+           import std.Crypt as C;
+           let before = Object.keys(C).length;
+           M.floor(2.7) + M.max(1, 5) + "," + M.PI + "," + C.md5("") + "," + before + "," + Object.keys(M).length;
+    )");
+    ASSERT_IS_STRING(res, "7,3.141593,d41d8cd98f00b204e9800998ecf8427e,6,30");
+}
+
+TEST_F(InterpreterTest, LazyModuleConcurrent) {
+    // 多个线程同时首次访问同一模块的成员, 每个成员只创建一次, 读到的都是完整的值
+    static const std::vector<ObjectValue::LazyMember> members = {
+        {"lazyA", [](std::shared_ptr<ObjectValue> &o) { o->Set("lazyA", NumberValue::Of(1)); }},
+        {"lazyB", [](std::shared_ptr<ObjectValue> &o) { o->Set("lazyB", NumberValue::Of(2)); }},
+        {"lazyC", [](std::shared_ptr<ObjectValue> &o) { o->Set("lazyC", NumberValue::Of(3)); }},
+        {"lazyD", [](std::shared_ptr<ObjectValue> &o) { o->Set("lazyD", NumberValue::Of(4)); }},
+        {"lazyE", [](std::shared_ptr<ObjectValue> &o) { o->Set("lazyE", NumberValue::Of(5)); }},
+        {"lazyF", [](std::shared_ptr<ObjectValue> &o) { o->Set("lazyF", NumberValue::Of(6)); }},
+        {"lazyG", [](std::shared_ptr<ObjectValue> &o) { o->Set("lazyG", NumberValue::Of(7)); }},
+        {"lazyH", [](std::shared_ptr<ObjectValue> &o) { o->Set("lazyH", NumberValue::Of(8)); }}
+    };
+    std::vector<Atom> keys;
+    for (const auto &member: members) {
+        keys.push_back(Atom::Intern(member.Name));
+    }
+    const auto module = ObjectValue::Lazy(members);
+    std::vector<double> sums(4, 0);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < sums.size(); ++t) {
+        workers.emplace_back([&, t] {
+            std::vector<PropertyCache> caches(keys.size());
+            for (int round = 0; round < 1000; ++round) {
+                for (size_t i = 0; i < keys.size(); ++i) {
+                    const size_t k = (i + t) % keys.size();
+                    sums[t] += std::static_pointer_cast<NumberValue>(module->GetCached(keys[k], caches[k]))->Value;
+                }
+            }
+        });
+    }
+    for (auto &worker: workers) {
+        worker.join();
+    }
+    for (const double sum: sums) {
+        EXPECT_EQ(sum, 36000);
+    }
+    EXPECT_EQ(module->Size(), members.size());
+}
+
+TEST_F(InterpreterTest, LazyMemberInitThrows) {
+    // 创建成员时抛出异常, 该成员仍是待创建, 下次访问重试
+    static int attempts = 0;
+    static const std::vector<ObjectValue::LazyMember> members = {
+        {"lazyFlaky", [](std::shared_ptr<ObjectValue> &o) {
+            if (++attempts == 1) {
+                throw std::runtime_error("init failed");
+            }
+            o->Set("lazyFlaky", NumberValue::Of(attempts));
+        }}
+    };
+    const auto module = ObjectValue::Lazy(members);
+    EXPECT_THROW(module->Get("lazyFlaky"), std::runtime_error);
+    const auto value = module->Get("lazyFlaky");
+    ASSERT_IS_NUMBER(value, 2.0);
+    EXPECT_EQ(module->Size(), 1u);
+}
+
+TEST_F(InterpreterTest, ClosureOutlivesProgram) {
+    // Run 结束后语法树随 Program 释放, 函数值持有所在的 Arena 继续可用
+    auto fn = Eval(R"(
+           let base = 40;
+           function add(x) {
+               return function(y) { return base + x + y; };
+           }
+           add(1);
+    )");
+    auto res = Interpreter::CallFunction(fn, {std::make_shared<NumberValue>(1)});
+    ASSERT_IS_NUMBER(res, 42);
+}
+
 TEST_F(InterpreterTest, StringFromCharCode) {
     auto res = Eval(R"(
            String.fromCharCode(65);
@@ -416,6 +929,15 @@ TEST_F(InterpreterTest, StringFromCharCode) {
     ASSERT_IS_STRING(res, "A");
 }
 
+// 内置对象来自启动快照, 一次运行中添加的属性不影响下一次
+TEST_F(InterpreterTest, BuiltinSnapshot) {
+    ASSERT_IS_NUMBER(Eval("String.tag = 5; Object.tag = 6; String.tag + Object.tag;"), 11);
+    auto res = Eval("String.tag;");
+    EXPECT_EQ(res->type, ValueType::NULL_TYPE);
+    res = Eval("String.fromCharCode(66) + Object.keys({a: 1}).length;");
+    ASSERT_IS_STRING(res, "B1");
+}
+
 TEST_F(InterpreterTest, StringPrototype) {
     auto res = Eval(R"(
            String.prototype.hello = function(){
@@ -625,6 +1147,128 @@ TEST_F(InterpreterTest, ObjectRemove) {
     ASSERT_IS_NUMBER(Eval(code), 0.0);
 }
 
+TEST_F(InterpreterTest, ObjectShapes) {
+    // 相同顺序创建的对象共享隐藏类, 属性按添加顺序排列; 删除或属性过多时转为字典
+    std::string code = R"(
+        let a = { x: 1, y: 2 };
+        let b = { x: 10, y: 20 };
+        b.z = 30;
+        let keys = Object.keys(b);
+        let order = keys[0] + keys[1] + keys[2];
+        Object.remove(a, "x");
+        a.w = 5;
+        let big = {};
+        for (let i = 0; i < 100; i++) {
+            big["k" + i] = i;
+        }
+        order + (a.y + a.w) + Object.keys(big).length + big.k99;
+    )";
+    auto res = Eval(code);
+    ASSERT_IS_STRING(res, "xyz710099");
+}
+
+TEST_F(InterpreterTest, JsonRecordsShareShape) {
+    // 字段名没有在源码中出现的 JSON 记录也共享 Shape; 记录全部释放后字段名移出 Atom 表
+    auto res = Eval(R"(
+        import std.JSON as JSON;
+        JSON.parse("[{\"recId\": 1, \"recName\": \"a\"}, {\"recId\": 2, \"recName\": \"b\"}]");
+    )");
+    ASSERT_EQ(res->type, ValueType::ARRAY);
+    auto list = std::static_pointer_cast<ArrayValue>(res);
+    const auto first = std::static_pointer_cast<ObjectValue>(list->At(0));
+    const auto second = std::static_pointer_cast<ObjectValue>(list->At(1));
+    ASSERT_NE(first->CurrentShape(), nullptr);
+    EXPECT_EQ(first->CurrentShape(), second->CurrentShape());
+    EXPECT_EQ(first->Get("recId")->ToString() + second->Get("recName")->ToString(), "1b");
+    Atom key;
+    EXPECT_TRUE(Atom::Find("recId", key));
+}
+
+TEST_F(InterpreterTest, RuntimeKeysReleased) {
+    {
+        auto res = Eval(R"(let m = {}; m["runtime" + "OnlyKey"] = 3; m;)");
+        ASSERT_EQ(res->type, ValueType::OBJECT);
+        RestTest();
+    }
+    // 空 Shape 只保留最近一次转换, 换成别的转换后原来的链随之释放
+    Shape::Empty()->Add(Atom::Intern("runtimeKeysReset"));
+    Atom missing;
+    EXPECT_FALSE(Atom::Find("runtimeOnlyKey", missing));
+}
+
+TEST_F(InterpreterTest, ShapeTransitionsReleased) {
+    // 没有对象再使用的 Shape 被释放, 只保留最近一次转换
+    const Atom a = Atom::Intern("shapeReleaseA");
+    const Atom b = Atom::Intern("shapeReleaseB");
+    std::weak_ptr<Shape> watch;
+    {
+        const auto shape = Shape::Empty()->Add(a);
+        watch = shape;
+        EXPECT_EQ(Shape::Empty()->Add(a), shape);
+    }
+    EXPECT_FALSE(watch.expired());
+    Shape::Empty()->Add(b);
+    EXPECT_TRUE(watch.expired());
+}
+
+TEST_F(InterpreterTest, PropertyCacheSlotRange) {
+    // 记录的槽位超出 Shape 范围时视为未命中, 编号重复也不会越界读写
+    const auto shape = Shape::Empty()->Add(Atom::Intern("cacheRangeA"));
+    PropertyCache cache;
+    cache.Record(shape->Id, 0);
+    EXPECT_EQ(cache.Lookup(shape->Id, shape->Size()), 0);
+    PropertyCache stale;
+    stale.Record(shape->Id, 5);
+    EXPECT_EQ(stale.Lookup(shape->Id, shape->Size()), PropertyCache::Miss);
+}
+
+TEST_F(InterpreterTest, PropertyInlineCache) {
+    // 同一访问点先后遇到多种 Shape; 原型属性被改写, 增删后缓存不能返回旧值
+    std::string code = R"(
+        function getX(o) { return o.x; }
+        function bump(o) { o.x += 1; }
+        let list = [{ x: 1 }, { y: 0, x: 2 }, { z: 0, y: 0, x: 3 }, { w: 0, z: 0, y: 0, x: 4 }, { v: 0, x: 5 }];
+        let sum = 0;
+        for (let r = 0; r < 3; r++) {
+            for (let i = 0; i < list.length; i++) {
+                bump(list[i]);
+                sum += getX(list[i]);
+            }
+        }
+        function greet(o) { return o.cacheGreet; }
+        let p = {};
+        Object.prototype.cacheGreet = "a";
+        let g1 = greet(p);
+        Object.prototype.cacheGreet = "b";
+        let g2 = greet(p);
+        Object.remove(Object.prototype, "cacheGreet");
+        let g3 = greet(p) == null;
+        p.cacheGreet = "own";
+        sum + g1 + g2 + g3 + greet(p);
+    )";
+    ASSERT_IS_STRING(Eval(code), "75abtrueown");
+}
+
+TEST_F(InterpreterTest, BuiltinMethodTable) {
+    // 内置方法直接调用或作为值取出; 同一调用点遇到不同类型的接收者
+    std::string code = R"(
+        let arr = [];
+        for (let i = 0; i < 1000; i++) {
+            arr.push(i);
+        }
+        let push = arr.push;
+        push(7);
+        function show(x) { return x.toString(); }
+        let s = "héllo";
+        let n = 3.14159;
+        let joined = [1, 2].join("|");
+        arr.length + "," + arr.pop() + "," + s.substr(1, 3) + "," + s.charCodeAt(1) + "," + n.toFixed(2) + ","
+            + joined + "," + show([1]) + show(5);
+    )";
+    auto res = Eval(code);
+    ASSERT_IS_STRING(res, "1001,7,él,233,3.14,1|2,[1]5");
+}
+
 TEST_F(InterpreterTest, ObjectKeysEmpty) {
     std::string code = R"(
         let obj = {};
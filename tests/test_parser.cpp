@@ -7,6 +7,7 @@
 #include "../parser/Parser.h"
 #include "../lexer/Lexer.h"
 #include "../parser/Expression.h"
+#include "../evaluator/Value.h"
 
 // ==========================================
 // 1. Lexer 单元测试
@@ -51,6 +52,31 @@ TEST(LexerTest, StringHandling) {
     EXPECT_EQ(strToken._TokenType.GetEnum(), TokenKind::STRING);
 }
 
+TEST(LexerTest, SlicesAndPositions) {
+    std::string code = "let s = \"a\\\"b\";\r\n// 注释\r\n  x += 1.5;";
+    Lexer lexer(code);
+
+    lexer.NextToken(); // let
+    lexer.NextToken(); // s
+    lexer.NextToken(); // =
+    Token str = lexer.NextToken();
+    EXPECT_EQ(str.TokenValue, "a\"b");
+    EXPECT_EQ(lexer.NextToken().TokenValue, ";");
+
+    Token x = lexer.NextToken();
+    EXPECT_EQ(x.TokenValue, "x");
+    int line = 0, column = 0;
+    lexer.Position(x.Offset, line, column);
+    EXPECT_EQ(line, 2);
+    EXPECT_EQ(column, 2);
+    EXPECT_EQ(lexer.NextToken().TokenValue, "+=");
+    Token num = lexer.NextToken();
+    EXPECT_EQ(num.TokenValue, "1.5");
+    EXPECT_EQ(num._TokenType.GetEnum(), TokenKind::FLOAT);
+    EXPECT_EQ(lexer.NextToken().TokenValue, ";");
+    EXPECT_EQ(lexer.NextToken()._TokenType.GetEnum(), TokenKind::FILE_END);
+}
+
 // ==========================================
 // 2. Parser 单元测试
 // ==========================================
@@ -265,4 +291,158 @@ TEST(ParserTest, ParseImportStatement) {
 
     // 验证别名
     EXPECT_EQ(importStmt->AliasName, "io");
-}
\ No newline at end of file
+}
+// 测试节点类型标记: 不依赖 RTTI 即可识别节点
+TEST(ParserTest, NodeKindTag) {
+    std::string code = "let x = foo(1, \"a\"); x.y = !x;";
+    Parser parser(code);
+    Program program = parser.ParseProgram();
+
+    ASSERT_EQ(program.Body.size(), 2);
+    ASSERT_EQ(program.Body[0]->Kind, NodeKind::VARIABLE_STATEMENT);
+    auto* varStmt = static_cast<VariableStatement*>(program.Body[0].get());
+    ASSERT_EQ(varStmt->List[0]->Kind, NodeKind::VARIABLE);
+    auto* varExpr = static_cast<VariableExpression*>(varStmt->List[0].get());
+    ASSERT_EQ(varExpr->Initializer->Kind, NodeKind::CALL);
+    auto* call = static_cast<CallExpression*>(varExpr->Initializer.get());
+    EXPECT_EQ(call->Callee->Kind, NodeKind::IDENTIFIER);
+    EXPECT_EQ(call->ArgumentList[0]->Kind, NodeKind::NUMBER_LITERAL);
+    EXPECT_EQ(call->ArgumentList[1]->Kind, NodeKind::STRING_LITERAL);
+
+    ASSERT_EQ(program.Body[1]->Kind, NodeKind::EXPRESSION_STATEMENT);
+    auto* assign = static_cast<ExpressionStatement*>(program.Body[1].get())->Expression.get();
+    ASSERT_EQ(assign->Kind, NodeKind::ASSIGN);
+    EXPECT_EQ(static_cast<AssignExpression*>(assign)->Left->Kind, NodeKind::DOT);
+    EXPECT_EQ(static_cast<AssignExpression*>(assign)->Right->Kind, NodeKind::UNARY);
+}
+
+// 测试作用域解析: 局部变量解析为 (depth, slot), 顶层变量仍按名字查找
+TEST(ParserTest, ResolveLocalSlots) {
+    std::string code = "let g = 1; function f(a) { let b = a; { let c = b + g; } }";
+    Parser parser(code);
+    Program program = parser.ParseProgram();
+
+    auto* topVar = static_cast<VariableExpression*>(static_cast<VariableStatement*>(program.Body[0].get())->List[0].get());
+    EXPECT_EQ(topVar->Slot, -1);
+
+    auto* func = static_cast<FunctionStatement*>(program.Body[1].get())->Function.get();
+    ASSERT_EQ(func->Scope.size(), 1);
+    EXPECT_EQ(func->Scope[0], "a");
+
+    auto* body = static_cast<BlockStatement*>(func->Body.get());
+    auto* declB = static_cast<VariableExpression*>(static_cast<VariableStatement*>(body->StatementList[0].get())->List[0].get());
+    EXPECT_EQ(declB->Slot, 0);
+    auto* refA = static_cast<Identifier*>(declB->Initializer.get());
+    EXPECT_EQ(refA->Depth, 1);
+    EXPECT_EQ(refA->Slot, 0);
+
+    auto* inner = static_cast<BlockStatement*>(body->StatementList[1].get());
+    auto* declC = static_cast<VariableExpression*>(static_cast<VariableStatement*>(inner->StatementList[0].get())->List[0].get());
+    auto* sum = static_cast<BinaryExpression*>(declC->Initializer.get());
+    auto* refB = static_cast<Identifier*>(sum->Left.get());
+    EXPECT_EQ(refB->Depth, 1);
+    EXPECT_EQ(refB->Slot, 0);
+    auto* refG = static_cast<Identifier*>(sum->Right.get());
+    EXPECT_EQ(refG->Slot, -1);
+}
+
+TEST(ParserTest, LiteralConstants) {
+    std::string code = "let a = 1.5 + 7; let s = \"hi\";";
+    Parser parser(code);
+    Program program = parser.ParseProgram();
+
+    auto* declA = static_cast<VariableExpression*>(static_cast<VariableStatement*>(program.Body[0].get())->List[0].get());
+    auto* sum = static_cast<BinaryExpression*>(declA->Initializer.get());
+    auto* left = static_cast<NumberLiteral*>(sum->Left.get());
+    EXPECT_DOUBLE_EQ(left->Value, 1.5);
+    ASSERT_NE(left->Constant, nullptr);
+    EXPECT_EQ(left->Constant->ToString(), "1.5");
+    auto* right = static_cast<NumberLiteral*>(sum->Right.get());
+    EXPECT_EQ(right->Constant, NumberValue::Of(7));
+
+    auto* declS = static_cast<VariableExpression*>(static_cast<VariableStatement*>(program.Body[1].get())->List[0].get());
+    auto* str = static_cast<StringLiteral*>(declS->Initializer.get());
+    ASSERT_NE(str->Constant, nullptr);
+    EXPECT_EQ(str->Constant->ToString(), "hi");
+}
+
+TEST(ParserTest, ElideEmptyScopes) {
+    std::string code = "function f(a) { { { a = 1; } } for (let i = 0; i < 1; i++) { let b = a; g(function() { return b; }); } }";
+    Parser parser(code);
+    Program program = parser.ParseProgram();
+
+    auto* func = static_cast<FunctionStatement*>(program.Body[0].get())->Function.get();
+    auto* body = static_cast<BlockStatement*>(func->Body.get());
+    EXPECT_TRUE(body->Scope.empty());
+    // 中间没有声明的代码块不计入深度
+    auto* outerBlock = static_cast<BlockStatement*>(body->StatementList[0].get());
+    auto* innerBlock = static_cast<BlockStatement*>(outerBlock->StatementList[0].get());
+    auto* assign = static_cast<AssignExpression*>(static_cast<ExpressionStatement*>(innerBlock->StatementList[0].get())->Expression.get());
+    auto* refA = static_cast<Identifier*>(assign->Left.get());
+    EXPECT_EQ(refA->Depth, 0);
+    EXPECT_EQ(refA->Slot, 0);
+
+    auto* loop = static_cast<ForStatement*>(body->StatementList[1].get());
+    EXPECT_EQ(loop->LoopScope.size(), 1);
+    EXPECT_TRUE(loop->IterationScope.empty());
+    auto* loopBody = static_cast<BlockStatement*>(loop->Body.get());
+    EXPECT_TRUE(loopBody->Captured);
+    EXPECT_FALSE(outerBlock->Captured);
+    auto* declB = static_cast<VariableExpression*>(static_cast<VariableStatement*>(loopBody->StatementList[0].get())->List[0].get());
+    auto* refA2 = static_cast<Identifier*>(declB->Initializer.get());
+    // loopBody -> loopScope -> 函数作用域
+    EXPECT_EQ(refA2->Depth, 2);
+}
+
+TEST(ParserTest, OperatorKindTag) {
+    std::string code = "a += b * -c; x = !y || z++;";
+    Parser parser(code);
+    Program program = parser.ParseProgram();
+
+    auto* first = static_cast<AssignExpression*>(static_cast<ExpressionStatement*>(program.Body[0].get())->Expression.get());
+    EXPECT_EQ(first->Op, OperatorKind::ADD);
+    auto* mul = static_cast<BinaryExpression*>(first->Right.get());
+    EXPECT_EQ(mul->Op, OperatorKind::MUL);
+    EXPECT_EQ(static_cast<UnaryExpression*>(mul->Right.get())->Op, OperatorKind::SUB);
+
+    auto* second = static_cast<AssignExpression*>(static_cast<ExpressionStatement*>(program.Body[1].get())->Expression.get());
+    EXPECT_EQ(second->Op, OperatorKind::NONE);
+    auto* orExpr = static_cast<BinaryExpression*>(second->Right.get());
+    EXPECT_EQ(orExpr->Op, OperatorKind::OR);
+    EXPECT_EQ(static_cast<UnaryExpression*>(orExpr->Left.get())->Op, OperatorKind::NOT);
+    EXPECT_EQ(static_cast<UnaryExpression*>(orExpr->Right.get())->Op, OperatorKind::INC);
+}
+
+TEST(ParserTest, InternedNames) {
+    std::string code = "obj.count = count; let o = {count: 1};";
+    Parser parser(code);
+    Program program = parser.ParseProgram();
+
+    auto* assign = static_cast<AssignExpression*>(static_cast<ExpressionStatement*>(program.Body[0].get())->Expression.get());
+    auto* dot = static_cast<DotExpression*>(assign->Left.get());
+    auto* ref = static_cast<Identifier*>(assign->Right.get());
+    auto* decl = static_cast<VariableExpression*>(static_cast<VariableStatement*>(program.Body[1].get())->List[0].get());
+    auto* prop = static_cast<ObjectLiteral*>(decl->Initializer.get())->Value[0].get();
+    // 同名的标识符与属性名共享同一份字符串
+    EXPECT_EQ(&dot->Identifier->Name.Str(), &ref->Name.Str());
+    EXPECT_EQ(&prop->Key.Str(), &ref->Name.Str());
+    EXPECT_EQ(Atom::Intern(std::string("cou") + "nt"), ref->Name);
+    Atom missing;
+    EXPECT_FALSE(Atom::Find("never interned name", missing));
+}
+
+TEST(ParserTest, BorrowedSource) {
+    // 模拟映射的文件: 解析时不复制, 语法树存活期间源码一直有效
+    auto source = std::make_shared<const std::string>("let a = 1; let b = \"x\" + a;");
+    const std::weak_ptr<const std::string> watch = source;
+    Program program;
+    {
+        Parser parser(*source, source);
+        program = parser.ParseProgram();
+    }
+    source.reset();
+    EXPECT_EQ(program.Body.size(), 2);
+    EXPECT_FALSE(watch.expired());
+    program = Program();
+    EXPECT_TRUE(watch.expired());
+}